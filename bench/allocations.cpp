@@ -0,0 +1,89 @@
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+#include "allocations.hpp"
+
+namespace cx::bench
+{
+  static std::atomic<uint64_t> numAllocations{0};
+  static std::atomic<uint64_t> numBytes{0};
+
+  static void* countedAllocate(size_t size, size_t alignment)
+  {
+    numAllocations.fetch_add(1, std::memory_order_relaxed);
+    numBytes.fetch_add(size, std::memory_order_relaxed);
+
+    if (size == 0) {
+      size = 1;
+    }
+
+    void* ptr = nullptr;
+    if (alignment <= alignof(std::max_align_t)) {
+      ptr = std::malloc(size);
+    } else {
+      // aligned_alloc() requires the size to be a multiple of the alignment.
+      ptr = std::aligned_alloc(alignment,
+                               ((size + alignment - 1) / alignment)
+                               * alignment);
+    }
+
+    if (ptr == nullptr) {
+      throw std::bad_alloc();
+    }
+
+    return ptr;
+  }
+
+  AllocationCounts getAllocationCounts()
+  {
+    return AllocationCounts{
+      numAllocations.load(std::memory_order_relaxed),
+      numBytes.load(std::memory_order_relaxed)
+    };
+  }
+}
+
+void* operator new(size_t size)
+{
+  return cx::bench::countedAllocate(size, alignof(std::max_align_t));
+}
+
+void* operator new[](size_t size)
+{
+  return cx::bench::countedAllocate(size, alignof(std::max_align_t));
+}
+
+void operator delete(void* ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete[](void* ptr, size_t) noexcept
+{
+  std::free(ptr);
+}
+
+// EASTL's default allocator requires the application to provide these two.
+void* operator new[](size_t size, const char*, int, unsigned, const char*, int)
+{
+  return cx::bench::countedAllocate(size, alignof(std::max_align_t));
+}
+
+void* operator new[](size_t size, size_t alignment, size_t,
+                     const char*, int, unsigned, const char*, int)
+{
+  return cx::bench::countedAllocate(size, alignment);
+}
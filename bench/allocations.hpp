@@ -0,0 +1,19 @@
+#ifndef COREX_MATH_BENCH_ALLOCATIONS_HPP
+#define COREX_MATH_BENCH_ALLOCATIONS_HPP
+
+#include <cstdint>
+
+namespace cx::bench
+{
+  struct AllocationCounts
+  {
+    uint64_t numAllocations;
+    uint64_t numBytes;
+  };
+
+  // Counts every allocation that goes through the global operator new and the
+  // operator new[] overloads that EASTL uses, since the start of the program.
+  AllocationCounts getAllocationCounts();
+}
+
+#endif
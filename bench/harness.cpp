@@ -0,0 +1,99 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+#include <EASTL/vector.h>
+
+#include "allocations.hpp"
+#include "harness.hpp"
+#include "workload.hpp"
+
+namespace cx::bench
+{
+  BenchmarkResult runBenchmark(const Benchmark& benchmark,
+                               Workload& workload,
+                               double minSeconds)
+  {
+    using Clock = std::chrono::steady_clock;
+
+    benchmark.runPass(workload);
+
+    AllocationCounts startCounts = getAllocationCounts();
+    Clock::time_point startTime = Clock::now();
+    Clock::time_point endTime = startTime;
+    uint64_t numPasses = 0;
+    do {
+      benchmark.runPass(workload);
+      numPasses++;
+      endTime = Clock::now();
+    } while (std::chrono::duration<double>(endTime - startTime).count()
+             < minSeconds);
+    AllocationCounts endCounts = getAllocationCounts();
+
+    uint64_t numOps = numPasses * static_cast<uint64_t>(workload.scale);
+    double elapsedNs = std::chrono::duration<double, std::nano>(
+      endTime - startTime).count();
+
+    BenchmarkResult result;
+    result.name = benchmark.name;
+    result.scale = workload.scale;
+    result.numOps = numOps;
+    result.nsPerOp = elapsedNs / numOps;
+    result.opsPerSecond = numOps / (elapsedNs / 1e9);
+    result.allocationsPerOp = static_cast<double>(
+      endCounts.numAllocations - startCounts.numAllocations) / numOps;
+    result.bytesAllocatedPerOp = static_cast<double>(
+      endCounts.numBytes - startCounts.numBytes) / numOps;
+
+    return result;
+  }
+
+  void printResultHeader(FILE* stream)
+  {
+    std::fprintf(stream, "%-48s %9s %12s %14s %10s %12s\n",
+                 "benchmark", "scale", "ns/op", "ops/s", "allocs/op",
+                 "bytes/op");
+  }
+
+  void printResult(FILE* stream, const BenchmarkResult& result)
+  {
+    std::fprintf(stream, "%-48s %9d %12.2f %14.0f %10.4f %12.1f\n",
+                 result.name.c_str(), result.scale, result.nsPerOp,
+                 result.opsPerSecond, result.allocationsPerOp,
+                 result.bytesAllocatedPerOp);
+    std::fflush(stream);
+  }
+
+  void writeResultsAsJSON(FILE* stream,
+                          const eastl::vector<BenchmarkResult>& results,
+                          uint32_t seed)
+  {
+    // The build options that change what gets measured are recorded, so that
+    // runs with them on and off can be told apart when diffing them.
+#if defined(COREX_MATH_BOUNDING_CIRCLE_EARLY_OUT)
+    const char* boundingCircleEarlyOut = "true";
+#else
+    const char* boundingCircleEarlyOut = "false";
+#endif
+
+    // Benchmark names never need escaping, so we can write them as is.
+    std::fprintf(stream,
+                 "{\n  \"seed\": %u,\n  \"boundingCircleEarlyOut\": %s,\n"
+                 "  \"results\": [",
+                 seed, boundingCircleEarlyOut);
+    for (size_t i = 0; i < results.size(); i++) {
+      const BenchmarkResult& result = results[i];
+      std::fprintf(stream,
+                   "%s\n    {\"name\": \"%s\", \"scale\": %d, "
+                   "\"numOps\": %llu, \"nsPerOp\": %.4f, "
+                   "\"opsPerSecond\": %.1f, \"allocationsPerOp\": %.6f, "
+                   "\"bytesAllocatedPerOp\": %.3f}",
+                   (i == 0) ? "" : ",",
+                   result.name.c_str(), result.scale,
+                   static_cast<unsigned long long>(result.numOps),
+                   result.nsPerOp, result.opsPerSecond,
+                   result.allocationsPerOp, result.bytesAllocatedPerOp);
+    }
+    std::fprintf(stream, "\n  ]\n}\n");
+  }
+}
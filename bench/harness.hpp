@@ -0,0 +1,55 @@
+#ifndef COREX_MATH_BENCH_HARNESS_HPP
+#define COREX_MATH_BENCH_HARNESS_HPP
+
+#include <cstdint>
+#include <cstdio>
+
+#include <EASTL/functional.h>
+#include <EASTL/string.h>
+#include <EASTL/vector.h>
+
+#include "workload.hpp"
+
+namespace cx::bench
+{
+  // A benchmark runs a pass over a workload, performing one operation per
+  // shape or pair of shapes. Benchmarks of slow functions may cap the scale
+  // they are run at.
+  struct Benchmark
+  {
+    eastl::string name;
+    eastl::function<void(Workload&)> runPass;
+    int32_t maxScale = 1000000;
+  };
+
+  struct BenchmarkResult
+  {
+    eastl::string name;
+    int32_t scale;
+    uint64_t numOps;
+    double nsPerOp;
+    double opsPerSecond;
+    double allocationsPerOp;
+    double bytesAllocatedPerOp;
+  };
+
+  // Keeps the compiler from optimizing away a value that is never used.
+  template <typename T>
+  inline void doNotOptimize(const T& value)
+  {
+    asm volatile("" : : "r,m"(value) : "memory");
+  }
+
+  // Runs passes of the benchmark until at least minSeconds has passed. A
+  // warm-up pass, which is not measured, is run first.
+  BenchmarkResult runBenchmark(const Benchmark& benchmark,
+                               Workload& workload,
+                               double minSeconds);
+  void printResultHeader(FILE* stream);
+  void printResult(FILE* stream, const BenchmarkResult& result);
+  void writeResultsAsJSON(FILE* stream,
+                          const eastl::vector<BenchmarkResult>& results,
+                          uint32_t seed);
+}
+
+#endif
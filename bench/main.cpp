@@ -0,0 +1,784 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <EASTL/vector.h>
+
+#include <corex/math.hpp>
+
+#include "harness.hpp"
+#include "workload.hpp"
+
+using namespace cx;
+using namespace cx::bench;
+
+static ThreadPool& getThreadPool()
+{
+  // Created on first use, so that the worker threads are only around when
+  // the parallel benchmarks are being run.
+  static ThreadPool threadPool;
+  return threadPool;
+}
+
+static eastl::vector<Benchmark> makeBenchmarks()
+{
+  eastl::vector<Benchmark> benchmarks;
+
+  // Vec2 operators.
+  benchmarks.push_back({"Vec2/operator+", [](Workload& w) {
+    for (int32_t i = 0; i < w.scale; i++) {
+      doNotOptimize(w.vectors0[i] + w.vectors1[i]);
+    }
+  }});
+  benchmarks.push_back({"Vec2/operator-", [](Workload& w) {
+    for (int32_t i = 0; i < w.scale; i++) {
+      doNotOptimize(w.vectors0[i] - w.vectors1[i]);
+    }
+  }});
+  benchmarks.push_back({"Vec2/operator*(float)", [](Workload& w) {
+    for (int32_t i = 0; i < w.scale; i++) {
+      doNotOptimize(w.vectors0[i] * w.vectors1[i].x);
+    }
+  }});
+  benchmarks.push_back({"Vec2/operator/(float)", [](Workload& w) {
+    for (int32_t i = 0; i < w.scale; i++) {
+      doNotOptimize(w.vectors0[i] / w.vectors1[i].x);
+    }
+  }});
+
+  // Linear algebra.
+  benchmarks.push_back({"linear_algebra/vec2Magnitude", [](Workload& w) {
+    for (int32_t i = 0; i < w.scale; i++) {
+      doNotOptimize(vec2Magnitude(w.vectors0[i]));
+    }
+  }});
+  benchmarks.push_back({"linear_algebra/vec2Angle", [](Workload& w) {
+    for (int32_t i = 0; i < w.scale; i++) {
+      doNotOptimize(vec2Angle(w.vectors0[i]));
+    }
+  }});
+  benchmarks.push_back({"linear_algebra/dotProduct", [](Workload& w) {
+    for (int32_t i = 0; i < w.scale; i++) {
+      doNotOptimize(dotProduct(w.vectors0[i], w.vectors1[i]));
+    }
+  }});
+  benchmarks.push_back({"linear_algebra/crossProduct", [](Workload& w) {
+    for (int32_t i = 0; i < w.scale; i++) {
+      doNotOptimize(crossProduct(w.vectors0[i], w.vectors1[i]));
+    }
+  }});
+  benchmarks.push_back({"linear_algebra/rotateVec2(angle)", [](Workload& w) {
+    for (int32_t i = 0; i < w.scale; i++) {
+      doNotOptimize(rotateVec2(w.vectors0[i], w.rects0[i].angle));
+    }
+  }});
+  benchmarks.push_back({"linear_algebra/rotateVec2(Rotation)",
+                        [](Workload& w) {
+    for (int32_t i = 0; i < w.scale; i++) {
+      doNotOptimize(rotateVec2(w.vectors0[i], w.rotations0[i]));
+    }
+  }});
+  benchmarks.push_back({"linear_algebra/rotationFromAngle", [](Workload& w) {
+    for (int32_t i = 0; i < w.scale; i++) {
+      doNotOptimize(rotationFromAngle(w.rects0[i].angle));
+    }
+  }});
+  benchmarks.push_back({"linear_algebra/projectVec2", [](Workload& w) {
+    for (int32_t i = 0; i < w.scale; i++) {
+      doNotOptimize(projectVec2(w.vectors0[i], w.vectors1[i]));
+    }
+  }});
+  benchmarks.push_back({"linear_algebra/vec2Perp", [](Workload& w) {
+    for (int32_t i = 0; i < w.scale; i++) {
+      doNotOptimize(vec2Perp(w.vectors0[i]));
+    }
+  }});
+  benchmarks.push_back({"linear_algebra/unitVector", [](Workload& w) {
+    for (int32_t i = 0; i < w.scale; i++) {
+      doNotOptimize(unitVector(w.vectors0[i]));
+    }
+  }});
+  benchmarks.push_back({"linear_algebra/lineDirectionVector",
+                        [](Workload& w) {
+    for (int32_t i = 0; i < w.scale; i++) {
+      doNotOptimize(lineDirectionVector(w.lines0[i]));
+    }
+  }});
+  benchmarks.push_back({"linear_algebra/lineNormalVector", [](Workload& w) {
+    for (int32_t i = 0; i < w.scale; i++) {
+      doNotOptimize(lineNormalVector(w.lines0[i]));
+    }
+  }});
+  benchmarks.push_back({"linear_algebra/projectRectToAnAxis",
+                        [](Workload& w) {
+    for (int32_t i = 0; i < w.scale; i++) {
+      doNotOptimize(projectRectToAnAxis(w.rects0[i], w.vectors0[i]));
+    }
+  }});
+  benchmarks.push_back({"linear_algebra/det3x3", [](Workload& w) {
+    for (int32_t i = 0; i < w.scale; i++) {
+      doNotOptimize(det3x3(w.vectors0[i], w.vectors1[i], w.points[i]));
+    }
+  }});
+  benchmarks.push_back({"linear_algebra/translateVec2", [](Workload& w) {
+    for (int32_t i = 0; i < w.scale; i++) {
+      doNotOptimize(translateVec2(w.vectors0[i], w.vectors1[i].x,
+                                  w.vectors1[i].y));
+    }
+  }});
+  benchmarks.push_back({"linear_algebra/lineToVec", [](Workload& w) {
+    for (int32_t i = 0; i < w.scale; i++) {
+      doNotOptimize(lineToVec(w.lines0[i]));
+    }
+  }});
+  benchmarks.push_back({"linear_algebra/minVec2Magnitude", [](Workload& w) {
+    eastl::vector<Vec2*> vectors(4);
+    for (int32_t i = 0; i < w.scale; i++) {
+      vectors[0] = &w.vectors0[i];
+      vectors[1] = &w.vectors1[i];
+      vectors[2] = &w.lines0[i].start;
+      vectors[3] = &w.lines0[i].end;
+      doNotOptimize(minVec2Magnitude(vectors));
+    }
+  }});
+  benchmarks.push_back({"linear_algebra/maxVec2Magnitude", [](Workload& w) {
+    eastl::vector<Vec2*> vectors(4);
+    for (int32_t i = 0; i < w.scale; i++) {
+      vectors[0] = &w.vectors0[i];
+      vectors[1] = &w.vectors1[i];
+      vectors[2] = &w.lines0[i].start;
+      vectors[3] = &w.lines0[i].end;
+      doNotOptimize(maxVec2Magnitude(vectors));
+    }
+  }});
+
+  // Utilities.
+  benchmarks.push_back({"utils/convertRectangleToPolygon", [](Workload& w) {
+    for (int32_t i = 0; i < w.scale; i++) {
+      doNotOptimize(convertRectangleToPolygon(w.rects0[i]));
+    }
+  }});
+  benchmarks.push_back({"utils/longestLine", [](Workload& w) {
+    eastl::vector<Line*> lines(2);
+    for (int32_t i = 0; i < w.scale; i++) {
+      lines[0] = &w.lines0[i];
+      lines[1] = &w.lines1[i];
+      doNotOptimize(longestLine(lines));
+    }
+  }});
+
+  // Fast, unrounded, variants.
+  benchmarks.push_back({"fast/add", [](Workload& w) {
+    for (int32_t i = 0; i < w.scale; i++) {
+      doNotOptimize(fast::add(w.vectors0[i], w.vectors1[i]));
+    }
+  }});
+  benchmarks.push_back({"fast/rotateVec2", [](Workload& w) {
+    for (int32_t i = 0; i < w.scale; i++) {
+      doNotOptimize(fast::rotateVec2(w.vectors0[i], w.rects0[i].angle));
+    }
+  }});
+  benchmarks.push_back({"fast/unitVector", [](Workload& w) {
+    for (int32_t i = 0; i < w.scale; i++) {
+      doNotOptimize(fast::unitVector(w.vectors0[i]));
+    }
+  }});
+  benchmarks.push_back({"fast/rotateRectangle", [](Workload& w) {
+    for (int32_t i = 0; i < w.scale; i++) {
+      doNotOptimize(fast::rotateRectangle(w.rects0[i]));
+    }
+  }});
+
+  // Robust, exact predicate, variants.
+  benchmarks.push_back({"robust/signedDistPointToInfLine", [](Workload& w) {
+    for (int32_t i = 0; i < w.scale; i++) {
+      doNotOptimize(robust::signedDistPointToInfLine(w.points[i],
+                                                     w.lines0[i]));
+    }
+  }});
+  benchmarks.push_back({"robust/intersectionOfLineAndLine",
+                        [](Workload& w) {
+    for (int32_t i = 0; i < w.scale; i++) {
+      doNotOptimize(robust::intersectionOfLineAndLine(w.lines0[i],
+                                                      w.lines1[i]));
+    }
+  }});
+  benchmarks.push_back({"robust/areTwoLinesIntersecting", [](Workload& w) {
+    for (int32_t i = 0; i < w.scale; i++) {
+      doNotOptimize(robust::areTwoLinesIntersecting(w.lines0[i],
+                                                    w.lines1[i]));
+    }
+  }});
+  benchmarks.push_back({"robust/clippedPolygonFromTwoRects(Fixed)",
+                        [](Workload& w) {
+    FixedNPolygon<8> clippedPolygon;
+    for (int32_t i = 0; i < w.scale; i++) {
+      robust::clippedPolygonFromTwoRects(w.rects0[i], w.rects1[i],
+                                         clippedPolygon);
+      doNotOptimize(clippedPolygon.vertices.size());
+    }
+  }});
+  benchmarks.push_back({"robust/isPointWithinNPolygon", [](Workload& w) {
+    for (int32_t i = 0; i < w.scale; i++) {
+      doNotOptimize(robust::isPointWithinNPolygon(w.points[i], w.region));
+    }
+  }});
+
+  // Geometry.
+  benchmarks.push_back({"geometry/degreesToRadians", [](Workload& w) {
+    for (int32_t i = 0; i < w.scale; i++) {
+      doNotOptimize(degreesToRadians(w.rects0[i].angle));
+    }
+  }});
+  benchmarks.push_back({"geometry/radiansToDegrees", [](Workload& w) {
+    for (int32_t i = 0; i < w.scale; i++) {
+      doNotOptimize(radiansToDegrees(w.rects0[i].angle));
+    }
+  }});
+  benchmarks.push_back({"geometry/lineLength", [](Workload& w) {
+    for (int32_t i = 0; i < w.scale; i++) {
+      doNotOptimize(lineLength(w.lines0[i]));
+    }
+  }});
+  benchmarks.push_back({"geometry/distance2D", [](Workload& w) {
+    for (int32_t i = 0; i < w.scale; i++) {
+      doNotOptimize(distance2D(w.lines0[i].start, w.lines0[i].end));
+    }
+  }});
+  benchmarks.push_back({"geometry/signedDistPointToInfLine",
+                        [](Workload& w) {
+    for (int32_t i = 0; i < w.scale; i++) {
+      doNotOptimize(signedDistPointToInfLine(w.points[i], w.lines0[i]));
+    }
+  }});
+  benchmarks.push_back({"geometry/rotateRectangle", [](Workload& w) {
+    for (int32_t i = 0; i < w.scale; i++) {
+      doNotOptimize(rotateRectangle(w.rects0[i]));
+    }
+  }});
+  benchmarks.push_back({"geometry/areTwoRectsIntersectingInAnAxis",
+                        [](Workload& w) {
+    for (int32_t i = 0; i < w.scale; i++) {
+      doNotOptimize(areTwoRectsIntersectingInAnAxis(w.rects0[i], w.rects1[i],
+                                                    w.vectors0[i]));
+    }
+  }});
+  benchmarks.push_back({"geometry/areTwoRectsIntersectingInAnAxis(Rotation)",
+                        [](Workload& w) {
+    for (int32_t i = 0; i < w.scale; i++) {
+      doNotOptimize(areTwoRectsIntersectingInAnAxis(w.rects0[i],
+                                                    w.rotations0[i],
+                                                    w.rects1[i],
+                                                    w.rotations1[i],
+                                                    w.vectors0[i]));
+    }
+  }});
+  benchmarks.push_back({"geometry/areTwoRectsIntersecting", [](Workload& w) {
+    for (int32_t i = 0; i < w.scale; i++) {
+      doNotOptimize(areTwoRectsIntersecting(w.rects0[i], w.rects1[i]));
+    }
+  }});
+  benchmarks.push_back({"geometry/areTwoRectsIntersecting(far)",
+                        [](Workload& w) {
+    // Pairs that are mostly far apart, where the bounding-circle early-out
+    // kicks in.
+    for (int32_t i = 0; i < w.scale; i++) {
+      doNotOptimize(areTwoRectsIntersecting(
+        w.rects0[i], w.rects1[(i + (w.scale / 2)) % w.scale]));
+    }
+  }});
+  benchmarks.push_back({"geometry/areTwoRectsIntersecting(Rotation)",
+                        [](Workload& w) {
+    for (int32_t i = 0; i < w.scale; i++) {
+      doNotOptimize(areTwoRectsIntersecting(w.rects0[i], w.rotations0[i],
+                                            w.rects1[i], w.rotations1[i]));
+    }
+  }});
+  benchmarks.push_back({"geometry/areTwoRectsIntersecting(Prepared)",
+                        [](Workload& w) {
+    for (int32_t i = 0; i < w.scale; i++) {
+      doNotOptimize(areTwoRectsIntersecting(w.preparedRects0[i],
+                                            w.preparedRects1[i]));
+    }
+  }});
+  // The cache lives across passes, with each pass being a frame, like it
+  // would in a game that tests the same pairs every frame.
+  benchmarks.push_back({"geometry/areTwoRectsIntersecting(cached)",
+                        [](Workload& w) {
+    static SeparatingAxisCache cache;
+    beginSeparatingAxisCacheFrame(cache);
+    for (int32_t i = 0; i < w.scale; i++) {
+      doNotOptimize(areTwoRectsIntersecting(w.rects0[i], w.rects1[i],
+                                            cache, getPairID(i, i)));
+    }
+  }});
+  benchmarks.push_back({"geometry/areTwoRectsIntersecting(far,cached)",
+                        [](Workload& w) {
+    static SeparatingAxisCache cache;
+    beginSeparatingAxisCacheFrame(cache);
+    for (int32_t i = 0; i < w.scale; i++) {
+      int32_t j = (i + (w.scale / 2)) % w.scale;
+      doNotOptimize(areTwoRectsIntersecting(w.rects0[i], w.rects1[j],
+                                            cache, getPairID(i, j)));
+    }
+  }});
+  benchmarks.push_back({"geometry/areTwoRectsIntersecting(Prepared,cached)",
+                        [](Workload& w) {
+    static SeparatingAxisCache cache;
+    beginSeparatingAxisCacheFrame(cache);
+    for (int32_t i = 0; i < w.scale; i++) {
+      doNotOptimize(areTwoRectsIntersecting(w.preparedRects0[i],
+                                            w.preparedRects1[i],
+                                            cache, getPairID(i, i)));
+    }
+  }});
+  benchmarks.push_back({"geometry/intersectionOfTwoInfLines",
+                        [](Workload& w) {
+    for (int32_t i = 0; i < w.scale; i++) {
+      doNotOptimize(intersectionOfTwoInfLines(w.lines0[i], w.lines1[i]));
+    }
+  }});
+  benchmarks.push_back({"geometry/intersectionOfLineandInfLine",
+                        [](Workload& w) {
+    for (int32_t i = 0; i < w.scale; i++) {
+      doNotOptimize(intersectionOfLineandInfLine(w.lines0[i], w.lines1[i]));
+    }
+  }});
+  benchmarks.push_back({"geometry/intersectionOfLineAndLine",
+                        [](Workload& w) {
+    for (int32_t i = 0; i < w.scale; i++) {
+      doNotOptimize(intersectionOfLineAndLine(w.lines0[i], w.lines1[i]));
+    }
+  }});
+  benchmarks.push_back({"geometry/areTwoLinesIntersecting", [](Workload& w) {
+    for (int32_t i = 0; i < w.scale; i++) {
+      doNotOptimize(areTwoLinesIntersecting(w.lines0[i], w.lines1[i]));
+    }
+  }});
+  benchmarks.push_back({"geometry/clippedPolygonFromTwoRects",
+                        [](Workload& w) {
+    for (int32_t i = 0; i < w.scale; i++) {
+      NPolygon clippedPolygon = clippedPolygonFromTwoRects(w.rects0[i],
+                                                           w.rects1[i]);
+      doNotOptimize(clippedPolygon.vertices.size());
+    }
+  }});
+  benchmarks.push_back({"geometry/clippedPolygonFromTwoRects(Fixed)",
+                        [](Workload& w) {
+    FixedNPolygon<8> clippedPolygon;
+    for (int32_t i = 0; i < w.scale; i++) {
+      clippedPolygonFromTwoRects(w.rects0[i], w.rects1[i], clippedPolygon);
+      doNotOptimize(clippedPolygon.vertices.size());
+    }
+  }});
+  benchmarks.push_back({"geometry/getPolygonCentroid", [](Workload& w) {
+    for (int32_t i = 0; i < w.scale; i++) {
+      doNotOptimize(getPolygonCentroid(w.polygons0[i]));
+    }
+  }});
+  benchmarks.push_back({"geometry/getPolygonArea", [](Workload& w) {
+    for (int32_t i = 0; i < w.scale; i++) {
+      doNotOptimize(getPolygonArea(w.polygons0[i]));
+    }
+  }});
+  benchmarks.push_back({"geometry/getPolygonProperties", [](Workload& w) {
+    for (int32_t i = 0; i < w.scale; i++) {
+      doNotOptimize(getPolygonProperties(w.polygons0[i]));
+    }
+  }});
+  benchmarks.push_back({"geometry/isPointWithinNPolygon", [](Workload& w) {
+    for (int32_t i = 0; i < w.scale; i++) {
+      doNotOptimize(isPointWithinNPolygon(w.points[i], w.region));
+    }
+  }});
+  benchmarks.push_back({"geometry/isPointWithinNPolygon(Prepared)",
+                        [](Workload& w) {
+    for (int32_t i = 0; i < w.scale; i++) {
+      doNotOptimize(isPointWithinNPolygon(w.points[i], w.preparedRegion));
+    }
+  }});
+  // Unprepared rectangle and polygon tests go through every edge of the
+  // region, so running them at the largest scale takes too long.
+  benchmarks.push_back({"geometry/isRectWithinNPolygon", [](Workload& w) {
+    for (int32_t i = 0; i < w.scale; i++) {
+      doNotOptimize(isRectWithinNPolygon(w.rects0[i], w.region));
+    }
+  }, 100000});
+  benchmarks.push_back({"geometry/isRectWithinNPolygon(Prepared)",
+                        [](Workload& w) {
+    for (int32_t i = 0; i < w.scale; i++) {
+      doNotOptimize(isRectWithinNPolygon(w.preparedRects0[i],
+                                         w.preparedRegion));
+    }
+  }});
+  benchmarks.push_back({"geometry/isRectIntersectingNPolygon",
+                        [](Workload& w) {
+    for (int32_t i = 0; i < w.scale; i++) {
+      doNotOptimize(isRectIntersectingNPolygon(w.rects0[i], w.region));
+    }
+  }, 100000});
+  benchmarks.push_back({"geometry/isRectIntersectingNPolygon(Prepared)",
+                        [](Workload& w) {
+    for (int32_t i = 0; i < w.scale; i++) {
+      doNotOptimize(isRectIntersectingNPolygon(w.preparedRects0[i],
+                                               w.preparedRegion));
+    }
+  }});
+  benchmarks.push_back({"geometry/getRectangleAABB", [](Workload& w) {
+    for (int32_t i = 0; i < w.scale; i++) {
+      doNotOptimize(getRectangleAABB(w.rects0[i]));
+    }
+  }});
+  benchmarks.push_back({"geometry/getPolygonAABB", [](Workload& w) {
+    for (int32_t i = 0; i < w.scale; i++) {
+      doNotOptimize(getPolygonAABB(w.polygons0[i]));
+    }
+  }});
+  benchmarks.push_back({"geometry/areTwoAABBsIntersecting", [](Workload& w) {
+    for (int32_t i = 0; i < w.scale; i++) {
+      doNotOptimize(areTwoAABBsIntersecting(w.boxes0[i], w.boxes1[i]));
+    }
+  }});
+  benchmarks.push_back({"geometry/areTwoCirclesIntersecting",
+                        [](Workload& w) {
+    for (int32_t i = 0; i < w.scale; i++) {
+      doNotOptimize(areTwoCirclesIntersecting(w.circles0[i], w.circles1[i]));
+    }
+  }});
+  benchmarks.push_back({"geometry/isCircleIntersectingRect", [](Workload& w) {
+    for (int32_t i = 0; i < w.scale; i++) {
+      doNotOptimize(isCircleIntersectingRect(w.circles0[i], w.rects1[i]));
+    }
+  }});
+  benchmarks.push_back({"geometry/isCircleIntersectingLine", [](Workload& w) {
+    for (int32_t i = 0; i < w.scale; i++) {
+      doNotOptimize(isCircleIntersectingLine(w.circles0[i], w.lines1[i]));
+    }
+  }});
+  benchmarks.push_back({"geometry/isCircleIntersectingNPolygon",
+                        [](Workload& w) {
+    for (int32_t i = 0; i < w.scale; i++) {
+      doNotOptimize(isCircleIntersectingNPolygon(w.circles0[i],
+                                                 w.polygons1[i]));
+    }
+  }});
+  benchmarks.push_back({"geometry/distCircleToCircle", [](Workload& w) {
+    for (int32_t i = 0; i < w.scale; i++) {
+      doNotOptimize(distCircleToCircle(w.circles0[i], w.circles1[i]));
+    }
+  }});
+  benchmarks.push_back({"geometry/distCircleToRect", [](Workload& w) {
+    for (int32_t i = 0; i < w.scale; i++) {
+      doNotOptimize(distCircleToRect(w.circles0[i], w.rects1[i]));
+    }
+  }});
+  benchmarks.push_back({"geometry/distCircleToLine", [](Workload& w) {
+    for (int32_t i = 0; i < w.scale; i++) {
+      doNotOptimize(distCircleToLine(w.circles0[i], w.lines1[i]));
+    }
+  }});
+  benchmarks.push_back({"geometry/getRectBoundingCircle", [](Workload& w) {
+    for (int32_t i = 0; i < w.scale; i++) {
+      doNotOptimize(getRectBoundingCircle(w.rects0[i]));
+    }
+  }});
+  benchmarks.push_back({"geometry/distCircleToNPolygon", [](Workload& w) {
+    for (int32_t i = 0; i < w.scale; i++) {
+      doNotOptimize(distCircleToNPolygon(w.circles0[i], w.polygons1[i]));
+    }
+  }});
+  benchmarks.push_back({"geometry/updatePreparedRectangle",
+                        [](Workload& w) {
+    for (int32_t i = 0; i < w.scale; i++) {
+      w.preparedRects0[i].rect.angle += 1.f;
+      updatePreparedRectangle(w.preparedRects0[i]);
+      w.preparedRects0[i].rect.angle -= 1.f;
+      updatePreparedRectangle(w.preparedRects0[i]);
+    }
+  }});
+
+  // Clipping.
+  benchmarks.push_back({"clipping/clippedPolygonFromTwoConvexPolygons",
+                        [](Workload& w) {
+    NPolygon clippedPolygon;
+    for (int32_t i = 0; i < w.scale; i++) {
+      clippedPolygonFromTwoConvexPolygons(w.polygons0[i], w.polygons1[i],
+                                          clippedPolygon);
+      doNotOptimize(clippedPolygon.vertices.size());
+    }
+  }});
+  benchmarks.push_back({"clipping/getConvexPolygonsOverlapArea",
+                        [](Workload& w) {
+    for (int32_t i = 0; i < w.scale; i++) {
+      doNotOptimize(getConvexPolygonsOverlapArea(w.polygons0[i],
+                                                 w.polygons1[i]));
+    }
+  }});
+  benchmarks.push_back({"clipping/getConvexPolygonPairsOverlapAreas",
+                        [](Workload& w) {
+    eastl::vector<double> areas;
+    getConvexPolygonPairsOverlapAreas(w.polygonPool, w.polygonPoolPairs,
+                                      areas);
+    doNotOptimize(areas.data());
+  }});
+
+  // Batch functions.
+  benchmarks.push_back({"batch/areRectPairsIntersecting", [](Workload& w) {
+    eastl::vector<uint64_t> hitMask;
+    areRectPairsIntersecting(w.rectBuffer, w.rectBufferPairs, hitMask);
+    doNotOptimize(hitMask.data());
+  }});
+  benchmarks.push_back({"batch/arePointsWithinNPolygon", [](Workload& w) {
+    eastl::vector<uint64_t> resultMask;
+    arePointsWithinNPolygon(w.pointBuffer, w.region, resultMask);
+    doNotOptimize(resultMask.data());
+  }});
+
+  benchmarks.push_back({"batch/areCirclePairsIntersecting", [](Workload& w) {
+    eastl::vector<uint64_t> hitMask;
+    areCirclePairsIntersecting(w.circleBuffer, w.rectBufferPairs, hitMask);
+    doNotOptimize(hitMask.data());
+  }});
+  benchmarks.push_back({"batch/areCirclesIntersectingRects", [](Workload& w) {
+    eastl::vector<uint64_t> hitMask;
+    areCirclesIntersectingRects(w.circleBuffer, w.rectBuffer,
+                                w.rectBufferPairs, hitMask);
+    doNotOptimize(hitMask.data());
+  }});
+  benchmarks.push_back({"batch/areCirclesIntersectingNPolygon",
+                        [](Workload& w) {
+    eastl::vector<uint64_t> resultMask;
+    areCirclesIntersectingNPolygon(w.circleBuffer, w.region, resultMask);
+    doNotOptimize(resultMask.data());
+  }});
+  benchmarks.push_back({"batch/getPolygonBufferProperties", [](Workload& w) {
+    eastl::vector<PolygonProperties> properties;
+    getPolygonBufferProperties(w.polygonBuffer, properties);
+    doNotOptimize(properties.data());
+  }});
+
+  // Parallel batch functions, on a pool that uses all hardware threads.
+  constexpr int32_t parallelChunkSize = 4096;
+  benchmarks.push_back({"parallel/areRectPairsIntersecting",
+                        [](Workload& w) {
+    eastl::vector<uint64_t> hitMask;
+    areRectPairsIntersecting(getThreadPool(), w.rectBuffer,
+                             w.rectBufferPairs, hitMask, parallelChunkSize);
+    doNotOptimize(hitMask.data());
+  }});
+  benchmarks.push_back({"parallel/clipRectPairs", [](Workload& w) {
+    eastl::vector<FixedNPolygon<8>> clippedPolygons;
+    clipRectPairs(getThreadPool(), w.rectPool, w.rectBufferPairs,
+                  clippedPolygons, parallelChunkSize);
+    doNotOptimize(clippedPolygons.data());
+  }});
+  benchmarks.push_back({"parallel/arePointsWithinNPolygon", [](Workload& w) {
+    eastl::vector<uint64_t> resultMask;
+    arePointsWithinNPolygon(getThreadPool(), w.pointBuffer, w.region,
+                            resultMask, parallelChunkSize);
+    doNotOptimize(resultMask.data());
+  }});
+  benchmarks.push_back({"parallel/getPolygonAreas", [](Workload& w) {
+    eastl::vector<double> areas;
+    getPolygonAreas(getThreadPool(), w.polygonPool, areas,
+                    parallelChunkSize);
+    doNotOptimize(areas.data());
+  }});
+
+  // Continuous collision detection, with vectors0 and vectors1 as the
+  // velocities of the rectangles.
+  benchmarks.push_back({"continuous/getRectsTimeOfImpact", [](Workload& w) {
+    for (int32_t i = 0; i < w.scale; i++) {
+      doNotOptimize(getRectsTimeOfImpact(w.rects0[i], w.vectors0[i],
+                                         w.rects1[i], w.vectors1[i],
+                                         1.f));
+    }
+  }});
+  benchmarks.push_back({"continuous/getRectsTimeOfImpact(angular)",
+                        [](Workload& w) {
+    for (int32_t i = 0; i < w.scale; i++) {
+      doNotOptimize(getRectsTimeOfImpact(
+        w.rects0[i], RectangleMotion{ w.vectors0[i], 90.f },
+        w.rects1[i], RectangleMotion{ w.vectors1[i], -90.f },
+        1.f));
+    }
+  }});
+
+  // Broadphase. Each pass builds the structure from scratch and finds all
+  // candidate pairs.
+  benchmarks.push_back({"broadphase/grid/insertAndFindPairs",
+                        [](Workload& w) {
+    UniformGrid grid;
+    grid.cellSize = 2.f;
+    for (int32_t i = 0; i < w.scale; i++) {
+      insertIntoGrid(grid, w.rects0[i], i);
+    }
+
+    eastl::vector<IndexPair> pairs;
+    findGridCandidatePairs(grid, pairs);
+    doNotOptimize(pairs.data());
+  }});
+  benchmarks.push_back({"broadphase/tree/insertAndFindPairs",
+                        [](Workload& w) {
+    AABBTree tree;
+    for (int32_t i = 0; i < w.scale; i++) {
+      insertIntoTree(tree, w.rects0[i], i);
+    }
+
+    eastl::vector<IndexPair> pairs;
+    findTreeCandidatePairs(tree, pairs);
+    doNotOptimize(pairs.data());
+  }});
+
+  // Sweep-line intersection. Each pass finds all intersecting pairs.
+  benchmarks.push_back({"sweep/findSegmentIntersections", [](Workload& w) {
+    int32_t numIntersections = 0;
+    findSegmentIntersections(
+      w.linePool,
+      [&numIntersections](const Point&, int32_t, int32_t) {
+        numIntersections++;
+      });
+    doNotOptimize(numIntersections);
+  }});
+  benchmarks.push_back({"sweep/findNPolygonEdgeIntersections",
+                        [](Workload& w) {
+    int32_t numIntersections = 0;
+    findNPolygonEdgeIntersections(
+      w.region,
+      [&numIntersections](const Point&, int32_t, int32_t) {
+        numIntersections++;
+      });
+    doNotOptimize(numIntersections);
+  }});
+
+  // Convex hulls. Each pass builds the hull of all points.
+  benchmarks.push_back({"hull/convexHullFromPoints", [](Workload& w) {
+    NPolygon hull;
+    convexHullFromPoints(w.points.data(), w.scale, hull);
+    doNotOptimize(hull.vertices.data());
+  }});
+  benchmarks.push_back({"hull/addToConvexHull", [](Workload& w) {
+    IncrementalConvexHull hull;
+    addToConvexHull(hull, w.points.data(), w.scale);
+    doNotOptimize(getNumConvexHullVertices(hull));
+  }});
+
+  // Triangulation. The scratch memory and the indices are reused across
+  // polygons, like they would be in a renderer.
+  benchmarks.push_back({"triangulation/triangulateNPolygon",
+                        [](Workload& w) {
+    TriangulationScratch scratch;
+    eastl::vector<int32_t> triangleIndices;
+    for (int32_t i = 0; i < w.scale; i++) {
+      doNotOptimize(triangulateNPolygon(w.polygons0[i],
+                                        triangleIndices,
+                                        scratch));
+    }
+  }});
+
+  // Narrowphase. Rectangles get turned into their vertices once per call.
+  benchmarks.push_back({"narrowphase/areConvexShapesIntersecting",
+                        [](Workload& w) {
+    for (int32_t i = 0; i < w.scale; i++) {
+      doNotOptimize(areConvexShapesIntersecting(w.rects0[i], w.rects1[i]));
+    }
+  }});
+  benchmarks.push_back({"narrowphase/getConvexShapesPenetration",
+                        [](Workload& w) {
+    for (int32_t i = 0; i < w.scale; i++) {
+      doNotOptimize(getConvexShapesPenetration(w.polygons0[i],
+                                               w.polygons1[i]));
+    }
+  }});
+
+  // Slow setup functions.
+  benchmarks.push_back({"geometry/prepareRectangle", [](Workload& w) {
+    for (int32_t i = 0; i < w.scale; i++) {
+      doNotOptimize(prepareRectangle(w.rects0[i]));
+    }
+  }});
+  benchmarks.push_back({"geometry/prepareNPolygon", [](Workload& w) {
+    for (int32_t i = 0; i < w.scale; i++) {
+      PreparedNPolygon prepared = prepareNPolygon(w.polygons0[i]);
+      doNotOptimize(prepared.numSlabs);
+    }
+  }});
+
+  return benchmarks;
+}
+
+static void printUsage(const char* programName)
+{
+  std::fprintf(stderr,
+               "Usage: %s [--filter <substring>] [--min-scale <n>] "
+               "[--max-scale <n>] [--min-time <seconds>] [--seed <n>] "
+               "[--json <path>]\n",
+               programName);
+}
+
+int main(int argc, char** argv)
+{
+  const char* filter = nullptr;
+  const char* jsonPath = nullptr;
+  int32_t minScale = 10;
+  int32_t maxScale = 1000000;
+  double minSeconds = 0.1;
+  uint32_t seed = 42;
+
+  for (int32_t i = 1; i < argc; i++) {
+    bool hasValue = (i + 1) < argc;
+    if (std::strcmp(argv[i], "--filter") == 0 && hasValue) {
+      filter = argv[++i];
+    } else if (std::strcmp(argv[i], "--json") == 0 && hasValue) {
+      jsonPath = argv[++i];
+    } else if (std::strcmp(argv[i], "--min-scale") == 0 && hasValue) {
+      minScale = std::atoi(argv[++i]);
+    } else if (std::strcmp(argv[i], "--max-scale") == 0 && hasValue) {
+      maxScale = std::atoi(argv[++i]);
+    } else if (std::strcmp(argv[i], "--min-time") == 0 && hasValue) {
+      minSeconds = std::atof(argv[++i]);
+    } else if (std::strcmp(argv[i], "--seed") == 0 && hasValue) {
+      seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+    } else {
+      printUsage(argv[0]);
+      return EXIT_FAILURE;
+    }
+  }
+
+  eastl::vector<Benchmark> benchmarks = makeBenchmarks();
+  eastl::vector<BenchmarkResult> results;
+
+  printResultHeader(stdout);
+  for (int32_t scale = 10; scale <= 1000000; scale *= 10) {
+    if (scale < minScale || scale > maxScale) {
+      continue;
+    }
+
+    // The same seed gives the same workload, so runs can be compared.
+    Workload workload = makeWorkload(scale, seed);
+    for (const Benchmark& benchmark : benchmarks) {
+      if (scale > benchmark.maxScale
+          || (filter != nullptr
+              && benchmark.name.find(filter) == eastl::string::npos)) {
+        continue;
+      }
+
+      results.push_back(runBenchmark(benchmark, workload, minSeconds));
+      printResult(stdout, results.back());
+    }
+  }
+
+  if (jsonPath != nullptr) {
+    FILE* jsonFile = std::fopen(jsonPath, "w");
+    if (jsonFile == nullptr) {
+      std::fprintf(stderr, "Unable to open %s for writing.\n", jsonPath);
+      return EXIT_FAILURE;
+    }
+
+    writeResultsAsJSON(jsonFile, results, seed);
+    std::fclose(jsonFile);
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,183 @@
+#include <cmath>
+#include <cstdint>
+#include <random>
+
+#include <EASTL/algorithm.h>
+#include <EASTL/vector.h>
+
+#include <corex/math.hpp>
+
+#include "workload.hpp"
+
+namespace cx::bench
+{
+  static constexpr float averageShapeSize = 2.f;
+  static constexpr int32_t numRegionVertices = 64;
+
+  static NPolygon makeConvexPolygon(std::mt19937& rng,
+                                    float centerX,
+                                    float centerY,
+                                    float radius)
+  {
+    std::uniform_int_distribution<int32_t> numVerticesDist{3, 8};
+    std::uniform_real_distribution<float> angleDist{0.f, 360.f};
+
+    int32_t numVertices = numVerticesDist(rng);
+    eastl::vector<float> angles;
+    for (int32_t i = 0; i < numVertices; i++) {
+      angles.push_back(angleDist(rng));
+    }
+
+    // Ascending angles give the clockwise winding, in the windowing system,
+    // that the library uses.
+    eastl::sort(angles.begin(), angles.end());
+
+    NPolygon polygon;
+    for (float angle : angles) {
+      Vec2 offset = rotateVec2(Vec2{radius, 0.f}, angle);
+      polygon.vertices.push_back(Point{centerX + offset.x,
+                                       centerY + offset.y});
+    }
+
+    return polygon;
+  }
+
+  static NPolygon makeRegion(std::mt19937& rng, float worldSize)
+  {
+    // A star-like polygon, so that it is concave.
+    std::uniform_real_distribution<float> radiusDist{0.3f, 0.5f};
+
+    float center = worldSize / 2.f;
+    NPolygon region;
+    for (int32_t i = 0; i < numRegionVertices; i++) {
+      float angle = 360.f * static_cast<float>(i) / numRegionVertices;
+      Vec2 offset = rotateVec2(Vec2{radiusDist(rng) * worldSize, 0.f}, angle);
+      region.vertices.push_back(Point{center + offset.x, center + offset.y});
+    }
+
+    return region;
+  }
+
+  Workload makeWorkload(int32_t scale, uint32_t seed)
+  {
+    std::mt19937 rng{seed};
+
+    Workload workload;
+    workload.scale = scale;
+
+    // Keep about a shape per four squared units of the world.
+    workload.worldSize = averageShapeSize
+                         * std::sqrt(static_cast<float>(scale))
+                         * 2.f;
+
+    std::uniform_real_distribution<float> positionDist{0.f,
+                                                       workload.worldSize};
+    std::uniform_real_distribution<float> sizeDist{averageShapeSize * 0.5f,
+                                                   averageShapeSize * 1.5f};
+    std::uniform_real_distribution<float> angleDist{0.f, 360.f};
+    std::uniform_real_distribution<float> offsetDist{-averageShapeSize,
+                                                     averageShapeSize};
+    std::uniform_real_distribution<float> vectorDist{-100.f, 100.f};
+
+    for (int32_t i = 0; i < scale; i++) {
+      Rectangle rect0{positionDist(rng), positionDist(rng),
+                      sizeDist(rng), sizeDist(rng), angleDist(rng)};
+      Rectangle rect1{rect0.x + offsetDist(rng), rect0.y + offsetDist(rng),
+                      sizeDist(rng), sizeDist(rng), angleDist(rng)};
+      workload.rects0.push_back(rect0);
+      workload.rects1.push_back(rect1);
+      workload.preparedRects0.push_back(prepareRectangle(rect0));
+      workload.preparedRects1.push_back(prepareRectangle(rect1));
+      workload.rotations0.push_back(rotationFromAngle(rect0.angle));
+      workload.rotations1.push_back(rotationFromAngle(rect1.angle));
+      workload.boxes0.push_back(getRectangleAABB(rect0));
+      workload.boxes1.push_back(getRectangleAABB(rect1));
+      workload.circles0.push_back(getRectBoundingCircle(rect0));
+      workload.circles1.push_back(getRectBoundingCircle(rect1));
+
+      float polyX = positionDist(rng);
+      float polyY = positionDist(rng);
+      workload.polygons0.push_back(
+        makeConvexPolygon(rng, polyX, polyY, sizeDist(rng) / 2.f));
+      workload.polygons1.push_back(
+        makeConvexPolygon(rng,
+                          polyX + offsetDist(rng),
+                          polyY + offsetDist(rng),
+                          sizeDist(rng) / 2.f));
+
+      workload.points.push_back(Point{positionDist(rng), positionDist(rng)});
+      workload.vectors0.push_back(Vec2{vectorDist(rng), vectorDist(rng)});
+      workload.vectors1.push_back(Vec2{vectorDist(rng), vectorDist(rng)});
+
+      Point lineStart{positionDist(rng), positionDist(rng)};
+      workload.lines0.push_back(Line{
+        lineStart,
+        Point{lineStart.x + offsetDist(rng), lineStart.y + offsetDist(rng)}
+      });
+      workload.lines1.push_back(Line{
+        Point{lineStart.x + offsetDist(rng), lineStart.y + offsetDist(rng)},
+        Point{lineStart.x + offsetDist(rng), lineStart.y + offsetDist(rng)}
+      });
+    }
+
+    workload.region = makeRegion(rng, workload.worldSize);
+    workload.preparedRegion = prepareNPolygon(workload.region);
+
+    for (const eastl::vector<Rectangle>* rects : { &workload.rects0,
+                                                   &workload.rects1 }) {
+      for (const Rectangle& rect : *rects) {
+        workload.rectBuffer.x.push_back(rect.x);
+        workload.rectBuffer.y.push_back(rect.y);
+        workload.rectBuffer.width.push_back(rect.width);
+        workload.rectBuffer.height.push_back(rect.height);
+        workload.rectBuffer.angle.push_back(rect.angle);
+      }
+    }
+
+    for (const eastl::vector<Circle>* circles : { &workload.circles0,
+                                                  &workload.circles1 }) {
+      for (const Circle& circle : *circles) {
+        workload.circleBuffer.x.push_back(circle.position.x);
+        workload.circleBuffer.y.push_back(circle.position.y);
+        workload.circleBuffer.radius.push_back(circle.radius);
+      }
+    }
+
+    for (const Point& point : workload.points) {
+      workload.pointBuffer.x.push_back(point.x);
+      workload.pointBuffer.y.push_back(point.y);
+    }
+
+    workload.polygonBuffer.offsets.push_back(0);
+    for (const NPolygon& polygon : workload.polygons0) {
+      for (const Point& vertex : polygon.vertices) {
+        workload.polygonBuffer.x.push_back(vertex.x);
+        workload.polygonBuffer.y.push_back(vertex.y);
+      }
+
+      workload.polygonBuffer.offsets.push_back(
+        static_cast<int32_t>(workload.polygonBuffer.x.size()));
+    }
+
+    workload.rectPool = workload.rects0;
+    workload.rectPool.insert(workload.rectPool.end(),
+                             workload.rects1.begin(),
+                             workload.rects1.end());
+
+    workload.linePool = workload.lines0;
+    workload.linePool.insert(workload.linePool.end(),
+                             workload.lines1.begin(),
+                             workload.lines1.end());
+
+    workload.polygonPool = workload.polygons0;
+    workload.polygonPool.insert(workload.polygonPool.end(),
+                                workload.polygons1.begin(),
+                                workload.polygons1.end());
+    for (int32_t i = 0; i < scale; i++) {
+      workload.rectBufferPairs.push_back(IndexPair{i, scale + i});
+      workload.polygonPoolPairs.push_back(IndexPair{i, scale + i});
+    }
+
+    return workload;
+  }
+}
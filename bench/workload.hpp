@@ -0,0 +1,76 @@
+#ifndef COREX_MATH_BENCH_WORKLOAD_HPP
+#define COREX_MATH_BENCH_WORKLOAD_HPP
+
+#include <cstdint>
+
+#include <EASTL/vector.h>
+
+#include <corex/math/ds.hpp>
+
+namespace cx::bench
+{
+  // Randomized, but seeded, shapes for the benchmarks. Each benchmark performs
+  // one operation per shape (or per pair of shapes) in the workload. Shapes are
+  // spread over a world that grows with the scale, so that the density of the
+  // shapes, and thus the ratio of hits and misses, stays the same.
+  //
+  // The i-th shape in rects1 and polygons1 is placed near the i-th shape in
+  // rects0 and polygons0, respectively, so that about half of the pairs are
+  // overlapping.
+  struct Workload
+  {
+    int32_t scale;
+    float worldSize;
+    eastl::vector<Rectangle> rects0;
+    eastl::vector<Rectangle> rects1;
+    eastl::vector<PreparedRectangle> preparedRects0;
+    eastl::vector<PreparedRectangle> preparedRects1;
+    eastl::vector<Rotation> rotations0;
+    eastl::vector<Rotation> rotations1;
+    eastl::vector<NPolygon> polygons0;
+    eastl::vector<NPolygon> polygons1;
+    eastl::vector<Point> points;
+    eastl::vector<Vec2> vectors0;
+    eastl::vector<Vec2> vectors1;
+    eastl::vector<Line> lines0;
+    eastl::vector<Line> lines1;
+    eastl::vector<AABB> boxes0;
+    eastl::vector<AABB> boxes1;
+
+    // Bounding circles of rects0 and rects1.
+    eastl::vector<Circle> circles0;
+    eastl::vector<Circle> circles1;
+
+    // A concave polygon spanning the whole world, for point and rectangle
+    // containment tests.
+    NPolygon region;
+    PreparedNPolygon preparedRegion;
+
+    // rects0 followed by rects1, with pairs (i, scale + i), for the batch
+    // functions.
+    RectangleBuffer rectBuffer;
+    eastl::vector<IndexPair> rectBufferPairs;
+    PointBuffer pointBuffer;
+
+    // polygons0, with the vertices of all polygons back to back.
+    PolygonBuffer polygonBuffer;
+
+    // circles0 followed by circles1, which rectBufferPairs work for too.
+    CircleBuffer circleBuffer;
+
+    // rects0 followed by rects1, as an array of structures, for the batch
+    // functions that take Rectangles. rectBufferPairs work for it too.
+    eastl::vector<Rectangle> rectPool;
+
+    // lines0 followed by lines1, for the sweep-line intersection.
+    eastl::vector<Line> linePool;
+
+    // Pairs (i, scale + i) of polygons0 followed by polygons1.
+    eastl::vector<NPolygon> polygonPool;
+    eastl::vector<IndexPair> polygonPoolPairs;
+  };
+
+  Workload makeWorkload(int32_t scale, uint32_t seed);
+}
+
+#endif
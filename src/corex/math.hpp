@@ -2,10 +2,25 @@
 #define COREX_MATH_HPP
 
 #include <corex/math/algebra.hpp>
+#include <corex/math/allocators.hpp>
+#include <corex/math/batch.hpp>
+#include <corex/math/broadphase.hpp>
+#include <corex/math/clipping.hpp>
+#include <corex/math/coherence.hpp>
 #include <corex/math/constants.hpp>
+#include <corex/math/continuous.hpp>
 #include <corex/math/ds.hpp>
+#include <corex/math/fast.hpp>
 #include <corex/math/geometry.hpp>
+#include <corex/math/hull.hpp>
+#include <corex/math/instrumentation.hpp>
 #include <corex/math/linear_algebra.hpp>
+#include <corex/math/narrowphase.hpp>
+#include <corex/math/parallel.hpp>
+#include <corex/math/quantization.hpp>
+#include <corex/math/robust.hpp>
+#include <corex/math/sweep.hpp>
+#include <corex/math/triangulation.hpp>
 #include <corex/math/utils.hpp>
 
 // For source-level backwards-compatibility.
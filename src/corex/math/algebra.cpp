@@ -2,47 +2,13 @@
 
 #include <corex/utils.hpp>
 #include <corex/math/algebra.hpp>
+#include <corex/math/instrumentation.hpp>
 
 namespace cx
 {
-  int factorial(int n)
-  {
-    int total = 1;
-    for (; n > 1; n--) {
-      total *= n;
-    }
-
-    return total;
-  }
-
-  int pyModInt(int x, int divisor)
-  {
-    // From: https://stackoverflow.com/a/44197900/1116098
-    return (divisor + (x % divisor)) % divisor;
-  }
-
-  int pow(int base, int exponent)
-  {
-    assert(exponent >= 0);
-
-    // Note that std::pow() is slow. So, we're using a custom implementation
-    // of a basic pow() for integers.
-    if (exponent == 0) {
-      return 1;
-    } else if (base == 0) {
-      return 0;
-    } else {
-      int result = 1;
-      for (int i = 0; i < exponent; i++) {
-        result *= base;
-      }
-
-      return result;
-    }
-  }
-
   float pow(float base, int exponent)
   {
+    COREX_MATH_INSTRUMENT(pow);
     assert(exponent >= 0);
 
     // Note that std::pow() is slow. So, we're using a custom implementation
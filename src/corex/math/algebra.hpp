@@ -1,12 +1,82 @@
 #ifndef COREX_MATH_ALGEBRA_HPP
 #define COREX_MATH_ALGEBRA_HPP
 
+#include <cassert>
+#include <cstdint>
+#include <type_traits>
+
 namespace cx
 {
-  int factorial(int n);
-  int pyModInt(int x, int divisor);
-  int pow(int base, int exponent);
   float pow(float base, int exponent);
+
+  inline constexpr int factorial(int n)
+  {
+    int total = 1;
+    for (; n > 1; n--) {
+      total *= n;
+    }
+
+    return total;
+  }
+
+  inline constexpr int pyModInt(int x, int divisor)
+  {
+    // From: https://stackoverflow.com/a/44197900/1116098
+    return (divisor + (x % divisor)) % divisor;
+  }
+
+  inline constexpr int pow(int base, int exponent)
+  {
+    assert(exponent >= 0);
+
+    // Note that std::pow() is slow. So, we're using a custom implementation
+    // of a basic pow() for integers.
+    if (exponent == 0) {
+      return 1;
+    } else if (base == 0) {
+      return 0;
+    } else {
+      int result = 1;
+      for (int i = 0; i < exponent; i++) {
+        result *= base;
+      }
+
+      return result;
+    }
+  }
+
+  inline constexpr float roundFloat(float n)
+  {
+    // Same as roundf(), including the sign of zero, but usable in constant
+    // expressions. Floats this big, infinities, and NaNs are already
+    // integral, or can't be rounded.
+    constexpr float minNonFractionalFloat = 8388608.f; // 2^23
+    if (!(n > -minNonFractionalFloat && n < minNonFractionalFloat)) {
+      return n;
+    }
+
+    // Truncating towards zero and subtracting are both exact here.
+    float truncated = static_cast<float>(static_cast<int32_t>(n));
+    float fraction = n - truncated;
+    if (fraction >= 0.5f) {
+      truncated += 1.f;
+    } else if (fraction <= -0.5f) {
+      truncated -= 1.f;
+    }
+
+    // Truncating loses the sign of negative numbers that round to zero.
+    return (truncated == 0.f) ? n * 0.f : truncated;
+  }
+
+  template <typename T,
+            std::enable_if_t<std::is_floating_point<T>::value, bool> = true
+  >
+  constexpr T setDecPlaces(T n, int numDecPlaces)
+  {
+    // We're using a custom pow() because std::pow() is slow.
+    int multiplier = cx::pow(10, numDecPlaces);
+    return roundFloat(n * static_cast<float>(multiplier)) / multiplier;
+  }
 }
 
 #endif
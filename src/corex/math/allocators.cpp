@@ -0,0 +1,312 @@
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+
+#include <EASTL/algorithm.h>
+
+#include <corex/math/allocators.hpp>
+
+namespace cx
+{
+  static void* allocateFromHeap(size_t size, size_t alignment);
+  static char* alignPointer(char* ptr, size_t alignment);
+
+  FrameArena::FrameArena(size_t capacity)
+    : buffer{static_cast<char*>(allocateFromHeap(capacity,
+                                                 alignof(std::max_align_t)))}
+    , capacity{capacity}
+    , offset{0}
+    , numHeapAllocations{0} {}
+
+  FrameArena::~FrameArena()
+  {
+    std::free(this->buffer);
+  }
+
+  void* FrameArena::allocate(size_t size, size_t alignment)
+  {
+    char* ptr = alignPointer(this->buffer + this->offset, alignment);
+    size_t newOffset = static_cast<size_t>(ptr - this->buffer) + size;
+    if (newOffset > this->capacity) {
+      this->numHeapAllocations++;
+      return allocateFromHeap(size, alignment);
+    }
+
+    this->offset = newOffset;
+    return ptr;
+  }
+
+  void FrameArena::deallocate(void* ptr)
+  {
+    // Memory in the arena is only released on reset.
+    char* bytePtr = static_cast<char*>(ptr);
+    if (bytePtr < this->buffer || bytePtr >= this->buffer + this->capacity) {
+      std::free(ptr);
+    }
+  }
+
+  void FrameArena::reset()
+  {
+    this->offset = 0;
+    this->numHeapAllocations = 0;
+  }
+
+  size_t FrameArena::getCapacity() const
+  {
+    return this->capacity;
+  }
+
+  size_t FrameArena::getNumBytesUsed() const
+  {
+    return this->offset;
+  }
+
+  size_t FrameArena::getNumHeapAllocations() const
+  {
+    return this->numHeapAllocations;
+  }
+
+  FixedSizePool::FixedSizePool(size_t blockSize, size_t numBlocks)
+    : blocks{nullptr}
+    , blockSize{0}
+    , numBlocks{numBlocks}
+    , numUsedBlocks{0}
+    , freeList{nullptr}
+    , numHeapAllocations{0}
+  {
+    // Blocks must be able to hold a free list node, and keep every block
+    // aligned like the memory from the global heap.
+    constexpr size_t blockAlignment = alignof(std::max_align_t);
+    this->blockSize = eastl::max(blockSize, sizeof(FreeBlock));
+    this->blockSize = ((this->blockSize + blockAlignment - 1) / blockAlignment)
+                      * blockAlignment;
+    this->blocks = static_cast<char*>(
+      allocateFromHeap(this->blockSize * this->numBlocks, blockAlignment));
+  }
+
+  FixedSizePool::~FixedSizePool()
+  {
+    std::free(this->blocks);
+  }
+
+  void* FixedSizePool::allocate(size_t size, size_t alignment)
+  {
+    if (size > this->blockSize || alignment > alignof(std::max_align_t)) {
+      this->numHeapAllocations++;
+      return allocateFromHeap(size, alignment);
+    }
+
+    if (this->freeList != nullptr) {
+      FreeBlock* block = this->freeList;
+      this->freeList = block->next;
+      return block;
+    }
+
+    if (this->numUsedBlocks < this->numBlocks) {
+      void* block = this->blocks + (this->numUsedBlocks * this->blockSize);
+      this->numUsedBlocks++;
+      return block;
+    }
+
+    this->numHeapAllocations++;
+    return allocateFromHeap(size, alignment);
+  }
+
+  void FixedSizePool::deallocate(void* ptr)
+  {
+    if (ptr == nullptr) {
+      return;
+    }
+
+    if (!this->isInPool(ptr)) {
+      std::free(ptr);
+      return;
+    }
+
+    FreeBlock* block = static_cast<FreeBlock*>(ptr);
+    block->next = this->freeList;
+    this->freeList = block;
+  }
+
+  void FixedSizePool::releaseAll()
+  {
+    // Forgetting the free list is enough, since every block will be treated
+    // as never allocated again.
+    this->numUsedBlocks = 0;
+    this->freeList = nullptr;
+    this->numHeapAllocations = 0;
+  }
+
+  size_t FixedSizePool::getBlockSize() const
+  {
+    return this->blockSize;
+  }
+
+  size_t FixedSizePool::getNumBlocks() const
+  {
+    return this->numBlocks;
+  }
+
+  size_t FixedSizePool::getNumHeapAllocations() const
+  {
+    return this->numHeapAllocations;
+  }
+
+  bool FixedSizePool::isInPool(const void* ptr) const
+  {
+    const char* bytePtr = static_cast<const char*>(ptr);
+    return bytePtr >= this->blocks
+           && bytePtr < this->blocks + (this->blockSize * this->numBlocks);
+  }
+
+  FrameArenaAllocator::FrameArenaAllocator(const char* name)
+    : arena{nullptr}
+    , name{name} {}
+
+  FrameArenaAllocator::FrameArenaAllocator(FrameArena* arena,
+                                           const char* name)
+    : arena{arena}
+    , name{name} {}
+
+  void* FrameArenaAllocator::allocate(size_t n, int flags)
+  {
+    return this->allocate(n, alignof(std::max_align_t), 0, flags);
+  }
+
+  void* FrameArenaAllocator::allocate(size_t n,
+                                      size_t alignment,
+                                      size_t offset,
+                                      int /* flags */)
+  {
+    // EASTL containers only ever need the start of the memory aligned.
+    assert(offset == 0);
+
+    if (this->arena == nullptr) {
+      return allocateFromHeap(n, alignment);
+    }
+
+    return this->arena->allocate(n, alignment);
+  }
+
+  void FrameArenaAllocator::deallocate(void* p, size_t /* n */)
+  {
+    if (this->arena == nullptr) {
+      std::free(p);
+    } else {
+      this->arena->deallocate(p);
+    }
+  }
+
+  const char* FrameArenaAllocator::get_name() const
+  {
+    return this->name;
+  }
+
+  void FrameArenaAllocator::set_name(const char* name)
+  {
+    this->name = name;
+  }
+
+  FrameArena* FrameArenaAllocator::getArena() const
+  {
+    return this->arena;
+  }
+
+  bool operator==(const FrameArenaAllocator& a, const FrameArenaAllocator& b)
+  {
+    return a.getArena() == b.getArena();
+  }
+
+  bool operator!=(const FrameArenaAllocator& a, const FrameArenaAllocator& b)
+  {
+    return a.getArena() != b.getArena();
+  }
+
+  FixedSizePoolAllocator::FixedSizePoolAllocator(const char* name)
+    : pool{nullptr}
+    , name{name} {}
+
+  FixedSizePoolAllocator::FixedSizePoolAllocator(FixedSizePool* pool,
+                                                 const char* name)
+    : pool{pool}
+    , name{name} {}
+
+  void* FixedSizePoolAllocator::allocate(size_t n, int flags)
+  {
+    return this->allocate(n, alignof(std::max_align_t), 0, flags);
+  }
+
+  void* FixedSizePoolAllocator::allocate(size_t n,
+                                         size_t alignment,
+                                         size_t offset,
+                                         int /* flags */)
+  {
+    assert(offset == 0);
+
+    if (this->pool == nullptr) {
+      return allocateFromHeap(n, alignment);
+    }
+
+    return this->pool->allocate(n, alignment);
+  }
+
+  void FixedSizePoolAllocator::deallocate(void* p, size_t /* n */)
+  {
+    if (this->pool == nullptr) {
+      std::free(p);
+    } else {
+      this->pool->deallocate(p);
+    }
+  }
+
+  const char* FixedSizePoolAllocator::get_name() const
+  {
+    return this->name;
+  }
+
+  void FixedSizePoolAllocator::set_name(const char* name)
+  {
+    this->name = name;
+  }
+
+  FixedSizePool* FixedSizePoolAllocator::getPool() const
+  {
+    return this->pool;
+  }
+
+  bool operator==(const FixedSizePoolAllocator& a,
+                  const FixedSizePoolAllocator& b)
+  {
+    return a.getPool() == b.getPool();
+  }
+
+  bool operator!=(const FixedSizePoolAllocator& a,
+                  const FixedSizePoolAllocator& b)
+  {
+    return a.getPool() != b.getPool();
+  }
+
+  static void* allocateFromHeap(size_t size, size_t alignment)
+  {
+    void* ptr = nullptr;
+    if (alignment <= alignof(std::max_align_t)) {
+      ptr = std::malloc(eastl::max(size, size_t{1}));
+    } else {
+      // aligned_alloc() needs the size to be a multiple of the alignment.
+      ptr = std::aligned_alloc(alignment,
+                               ((size + alignment - 1) / alignment)
+                               * alignment);
+    }
+
+    return ptr;
+  }
+
+  static char* alignPointer(char* ptr, size_t alignment)
+  {
+    uintptr_t address = reinterpret_cast<uintptr_t>(ptr);
+    uintptr_t alignedAddress = (address + alignment - 1)
+                               & ~(static_cast<uintptr_t>(alignment) - 1);
+    return ptr + (alignedAddress - address);
+  }
+}
@@ -0,0 +1,147 @@
+#ifndef COREX_MATH_ALLOCATORS_HPP
+#define COREX_MATH_ALLOCATORS_HPP
+
+#include <cstddef>
+
+namespace cx
+{
+  // A linear allocator for memory that only needs to live until the end of a
+  // frame, such as scratch geometry. Allocating just bumps an offset, and all
+  // of the memory is released at once, in O(1), with reset(). Individual
+  // deallocations are ignored.
+  //
+  // Once the arena is full, allocations fall back to the global heap. Those
+  // are freed when deallocated, since reset() can't reclaim them. An arena
+  // must not be shared between threads, and nothing allocated from it may be
+  // used after a reset.
+  class FrameArena
+  {
+  public:
+    explicit FrameArena(size_t capacity);
+    ~FrameArena();
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    void* allocate(size_t size, size_t alignment);
+    void deallocate(void* ptr);
+    void reset();
+
+    size_t getCapacity() const;
+    size_t getNumBytesUsed() const;
+    size_t getNumHeapAllocations() const;
+
+  private:
+    char* buffer;
+    size_t capacity;
+    size_t offset;
+    size_t numHeapAllocations;
+  };
+
+  // A pool of equally-sized blocks, for objects whose maximum size is known,
+  // e.g. the vertices of clipped rectangles, which never go beyond eight.
+  // Blocks can be freed individually, and all blocks can be released at once,
+  // in O(1), with releaseAll().
+  //
+  // Allocations bigger than the block size, or made once all blocks are in
+  // use, fall back to the global heap. Like FrameArena, a pool must not be
+  // shared between threads, and nothing allocated from it may be used after
+  // all blocks are released.
+  class FixedSizePool
+  {
+  public:
+    FixedSizePool(size_t blockSize, size_t numBlocks);
+    ~FixedSizePool();
+
+    FixedSizePool(const FixedSizePool&) = delete;
+    FixedSizePool& operator=(const FixedSizePool&) = delete;
+
+    void* allocate(size_t size, size_t alignment);
+    void deallocate(void* ptr);
+    void releaseAll();
+
+    size_t getBlockSize() const;
+    size_t getNumBlocks() const;
+    size_t getNumHeapAllocations() const;
+
+  private:
+    struct FreeBlock
+    {
+      FreeBlock* next;
+    };
+
+    bool isInPool(const void* ptr) const;
+
+    char* blocks;
+    size_t blockSize;
+    size_t numBlocks;
+
+    // Blocks from this index onwards have never been allocated since the last
+    // release, so they don't need to be in the free list.
+    size_t numUsedBlocks;
+    FreeBlock* freeList;
+    size_t numHeapAllocations;
+  };
+
+  // EASTL allocators backed by the allocators above, for use with EASTL
+  // containers, BasicNPolygon and BasicLineSegments, e.g.
+  //
+  //     BasicNPolygon<FrameArenaAllocator> polygon;
+  //     polygon.vertices.set_allocator(FrameArenaAllocator{&arena});
+  //
+  // A default-constructed allocator, which EASTL containers sometimes create,
+  // uses the global heap.
+  class FrameArenaAllocator
+  {
+  public:
+    explicit FrameArenaAllocator(const char* name = "FrameArenaAllocator");
+    explicit FrameArenaAllocator(FrameArena* arena,
+                                 const char* name = "FrameArenaAllocator");
+
+    void* allocate(size_t n, int flags = 0);
+    void* allocate(size_t n, size_t alignment, size_t offset, int flags = 0);
+    void deallocate(void* p, size_t n);
+
+    const char* get_name() const;
+    void set_name(const char* name);
+
+    FrameArena* getArena() const;
+
+  private:
+    FrameArena* arena;
+    const char* name;
+  };
+
+  bool operator==(const FrameArenaAllocator& a, const FrameArenaAllocator& b);
+  bool operator!=(const FrameArenaAllocator& a, const FrameArenaAllocator& b);
+
+  class FixedSizePoolAllocator
+  {
+  public:
+    explicit FixedSizePoolAllocator(
+      const char* name = "FixedSizePoolAllocator");
+    explicit FixedSizePoolAllocator(
+      FixedSizePool* pool,
+      const char* name = "FixedSizePoolAllocator");
+
+    void* allocate(size_t n, int flags = 0);
+    void* allocate(size_t n, size_t alignment, size_t offset, int flags = 0);
+    void deallocate(void* p, size_t n);
+
+    const char* get_name() const;
+    void set_name(const char* name);
+
+    FixedSizePool* getPool() const;
+
+  private:
+    FixedSizePool* pool;
+    const char* name;
+  };
+
+  bool operator==(const FixedSizePoolAllocator& a,
+                  const FixedSizePoolAllocator& b);
+  bool operator!=(const FixedSizePoolAllocator& a,
+                  const FixedSizePoolAllocator& b);
+}
+
+#endif
@@ -0,0 +1,996 @@
+#include <cmath>
+#include <cstdint>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include <EASTL/algorithm.h>
+#include <EASTL/numeric_limits.h>
+#include <EASTL/vector.h>
+
+#include <corex/math/batch.hpp>
+#include <corex/math/ds.hpp>
+#include <corex/math/geometry.hpp>
+#include <corex/math/instrumentation.hpp>
+#include <corex/math/linear_algebra.hpp>
+#include <corex/math/parallel.hpp>
+
+namespace cx
+{
+  // Two projected intervals that are only apart by this much are still
+  // considered to be overlapping. This lets rectangles that are just touching
+  // each other be considered intersecting, like in areTwoRectsIntersecting().
+  // The tolerance and the rounding are not the same as the ones of
+  // areTwoRectsIntersecting(), so see batch.hpp for how much the results of
+  // the two can differ.
+  constexpr float intervalTolerance = 0.00001f;
+
+  static int32_t roundChunkSizeToMaskWords(int32_t chunkSize);
+
+  static bool areRectPairIntervalsOverlapping(const float* centerXs,
+                                              const float* centerYs,
+                                              const float* halfWidths,
+                                              const float* halfHeights,
+                                              const float* cosines,
+                                              const float* sines,
+                                              const IndexPair& pair)
+  {
+    int32_t a = pair.first;
+    int32_t b = pair.second;
+
+    // The axes of a rectangle are its x-axis, (cos, sin), and its y-axis,
+    // (-sin, cos), which are the same axes areTwoRectsIntersecting() gets
+    // from rotateVec2(). Since the axes are unit vectors, the projection of a
+    // rectangle onto one of them is an interval around the projection of
+    // its center whose radius only depends on how the axes of both
+    // rectangles are aligned with each other.
+    float deltaX = centerXs[b] - centerXs[a];
+    float deltaY = centerYs[b] - centerYs[a];
+    float alignXX = std::fabs((cosines[a] * cosines[b])
+                              + (sines[a] * sines[b]));
+    float alignXY = std::fabs((sines[a] * cosines[b])
+                              - (cosines[a] * sines[b]));
+
+    float distAxisX0 = std::fabs((deltaX * cosines[a]) + (deltaY * sines[a]));
+    float distAxisY0 = std::fabs((deltaY * cosines[a]) - (deltaX * sines[a]));
+    float distAxisX1 = std::fabs((deltaX * cosines[b]) + (deltaY * sines[b]));
+    float distAxisY1 = std::fabs((deltaY * cosines[b]) - (deltaX * sines[b]));
+
+    return distAxisX0 <= (halfWidths[a]
+                          + (halfWidths[b] * alignXX)
+                          + (halfHeights[b] * alignXY)
+                          + intervalTolerance)
+           && distAxisY0 <= (halfHeights[a]
+                             + (halfWidths[b] * alignXY)
+                             + (halfHeights[b] * alignXX)
+                             + intervalTolerance)
+           && distAxisX1 <= ((halfWidths[a] * alignXX)
+                             + (halfHeights[a] * alignXY)
+                             + halfWidths[b]
+                             + intervalTolerance)
+           && distAxisY1 <= ((halfWidths[a] * alignXY)
+                             + (halfHeights[a] * alignXX)
+                             + halfHeights[b]
+                             + intervalTolerance);
+  }
+
+  struct RectRotations
+  {
+    // The half extents and the rotation of each rectangle of a
+    // RectangleBuffer, which is what the pair test needs of a rectangle.
+    eastl::vector<float> halfWidths;
+    eastl::vector<float> halfHeights;
+    eastl::vector<float> cosines;
+    eastl::vector<float> sines;
+  };
+
+  static void resizeRectRotations(RectRotations& rotations, int32_t numRects)
+  {
+    rotations.halfWidths.resize(numRects);
+    rotations.halfHeights.resize(numRects);
+    rotations.cosines.resize(numRects);
+    rotations.sines.resize(numRects);
+  }
+
+  static void computeRectRotations(const RectangleBuffer& rects,
+                                   int32_t begin,
+                                   int32_t end,
+                                   RectRotations& rotations)
+  {
+    for (int32_t i = begin; i < end; i++) {
+      Rotation rotation = rotationFromAngle(rects.angle[i]);
+      rotations.halfWidths[i] = rects.width[i] / 2.f;
+      rotations.halfHeights[i] = rects.height[i] / 2.f;
+      rotations.cosines[i] = rotation.cosine;
+      rotations.sines[i] = rotation.sine;
+    }
+  }
+
+  static void areRectPairsInRangeIntersecting(
+      const RectangleBuffer& rects,
+      const RectRotations& rotations,
+      const eastl::vector<IndexPair>& pairs,
+      int32_t begin,
+      int32_t end,
+      uint64_t* hitMask)
+  {
+    // begin must be a multiple of 64, so that the words of the mask that this
+    // writes to are not shared with any other range.
+    eastl::fill(hitMask + (begin >> 6), hitMask + ((end + 63) >> 6),
+                uint64_t(0));
+
+    const float* centerXs = rects.x.data();
+    const float* centerYs = rects.y.data();
+    const float* halfWidths = rotations.halfWidths.data();
+    const float* halfHeights = rotations.halfHeights.data();
+    const float* cosines = rotations.cosines.data();
+    const float* sines = rotations.sines.data();
+    int32_t i = begin;
+
+#if defined(__SSE2__)
+    // Let's test four pairs at a time. Gathering the rectangle data of the
+    // pairs is still scalar, but everything after that is not.
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+    const __m128 tolerance = _mm_set1_ps(intervalTolerance);
+    for (; i + 4 <= end; i += 4) {
+      const IndexPair* p = &pairs[i];
+
+      // NOTE: _mm_set_ps() takes its arguments from the highest lane to the
+      //       lowest lane.
+#define COREX_MATH_GATHER(arr, member) _mm_set_ps(arr[p[3].member],           \
+                                                  arr[p[2].member],           \
+                                                  arr[p[1].member],           \
+                                                  arr[p[0].member])
+      __m128 centerX0 = COREX_MATH_GATHER(centerXs, first);
+      __m128 centerY0 = COREX_MATH_GATHER(centerYs, first);
+      __m128 halfWidth0 = COREX_MATH_GATHER(halfWidths, first);
+      __m128 halfHeight0 = COREX_MATH_GATHER(halfHeights, first);
+      __m128 cos0 = COREX_MATH_GATHER(cosines, first);
+      __m128 sin0 = COREX_MATH_GATHER(sines, first);
+      __m128 centerX1 = COREX_MATH_GATHER(centerXs, second);
+      __m128 centerY1 = COREX_MATH_GATHER(centerYs, second);
+      __m128 halfWidth1 = COREX_MATH_GATHER(halfWidths, second);
+      __m128 halfHeight1 = COREX_MATH_GATHER(halfHeights, second);
+      __m128 cos1 = COREX_MATH_GATHER(cosines, second);
+      __m128 sin1 = COREX_MATH_GATHER(sines, second);
+#undef COREX_MATH_GATHER
+
+      __m128 deltaX = _mm_sub_ps(centerX1, centerX0);
+      __m128 deltaY = _mm_sub_ps(centerY1, centerY0);
+      __m128 alignXX = _mm_and_ps(
+          _mm_add_ps(_mm_mul_ps(cos0, cos1), _mm_mul_ps(sin0, sin1)),
+          absMask);
+      __m128 alignXY = _mm_and_ps(
+          _mm_sub_ps(_mm_mul_ps(sin0, cos1), _mm_mul_ps(cos0, sin1)),
+          absMask);
+
+      __m128 distAxisX0 = _mm_and_ps(
+          _mm_add_ps(_mm_mul_ps(deltaX, cos0), _mm_mul_ps(deltaY, sin0)),
+          absMask);
+      __m128 distAxisY0 = _mm_and_ps(
+          _mm_sub_ps(_mm_mul_ps(deltaY, cos0), _mm_mul_ps(deltaX, sin0)),
+          absMask);
+      __m128 distAxisX1 = _mm_and_ps(
+          _mm_add_ps(_mm_mul_ps(deltaX, cos1), _mm_mul_ps(deltaY, sin1)),
+          absMask);
+      __m128 distAxisY1 = _mm_and_ps(
+          _mm_sub_ps(_mm_mul_ps(deltaY, cos1), _mm_mul_ps(deltaX, sin1)),
+          absMask);
+
+      __m128 radiusAxisX0 = _mm_add_ps(
+          _mm_add_ps(halfWidth0, _mm_mul_ps(halfWidth1, alignXX)),
+          _mm_add_ps(_mm_mul_ps(halfHeight1, alignXY), tolerance));
+      __m128 radiusAxisY0 = _mm_add_ps(
+          _mm_add_ps(halfHeight0, _mm_mul_ps(halfWidth1, alignXY)),
+          _mm_add_ps(_mm_mul_ps(halfHeight1, alignXX), tolerance));
+      __m128 radiusAxisX1 = _mm_add_ps(
+          _mm_add_ps(_mm_mul_ps(halfWidth0, alignXX),
+                     _mm_mul_ps(halfHeight0, alignXY)),
+          _mm_add_ps(halfWidth1, tolerance));
+      __m128 radiusAxisY1 = _mm_add_ps(
+          _mm_add_ps(_mm_mul_ps(halfWidth0, alignXY),
+                     _mm_mul_ps(halfHeight0, alignXX)),
+          _mm_add_ps(halfHeight1, tolerance));
+
+      __m128 isHit = _mm_and_ps(
+          _mm_and_ps(_mm_cmple_ps(distAxisX0, radiusAxisX0),
+                     _mm_cmple_ps(distAxisY0, radiusAxisY0)),
+          _mm_and_ps(_mm_cmple_ps(distAxisX1, radiusAxisX1),
+                     _mm_cmple_ps(distAxisY1, radiusAxisY1)));
+
+      // Pairs are processed four at a time starting from a multiple of four,
+      // so the four bits will always be in the same word.
+      uint64_t hitBits = static_cast<uint64_t>(_mm_movemask_ps(isHit));
+      hitMask[i >> 6] |= hitBits << (i & 63);
+    }
+#endif
+
+    for (; i < end; i++) {
+      if (areRectPairIntervalsOverlapping(centerXs, centerYs,
+                                          halfWidths, halfHeights,
+                                          cosines, sines,
+                                          pairs[i])) {
+        hitMask[i >> 6] |= uint64_t(1) << (i & 63);
+      }
+    }
+  }
+
+  void areRectPairsIntersecting(const RectangleBuffer& rects,
+                                const eastl::vector<IndexPair>& pairs,
+                                eastl::vector<uint64_t>& hitMask)
+  {
+    COREX_MATH_INSTRUMENT(areRectPairsIntersecting);
+    // SAT, but for a lot of rectangles at once. The rotation of each
+    // rectangle only gets computed once per batch, instead of several times
+    // for every pair that it is a part of.
+    int32_t numRects = static_cast<int32_t>(rects.x.size());
+    int32_t numPairs = static_cast<int32_t>(pairs.size());
+
+    RectRotations rotations;
+    resizeRectRotations(rotations, numRects);
+    computeRectRotations(rects, 0, numRects, rotations);
+
+    hitMask.resize((numPairs + 63) / 64);
+    areRectPairsInRangeIntersecting(rects, rotations, pairs, 0, numPairs,
+                                    hitMask.data());
+  }
+
+  void areRectPairsIntersecting(ThreadPool& pool,
+                                const RectangleBuffer& rects,
+                                const eastl::vector<IndexPair>& pairs,
+                                eastl::vector<uint64_t>& hitMask,
+                                int32_t chunkSize)
+  {
+    COREX_MATH_INSTRUMENT(areRectPairsIntersecting);
+    int32_t numRects = static_cast<int32_t>(rects.x.size());
+    int32_t numPairs = static_cast<int32_t>(pairs.size());
+    chunkSize = roundChunkSizeToMaskWords(chunkSize);
+
+    RectRotations rotations;
+    resizeRectRotations(rotations, numRects);
+    parallelFor(pool, numRects, chunkSize,
+                [&](int32_t begin, int32_t end, int32_t) {
+                  computeRectRotations(rects, begin, end, rotations);
+                });
+
+    hitMask.resize((numPairs + 63) / 64);
+    uint64_t* hitMaskData = hitMask.data();
+    parallelFor(pool, numPairs, chunkSize,
+                [&](int32_t begin, int32_t end, int32_t) {
+                  areRectPairsInRangeIntersecting(rects, rotations, pairs,
+                                                  begin, end, hitMaskData);
+                });
+  }
+
+  void clipRectPairs(ThreadPool& pool,
+                     const eastl::vector<Rectangle>& rects,
+                     const eastl::vector<IndexPair>& pairs,
+                     eastl::vector<FixedNPolygon<8>>& clippedPolygons,
+                     int32_t chunkSize)
+  {
+    COREX_MATH_INSTRUMENT(clipRectPairs);
+    clippedPolygons.resize(pairs.size());
+    parallelFor(pool, static_cast<int32_t>(pairs.size()), chunkSize,
+                [&](int32_t begin, int32_t end, int32_t) {
+                  for (int32_t i = begin; i < end; i++) {
+                    clippedPolygonFromTwoRects(rects[pairs[i].first],
+                                               rects[pairs[i].second],
+                                               clippedPolygons[i]);
+                  }
+                });
+  }
+
+  struct PolygonEdges
+  {
+    // The edges of a polygon, in the form that the point-in-polygon test
+    // uses, i.e. the start of each edge, the vector to its end, and its
+    // inverse slope.
+    eastl::vector<float> startXs;
+    eastl::vector<float> startYs;
+    eastl::vector<float> endYs;
+    eastl::vector<float> deltaXs;
+    eastl::vector<float> deltaYs;
+    eastl::vector<float> inverseSlopes;
+
+    // How far a point must be from the crossing of any edge computed from
+    // the inverse slope for it to be on the same side of the crossing
+    // computed like in isPointWithinNPolygon().
+    float maxCrossingError;
+  };
+
+  static void computePolygonEdges(const NPolygon& polygon,
+                                  PolygonEdges& edges)
+  {
+    // Edges are formed the same way isPointWithinNPolygon() forms them.
+    auto& vertices = polygon.vertices;
+    int32_t numVertices = static_cast<int32_t>(vertices.size());
+    edges.startXs.resize(numVertices);
+    edges.startYs.resize(numVertices);
+    edges.endYs.resize(numVertices);
+    edges.deltaXs.resize(numVertices);
+    edges.deltaYs.resize(numVertices);
+    edges.inverseSlopes.resize(numVertices);
+    edges.maxCrossingError = 0.f;
+    for (int32_t i = 0, j = numVertices - 1; i < numVertices; j = i++) {
+      const Point& start = vertices[i];
+      const Point& end = vertices[j];
+      edges.startXs[i] = start.x;
+      edges.startYs[i] = start.y;
+      edges.endYs[i] = end.y;
+      edges.deltaXs[i] = end.x - start.x;
+
+      // Horizontal edges never get crossed by the ray of the test, so their
+      // height never gets used. Let's just avoid dividing by zero.
+      edges.deltaYs[i] = (start.y == end.y) ? 1.f : end.y - start.y;
+      edges.inverseSlopes[i] = edges.deltaXs[i] / edges.deltaYs[i];
+
+      // The crossing from the inverse slope, and the one from dividing by
+      // the height of the edge, both round the product, the quotient and
+      // the sum once each, and the inverse slope is rounded once more. For a
+      // point the edge straddles, the product is at most about the width of
+      // the edge, which puts the two crossings within about 6 float epsilons
+      // of the width plus 2 of the start of the edge. This is a lot more
+      // than that, to be safe. The absolute term covers edges too close to
+      // zero for relative errors. An inverse slope that overflowed makes
+      // the error infinite, so that the crossings of the polygon are always
+      // computed like in isPointWithinNPolygon().
+      float maxCrossingError =
+          (((2.f * std::fabs(edges.deltaXs[i])) + std::fabs(start.x))
+           / (1 << 20))
+          + eastl::numeric_limits<float>::min();
+      if (!std::isfinite(edges.inverseSlopes[i])) {
+        maxCrossingError = eastl::numeric_limits<float>::infinity();
+      }
+
+      edges.maxCrossingError = eastl::max(edges.maxCrossingError,
+                                          maxCrossingError);
+    }
+  }
+
+  static bool isPointWithinPolygonEdges(float pointX,
+                                        float pointY,
+                                        const PolygonEdges& edges)
+  {
+    // The test of arePointsWithinPolygonEdges() for a single point.
+    bool isPointInside = false;
+    int32_t numEdges = static_cast<int32_t>(edges.startXs.size());
+    for (int32_t e = 0; e < numEdges; e++) {
+      float startX = edges.startXs[e];
+      float startY = edges.startYs[e];
+      if ((startY > pointY) == (edges.endYs[e] > pointY)) {
+        continue;
+      }
+
+      float offsetY = pointY - startY;
+      float crossingX = (edges.inverseSlopes[e] * offsetY) + startX;
+      if (!(std::fabs(pointX - crossingX) > edges.maxCrossingError)) {
+        crossingX = ((edges.deltaXs[e] * offsetY) / edges.deltaYs[e])
+                    + startX;
+      }
+
+      if (pointX < crossingX) {
+        isPointInside = !isPointInside;
+      }
+    }
+
+    return isPointInside;
+  }
+
+  static void arePointsWithinPolygonEdges(const float* pointXs,
+                                          const float* pointYs,
+                                          int32_t begin,
+                                          int32_t end,
+                                          const PolygonEdges& edges,
+                                          uint64_t* resultMask)
+  {
+    // This is the same crossing test as isPointWithinNPolygon(). The
+    // crossings are first computed with a multiplication by the inverse
+    // slope of the edge instead of a division. Points that are too close to
+    // one of them to be sure which side they are on are tested again with
+    // the crossings computed in the same order of operations as
+    // isPointWithinNPolygon(), so that both give the exact same results,
+    // even for points on an edge.
+    int32_t numEdges = static_cast<int32_t>(edges.startXs.size());
+    const float* startXs = edges.startXs.data();
+    const float* startYs = edges.startYs.data();
+    const float* endYs = edges.endYs.data();
+    const float* inverseSlopes = edges.inverseSlopes.data();
+
+    // Just like with the rectangle pairs, begin must be a multiple of 64.
+    eastl::fill(resultMask + (begin >> 6), resultMask + ((end + 63) >> 6),
+                uint64_t(0));
+
+    int32_t i = begin;
+
+#if defined(__SSE2__)
+    // Test eight points at a time against each edge, as two sets of four,
+    // so that the values of each edge are only loaded once for both. The
+    // comparisons are read off the sign bits of differences, e.g.
+    // startY > pointY when pointY - startY is negative, which is what
+    // _mm_movemask_ps() reads in the end. The points that are too close to
+    // a crossing are only collected across all edges, instead of being
+    // tested again right away.
+    //
+    // Adding zero to the y's turns -0 into 0, since -0 - 0 would be
+    // negative, even though 0 > -0 is false.
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+    const __m128 maxCrossingError = _mm_set1_ps(edges.maxCrossingError);
+    const __m128 zero = _mm_setzero_ps();
+    for (; i + 8 <= end; i += 8) {
+      __m128 pointXs0 = _mm_loadu_ps(pointXs + i);
+      __m128 pointYs0 = _mm_add_ps(_mm_loadu_ps(pointYs + i), zero);
+      __m128 pointXs1 = _mm_loadu_ps(pointXs + i + 4);
+      __m128 pointYs1 = _mm_add_ps(_mm_loadu_ps(pointYs + i + 4), zero);
+      __m128 isInside0 = _mm_setzero_ps();
+      __m128 isInside1 = _mm_setzero_ps();
+      __m128 isTooClose = _mm_setzero_ps();
+      for (int32_t e = 0; e < numEdges; e++) {
+        __m128 startX = _mm_set1_ps(startXs[e]);
+        __m128 startY = _mm_set1_ps(startYs[e]);
+        __m128 endY = _mm_set1_ps(endYs[e]);
+        __m128 inverseSlope = _mm_set1_ps(inverseSlopes[e]);
+
+        __m128 offsetYs0 = _mm_sub_ps(pointYs0, startY);
+        __m128 offsetYs1 = _mm_sub_ps(pointYs1, startY);
+        __m128 areEdgesStraddling0 = _mm_xor_ps(offsetYs0,
+                                                _mm_sub_ps(pointYs0, endY));
+        __m128 areEdgesStraddling1 = _mm_xor_ps(offsetYs1,
+                                                _mm_sub_ps(pointYs1, endY));
+        __m128 crossingDists0 = _mm_sub_ps(
+            pointXs0,
+            _mm_add_ps(_mm_mul_ps(inverseSlope, offsetYs0), startX));
+        __m128 crossingDists1 = _mm_sub_ps(
+            pointXs1,
+            _mm_add_ps(_mm_mul_ps(inverseSlope, offsetYs1), startX));
+        isInside0 = _mm_xor_ps(isInside0,
+                               _mm_and_ps(areEdgesStraddling0,
+                                          crossingDists0));
+        isInside1 = _mm_xor_ps(isInside1,
+                               _mm_and_ps(areEdgesStraddling1,
+                                          crossingDists1));
+
+        // Not greater, rather than less or equal, so that NaNs also count as
+        // too close.
+        isTooClose = _mm_or_ps(
+            isTooClose,
+            _mm_or_ps(
+                _mm_cmpngt_ps(_mm_and_ps(crossingDists0, absMask),
+                              maxCrossingError),
+                _mm_cmpngt_ps(_mm_and_ps(crossingDists1, absMask),
+                              maxCrossingError)));
+      }
+
+      // Points are processed eight at a time starting from a multiple of
+      // eight, so the eight bits will always be in the same word.
+      uint64_t insideBits = 0;
+      if (_mm_movemask_ps(isTooClose) == 0) {
+        insideBits = static_cast<uint64_t>(_mm_movemask_ps(isInside0))
+                     | (static_cast<uint64_t>(_mm_movemask_ps(isInside1))
+                        << 4);
+      } else {
+        for (int32_t j = 0; j < 8; j++) {
+          if (isPointWithinPolygonEdges(pointXs[i + j], pointYs[i + j],
+                                        edges)) {
+            insideBits |= uint64_t(1) << j;
+          }
+        }
+      }
+
+      resultMask[i >> 6] |= insideBits << (i & 63);
+    }
+#endif
+
+    for (; i < end; i++) {
+      if (isPointWithinPolygonEdges(pointXs[i], pointYs[i], edges)) {
+        resultMask[i >> 6] |= uint64_t(1) << (i & 63);
+      }
+    }
+  }
+
+  static void arePointsWithinPolygonEdges(const Point* points,
+                                          int32_t begin,
+                                          int32_t end,
+                                          const PolygonEdges& edges,
+                                          uint64_t* resultMask)
+  {
+    // The points get split into a structure of arrays in blocks, so that the
+    // kernel gets to load four consecutive x's and y's at a time without
+    // having to copy all of the points at once.
+    constexpr int32_t blockSize = 256;
+    float blockXs[blockSize];
+    float blockYs[blockSize];
+    uint64_t blockMask[blockSize / 64];
+
+    for (int32_t blockStart = begin; blockStart < end;
+         blockStart += blockSize) {
+      int32_t numBlockPoints = eastl::min(blockSize, end - blockStart);
+      for (int32_t i = 0; i < numBlockPoints; i++) {
+        blockXs[i] = points[blockStart + i].x;
+        blockYs[i] = points[blockStart + i].y;
+      }
+
+      arePointsWithinPolygonEdges(blockXs, blockYs, 0, numBlockPoints, edges,
+                                  blockMask);
+
+      // Blocks start at a multiple of 64, so their words can be copied as is.
+      int32_t numBlockWords = (numBlockPoints + 63) / 64;
+      for (int32_t w = 0; w < numBlockWords; w++) {
+        resultMask[(blockStart >> 6) + w] = blockMask[w];
+      }
+    }
+  }
+
+  void arePointsWithinNPolygon(const PointBuffer& points,
+                               const NPolygon& polygon,
+                               eastl::vector<uint64_t>& resultMask)
+  {
+    COREX_MATH_INSTRUMENT(arePointsWithinNPolygon);
+    PolygonEdges edges;
+    computePolygonEdges(polygon, edges);
+
+    int32_t numPoints = static_cast<int32_t>(points.x.size());
+    resultMask.resize((numPoints + 63) / 64);
+    arePointsWithinPolygonEdges(points.x.data(), points.y.data(),
+                                0, numPoints, edges, resultMask.data());
+  }
+
+  void arePointsWithinNPolygon(const eastl::vector<Point>& points,
+                               const NPolygon& polygon,
+                               eastl::vector<uint64_t>& resultMask)
+  {
+    COREX_MATH_INSTRUMENT(arePointsWithinNPolygon);
+    PolygonEdges edges;
+    computePolygonEdges(polygon, edges);
+
+    int32_t numPoints = static_cast<int32_t>(points.size());
+    resultMask.resize((numPoints + 63) / 64);
+    arePointsWithinPolygonEdges(points.data(), 0, numPoints, edges,
+                                resultMask.data());
+  }
+
+  void arePointsWithinNPolygon(ThreadPool& pool,
+                               const PointBuffer& points,
+                               const NPolygon& polygon,
+                               eastl::vector<uint64_t>& resultMask,
+                               int32_t chunkSize)
+  {
+    COREX_MATH_INSTRUMENT(arePointsWithinNPolygon);
+    PolygonEdges edges;
+    computePolygonEdges(polygon, edges);
+
+    int32_t numPoints = static_cast<int32_t>(points.x.size());
+    resultMask.resize((numPoints + 63) / 64);
+    const float* pointXs = points.x.data();
+    const float* pointYs = points.y.data();
+    uint64_t* resultMaskData = resultMask.data();
+    parallelFor(pool, numPoints, roundChunkSizeToMaskWords(chunkSize),
+                [&](int32_t begin, int32_t end, int32_t) {
+                  arePointsWithinPolygonEdges(pointXs, pointYs, begin, end,
+                                              edges, resultMaskData);
+                });
+  }
+
+  void arePointsWithinNPolygon(ThreadPool& pool,
+                               const eastl::vector<Point>& points,
+                               const NPolygon& polygon,
+                               eastl::vector<uint64_t>& resultMask,
+                               int32_t chunkSize)
+  {
+    COREX_MATH_INSTRUMENT(arePointsWithinNPolygon);
+    PolygonEdges edges;
+    computePolygonEdges(polygon, edges);
+
+    int32_t numPoints = static_cast<int32_t>(points.size());
+    resultMask.resize((numPoints + 63) / 64);
+    uint64_t* resultMaskData = resultMask.data();
+    parallelFor(pool, numPoints, roundChunkSizeToMaskWords(chunkSize),
+                [&](int32_t begin, int32_t end, int32_t) {
+                  arePointsWithinPolygonEdges(points.data(), begin, end,
+                                              edges, resultMaskData);
+                });
+  }
+
+  void getPolygonAreas(ThreadPool& pool,
+                       const eastl::vector<NPolygon>& polygons,
+                       eastl::vector<double>& areas,
+                       int32_t chunkSize)
+  {
+    COREX_MATH_INSTRUMENT(getPolygonAreas);
+    areas.resize(polygons.size());
+    parallelFor(pool, static_cast<int32_t>(polygons.size()), chunkSize,
+                [&](int32_t begin, int32_t end, int32_t) {
+                  for (int32_t i = begin; i < end; i++) {
+                    areas[i] = getPolygonArea(polygons[i]);
+                  }
+                });
+  }
+
+  void getPolygonCentroids(ThreadPool& pool,
+                           const eastl::vector<NPolygon>& polygons,
+                           eastl::vector<Point>& centroids,
+                           int32_t chunkSize)
+  {
+    COREX_MATH_INSTRUMENT(getPolygonCentroids);
+    centroids.resize(polygons.size());
+    parallelFor(pool, static_cast<int32_t>(polygons.size()), chunkSize,
+                [&](int32_t begin, int32_t end, int32_t) {
+                  for (int32_t i = begin; i < end; i++) {
+                    centroids[i] = getPolygonCentroid(polygons[i]);
+                  }
+                });
+  }
+
+  static PolygonProperties getBufferPolygonProperties(const float* xs,
+                                                      const float* ys,
+                                                      int32_t numVertices)
+  {
+    // The same sums as getPolygonProperties(), over vertices relative to the
+    // first one, so that the edges touching it drop out and no edge wraps
+    // around. The vertices are converted to doubles before anything else,
+    // so that the results only differ from getPolygonProperties() by the
+    // order the sums are added up in.
+    if (numVertices == 0) {
+      return PolygonProperties{ 0.0, PolygonWinding::DEGENERATE, Point{} };
+    }
+
+    double originX = xs[0];
+    double originY = ys[0];
+    double doubleArea = 0.0;
+    double centroidX = 0.0;
+    double centroidY = 0.0;
+    int32_t i = 1;
+
+#if defined(__SSE2__)
+    // Four edges at a time, as two pairs of doubles.
+    const __m128d vecOriginX = _mm_set1_pd(originX);
+    const __m128d vecOriginY = _mm_set1_pd(originY);
+    __m128d doubleAreas = _mm_setzero_pd();
+    __m128d centroidXs = _mm_setzero_pd();
+    __m128d centroidYs = _mm_setzero_pd();
+    for (; i + 4 < numVertices; i += 4) {
+      __m128 startX = _mm_loadu_ps(xs + i);
+      __m128 startY = _mm_loadu_ps(ys + i);
+      __m128 endX = _mm_loadu_ps(xs + i + 1);
+      __m128 endY = _mm_loadu_ps(ys + i + 1);
+      const __m128 halves[2][4] = {
+        { startX, startY, endX, endY },
+        {
+          _mm_movehl_ps(startX, startX),
+          _mm_movehl_ps(startY, startY),
+          _mm_movehl_ps(endX, endX),
+          _mm_movehl_ps(endY, endY)
+        }
+      };
+
+      for (const __m128* half : halves) {
+        __m128d x0 = _mm_sub_pd(_mm_cvtps_pd(half[0]), vecOriginX);
+        __m128d y0 = _mm_sub_pd(_mm_cvtps_pd(half[1]), vecOriginY);
+        __m128d x1 = _mm_sub_pd(_mm_cvtps_pd(half[2]), vecOriginX);
+        __m128d y1 = _mm_sub_pd(_mm_cvtps_pd(half[3]), vecOriginY);
+        __m128d cross = _mm_sub_pd(_mm_mul_pd(x0, y1), _mm_mul_pd(x1, y0));
+        doubleAreas = _mm_add_pd(doubleAreas, cross);
+        centroidXs = _mm_add_pd(centroidXs,
+                                _mm_mul_pd(_mm_add_pd(x0, x1), cross));
+        centroidYs = _mm_add_pd(centroidYs,
+                                _mm_mul_pd(_mm_add_pd(y0, y1), cross));
+      }
+    }
+
+    doubleArea = _mm_cvtsd_f64(
+      _mm_add_sd(doubleAreas, _mm_unpackhi_pd(doubleAreas, doubleAreas)));
+    centroidX = _mm_cvtsd_f64(
+      _mm_add_sd(centroidXs, _mm_unpackhi_pd(centroidXs, centroidXs)));
+    centroidY = _mm_cvtsd_f64(
+      _mm_add_sd(centroidYs, _mm_unpackhi_pd(centroidYs, centroidYs)));
+#endif
+
+    for (; i < numVertices - 1; i++) {
+      double x0 = xs[i] - originX;
+      double y0 = ys[i] - originY;
+      double x1 = xs[i + 1] - originX;
+      double y1 = ys[i + 1] - originY;
+      double cross = (x0 * y1) - (x1 * y0);
+      doubleArea += cross;
+      centroidX += (x0 + x1) * cross;
+      centroidY += (y0 + y1) * cross;
+    }
+
+    if (doubleArea == 0.0) {
+      double sumX = 0.0;
+      double sumY = 0.0;
+      for (int32_t v = 0; v < numVertices; v++) {
+        sumX += xs[v];
+        sumY += ys[v];
+      }
+
+      return PolygonProperties{
+        0.0,
+        PolygonWinding::DEGENERATE,
+        Point{
+          static_cast<float>(sumX / numVertices),
+          static_cast<float>(sumY / numVertices)
+        }
+      };
+    }
+
+    return PolygonProperties{
+      doubleArea / 2.0,
+      (doubleArea > 0.0) ? PolygonWinding::CLOCKWISE
+                         : PolygonWinding::COUNTERCLOCKWISE,
+      Point{
+        static_cast<float>(originX + (centroidX / (3.0 * doubleArea))),
+        static_cast<float>(originY + (centroidY / (3.0 * doubleArea)))
+      }
+    };
+  }
+
+  void getPolygonBufferProperties(const PolygonBuffer& polygons,
+                                  eastl::vector<PolygonProperties>& properties)
+  {
+    COREX_MATH_INSTRUMENT(getPolygonBufferProperties);
+    int32_t numPolygons = eastl::max(
+      static_cast<int32_t>(polygons.offsets.size()) - 1, 0);
+    properties.resize(numPolygons);
+    for (int32_t i = 0; i < numPolygons; i++) {
+      int32_t offset = polygons.offsets[i];
+      properties[i] = getBufferPolygonProperties(
+        polygons.x.data() + offset,
+        polygons.y.data() + offset,
+        polygons.offsets[i + 1] - offset);
+    }
+  }
+
+  void getPolygonBufferProperties(ThreadPool& pool,
+                                  const PolygonBuffer& polygons,
+                                  eastl::vector<PolygonProperties>& properties,
+                                  int32_t chunkSize)
+  {
+    COREX_MATH_INSTRUMENT(getPolygonBufferProperties);
+    int32_t numPolygons = eastl::max(
+      static_cast<int32_t>(polygons.offsets.size()) - 1, 0);
+    properties.resize(numPolygons);
+    parallelFor(pool, numPolygons, chunkSize,
+                [&](int32_t begin, int32_t end, int32_t) {
+                  for (int32_t i = begin; i < end; i++) {
+                    int32_t offset = polygons.offsets[i];
+                    properties[i] = getBufferPolygonProperties(
+                      polygons.x.data() + offset,
+                      polygons.y.data() + offset,
+                      polygons.offsets[i + 1] - offset);
+                  }
+                });
+  }
+
+  void areCirclePairsIntersecting(const CircleBuffer& circles,
+                                  const eastl::vector<IndexPair>& pairs,
+                                  eastl::vector<uint64_t>& hitMask)
+  {
+    COREX_MATH_INSTRUMENT(areCirclePairsIntersecting);
+    int32_t numPairs = static_cast<int32_t>(pairs.size());
+    hitMask.assign((numPairs + 63) / 64, 0);
+
+    const float* centerXs = circles.x.data();
+    const float* centerYs = circles.y.data();
+    const float* radii = circles.radius.data();
+    int32_t i = 0;
+
+#if defined(__SSE2__)
+    for (; i + 4 <= numPairs; i += 4) {
+      const IndexPair* p = &pairs[i];
+#define COREX_MATH_GATHER(arr, member) _mm_set_ps(arr[p[3].member],           \
+                                                  arr[p[2].member],           \
+                                                  arr[p[1].member],           \
+                                                  arr[p[0].member])
+      __m128 deltaX = _mm_sub_ps(COREX_MATH_GATHER(centerXs, second),
+                                 COREX_MATH_GATHER(centerXs, first));
+      __m128 deltaY = _mm_sub_ps(COREX_MATH_GATHER(centerYs, second),
+                                 COREX_MATH_GATHER(centerYs, first));
+      __m128 radiusSum = _mm_add_ps(COREX_MATH_GATHER(radii, first),
+                                    COREX_MATH_GATHER(radii, second));
+#undef COREX_MATH_GATHER
+
+      __m128 squaredDist = _mm_add_ps(_mm_mul_ps(deltaX, deltaX),
+                                      _mm_mul_ps(deltaY, deltaY));
+      __m128 isHit = _mm_cmple_ps(squaredDist,
+                                  _mm_mul_ps(radiusSum, radiusSum));
+      uint64_t hitBits = static_cast<uint64_t>(_mm_movemask_ps(isHit));
+      hitMask[i >> 6] |= hitBits << (i & 63);
+    }
+#endif
+
+    for (; i < numPairs; i++) {
+      int32_t a = pairs[i].first;
+      int32_t b = pairs[i].second;
+      float deltaX = centerXs[b] - centerXs[a];
+      float deltaY = centerYs[b] - centerYs[a];
+      float radiusSum = radii[a] + radii[b];
+      if (((deltaX * deltaX) + (deltaY * deltaY)) <= (radiusSum * radiusSum)) {
+        hitMask[i >> 6] |= uint64_t(1) << (i & 63);
+      }
+    }
+  }
+
+  void areCirclesIntersectingRects(const CircleBuffer& circles,
+                                   const RectangleBuffer& rects,
+                                   const eastl::vector<IndexPair>& pairs,
+                                   eastl::vector<uint64_t>& hitMask)
+  {
+    COREX_MATH_INSTRUMENT(areCirclesIntersectingRects);
+    // Same as isCircleIntersectingRect(), with the rotation of each rectangle
+    // computed once per batch, like in areRectPairsIntersecting().
+    int32_t numRects = static_cast<int32_t>(rects.x.size());
+    int32_t numPairs = static_cast<int32_t>(pairs.size());
+
+    RectRotations rotations;
+    resizeRectRotations(rotations, numRects);
+    computeRectRotations(rects, 0, numRects, rotations);
+
+    hitMask.assign((numPairs + 63) / 64, 0);
+
+    const float* circleXs = circles.x.data();
+    const float* circleYs = circles.y.data();
+    const float* radii = circles.radius.data();
+    const float* rectXs = rects.x.data();
+    const float* rectYs = rects.y.data();
+    const float* halfWidths = rotations.halfWidths.data();
+    const float* halfHeights = rotations.halfHeights.data();
+    const float* cosines = rotations.cosines.data();
+    const float* sines = rotations.sines.data();
+    int32_t i = 0;
+
+#if defined(__SSE2__)
+    const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+    const __m128 zero = _mm_setzero_ps();
+    for (; i + 4 <= numPairs; i += 4) {
+      const IndexPair* p = &pairs[i];
+#define COREX_MATH_GATHER(arr, member) _mm_set_ps(arr[p[3].member],           \
+                                                  arr[p[2].member],           \
+                                                  arr[p[1].member],           \
+                                                  arr[p[0].member])
+      __m128 deltaX = _mm_sub_ps(COREX_MATH_GATHER(circleXs, first),
+                                 COREX_MATH_GATHER(rectXs, second));
+      __m128 deltaY = _mm_sub_ps(COREX_MATH_GATHER(circleYs, first),
+                                 COREX_MATH_GATHER(rectYs, second));
+      __m128 radius = COREX_MATH_GATHER(radii, first);
+      __m128 halfWidth = COREX_MATH_GATHER(halfWidths, second);
+      __m128 halfHeight = COREX_MATH_GATHER(halfHeights, second);
+      __m128 cosine = COREX_MATH_GATHER(cosines, second);
+      __m128 sine = COREX_MATH_GATHER(sines, second);
+#undef COREX_MATH_GATHER
+
+      __m128 localX = _mm_add_ps(_mm_mul_ps(deltaX, cosine),
+                                 _mm_mul_ps(deltaY, sine));
+      __m128 localY = _mm_sub_ps(_mm_mul_ps(deltaY, cosine),
+                                 _mm_mul_ps(deltaX, sine));
+      __m128 outsideX = _mm_max_ps(
+        _mm_sub_ps(_mm_and_ps(localX, absMask), halfWidth), zero);
+      __m128 outsideY = _mm_max_ps(
+        _mm_sub_ps(_mm_and_ps(localY, absMask), halfHeight), zero);
+      __m128 squaredDist = _mm_add_ps(_mm_mul_ps(outsideX, outsideX),
+                                      _mm_mul_ps(outsideY, outsideY));
+      __m128 isHit = _mm_cmple_ps(squaredDist, _mm_mul_ps(radius, radius));
+      uint64_t hitBits = static_cast<uint64_t>(_mm_movemask_ps(isHit));
+      hitMask[i >> 6] |= hitBits << (i & 63);
+    }
+#endif
+
+    for (; i < numPairs; i++) {
+      int32_t c = pairs[i].first;
+      int32_t r = pairs[i].second;
+      float deltaX = circleXs[c] - rectXs[r];
+      float deltaY = circleYs[c] - rectYs[r];
+      float localX = (deltaX * cosines[r]) + (deltaY * sines[r]);
+      float localY = (deltaY * cosines[r]) - (deltaX * sines[r]);
+      float outsideX = eastl::max(std::fabs(localX) - halfWidths[r], 0.f);
+      float outsideY = eastl::max(std::fabs(localY) - halfHeights[r], 0.f);
+      if (((outsideX * outsideX) + (outsideY * outsideY))
+          <= (radii[c] * radii[c])) {
+        hitMask[i >> 6] |= uint64_t(1) << (i & 63);
+      }
+    }
+  }
+
+  void areCirclesIntersectingNPolygon(const CircleBuffer& circles,
+                                      const NPolygon& polygon,
+                                      eastl::vector<uint64_t>& resultMask)
+  {
+    COREX_MATH_INSTRUMENT(areCirclesIntersectingNPolygon);
+    // A circle intersects the polygon if its center is inside the polygon,
+    // which uses the same crossing test as arePointsWithinNPolygon(), or if
+    // it is close enough to one of the edges.
+    int32_t numCircles = static_cast<int32_t>(circles.x.size());
+    resultMask.resize((numCircles + 63) / 64);
+    if (polygon.vertices.empty()) {
+      eastl::fill(resultMask.begin(), resultMask.end(), uint64_t(0));
+      return;
+    }
+
+    PolygonEdges edges;
+    computePolygonEdges(polygon, edges);
+    arePointsWithinPolygonEdges(circles.x.data(), circles.y.data(),
+                                0, numCircles, edges, resultMask.data());
+
+    // The vector of each edge, and the inverse of its squared length, for
+    // finding the point of an edge that is closest to a circle.
+    int32_t numEdges = static_cast<int32_t>(edges.startXs.size());
+    eastl::vector<float> edgeXs(numEdges);
+    eastl::vector<float> edgeYs(numEdges);
+    eastl::vector<float> inverseSquaredLengths(numEdges);
+    for (int32_t e = 0, prev = numEdges - 1; e < numEdges; prev = e++) {
+      edgeXs[e] = polygon.vertices[prev].x - edges.startXs[e];
+      edgeYs[e] = polygon.vertices[prev].y - edges.startYs[e];
+      float squaredLength = (edgeXs[e] * edgeXs[e]) + (edgeYs[e] * edgeYs[e]);
+
+      // Degenerate edges are just their start point.
+      inverseSquaredLengths[e] = (squaredLength > 0.f)
+                                 ? 1.f / squaredLength
+                                 : 0.f;
+    }
+
+    const float* centerXs = circles.x.data();
+    const float* centerYs = circles.y.data();
+    const float* radii = circles.radius.data();
+    const float* startXs = edges.startXs.data();
+    const float* startYs = edges.startYs.data();
+    int32_t i = 0;
+
+#if defined(__SSE2__)
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.f);
+    for (; i + 4 <= numCircles; i += 4) {
+      __m128 centerX = _mm_loadu_ps(centerXs + i);
+      __m128 centerY = _mm_loadu_ps(centerYs + i);
+      __m128 radius = _mm_loadu_ps(radii + i);
+      __m128 minSquaredDist = _mm_set1_ps(
+        eastl::numeric_limits<float>::max());
+      for (int32_t e = 0; e < numEdges; e++) {
+        __m128 edgeX = _mm_set1_ps(edgeXs[e]);
+        __m128 edgeY = _mm_set1_ps(edgeYs[e]);
+        __m128 deltaX = _mm_sub_ps(centerX, _mm_set1_ps(startXs[e]));
+        __m128 deltaY = _mm_sub_ps(centerY, _mm_set1_ps(startYs[e]));
+        __m128 t = _mm_mul_ps(
+          _mm_add_ps(_mm_mul_ps(deltaX, edgeX), _mm_mul_ps(deltaY, edgeY)),
+          _mm_set1_ps(inverseSquaredLengths[e]));
+        t = _mm_min_ps(_mm_max_ps(t, zero), one);
+        __m128 offsetX = _mm_sub_ps(deltaX, _mm_mul_ps(t, edgeX));
+        __m128 offsetY = _mm_sub_ps(deltaY, _mm_mul_ps(t, edgeY));
+        minSquaredDist = _mm_min_ps(
+          minSquaredDist,
+          _mm_add_ps(_mm_mul_ps(offsetX, offsetX),
+                     _mm_mul_ps(offsetY, offsetY)));
+      }
+
+      __m128 isHit = _mm_cmple_ps(minSquaredDist, _mm_mul_ps(radius, radius));
+      uint64_t hitBits = static_cast<uint64_t>(_mm_movemask_ps(isHit));
+      resultMask[i >> 6] |= hitBits << (i & 63);
+    }
+#endif
+
+    for (; i < numCircles; i++) {
+      float minSquaredDist = eastl::numeric_limits<float>::max();
+      for (int32_t e = 0; e < numEdges; e++) {
+        float deltaX = centerXs[i] - startXs[e];
+        float deltaY = centerYs[i] - startYs[e];
+        float t = eastl::clamp(((deltaX * edgeXs[e]) + (deltaY * edgeYs[e]))
+                                 * inverseSquaredLengths[e],
+                               0.f, 1.f);
+        float offsetX = deltaX - (t * edgeXs[e]);
+        float offsetY = deltaY - (t * edgeYs[e]);
+        minSquaredDist = eastl::min(minSquaredDist,
+                                    (offsetX * offsetX) + (offsetY * offsetY));
+      }
+
+      if (minSquaredDist <= (radii[i] * radii[i])) {
+        resultMask[i >> 6] |= uint64_t(1) << (i & 63);
+      }
+    }
+  }
+
+  static int32_t roundChunkSizeToMaskWords(int32_t chunkSize)
+  {
+    // Chunks that write to a bit mask must cover whole words of it, or
+    // threads would be writing to the same words.
+    return eastl::max(((chunkSize + 63) / 64) * 64, 64);
+  }
+}
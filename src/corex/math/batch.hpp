@@ -0,0 +1,99 @@
+#ifndef COREX_MATH_BATCH_HPP
+#define COREX_MATH_BATCH_HPP
+
+#include <cstdint>
+
+#include <EASTL/vector.h>
+
+#include <corex/math/ds.hpp>
+#include <corex/math/parallel.hpp>
+
+namespace cx
+{
+  // Batch functions write their per-element results into bit masks, where
+  // the result of the i-th element is stored in bit (i % 64) of word (i / 64).
+  inline bool isMaskBitSet(const eastl::vector<uint64_t>& mask, int32_t index)
+  {
+    return ((mask[index >> 6] >> (index & 63)) & 1u) != 0;
+  }
+
+  // Like areTwoRectsIntersecting(), rectangles that are just touching each
+  // other are intersecting. Both allow a small tolerance for that, but they
+  // round differently, so their results may differ for pairs that are apart,
+  // or overlap, by less than about 1e-4 plus a millionth of the largest
+  // coordinate of the pair. Results are the same for all other pairs.
+  void areRectPairsIntersecting(const RectangleBuffer& rects,
+                                const eastl::vector<IndexPair>& pairs,
+                                eastl::vector<uint64_t>& hitMask);
+  void arePointsWithinNPolygon(const PointBuffer& points,
+                               const NPolygon& polygon,
+                               eastl::vector<uint64_t>& resultMask);
+  void arePointsWithinNPolygon(const eastl::vector<Point>& points,
+                               const NPolygon& polygon,
+                               eastl::vector<uint64_t>& resultMask);
+
+  // Batch versions of the circle tests in geometry.hpp. For the pairs of
+  // areCirclesIntersectingRects(), first is the index of a circle, and second
+  // is the index of a rectangle.
+  void areCirclePairsIntersecting(const CircleBuffer& circles,
+                                  const eastl::vector<IndexPair>& pairs,
+                                  eastl::vector<uint64_t>& hitMask);
+  void areCirclesIntersectingRects(const CircleBuffer& circles,
+                                   const RectangleBuffer& rects,
+                                   const eastl::vector<IndexPair>& pairs,
+                                   eastl::vector<uint64_t>& hitMask);
+  void areCirclesIntersectingNPolygon(const CircleBuffer& circles,
+                                      const NPolygon& polygon,
+                                      eastl::vector<uint64_t>& resultMask);
+
+  // Batch version of getPolygonProperties(), which stores the properties of
+  // the i-th polygon in properties[i].
+  void getPolygonBufferProperties(const PolygonBuffer& polygons,
+                                  eastl::vector<PolygonProperties>& properties);
+
+  // Parallel versions, which split the batch into chunks of about chunkSize
+  // elements and run them on the threads of the pool. The output is the same
+  // as the output of the serial versions, no matter how many threads there
+  // are or which thread ran which chunk. Chunks of functions that write to a
+  // bit mask are rounded up to a multiple of 64 elements, so that no two
+  // threads ever write to the same word.
+  //
+  // A few thousand elements per chunk is a good start. Smaller chunks balance
+  // the load better when elements take uneven amounts of time, e.g. clipping
+  // pairs that mostly don't overlap, but bigger chunks mean less time spent
+  // handing chunks out.
+  void areRectPairsIntersecting(ThreadPool& pool,
+                                const RectangleBuffer& rects,
+                                const eastl::vector<IndexPair>& pairs,
+                                eastl::vector<uint64_t>& hitMask,
+                                int32_t chunkSize);
+  void clipRectPairs(ThreadPool& pool,
+                     const eastl::vector<Rectangle>& rects,
+                     const eastl::vector<IndexPair>& pairs,
+                     eastl::vector<FixedNPolygon<8>>& clippedPolygons,
+                     int32_t chunkSize);
+  void arePointsWithinNPolygon(ThreadPool& pool,
+                               const PointBuffer& points,
+                               const NPolygon& polygon,
+                               eastl::vector<uint64_t>& resultMask,
+                               int32_t chunkSize);
+  void arePointsWithinNPolygon(ThreadPool& pool,
+                               const eastl::vector<Point>& points,
+                               const NPolygon& polygon,
+                               eastl::vector<uint64_t>& resultMask,
+                               int32_t chunkSize);
+  void getPolygonAreas(ThreadPool& pool,
+                       const eastl::vector<NPolygon>& polygons,
+                       eastl::vector<double>& areas,
+                       int32_t chunkSize);
+  void getPolygonCentroids(ThreadPool& pool,
+                           const eastl::vector<NPolygon>& polygons,
+                           eastl::vector<Point>& centroids,
+                           int32_t chunkSize);
+  void getPolygonBufferProperties(ThreadPool& pool,
+                                  const PolygonBuffer& polygons,
+                                  eastl::vector<PolygonProperties>& properties,
+                                  int32_t chunkSize);
+}
+
+#endif
@@ -0,0 +1,847 @@
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+
+#include <EASTL/algorithm.h>
+#include <EASTL/fixed_vector.h>
+#include <EASTL/vector.h>
+
+#include <corex/math/broadphase.hpp>
+#include <corex/math/ds.hpp>
+#include <corex/math/geometry.hpp>
+#include <corex/math/instrumentation.hpp>
+
+namespace cx
+{
+  // An inclusive range of cells. Ranges with a min greater than their max
+  // have no cells.
+  struct GridCellRange
+  {
+    int32_t minCellX;
+    int32_t minCellY;
+    int32_t maxCellX;
+    int32_t maxCellY;
+  };
+
+  static constexpr GridCellRange emptyGridCellRange{ 0, 0, -1, -1 };
+
+  static uint64_t gridCellKey(int32_t cellX, int32_t cellY)
+  {
+    // The x index goes in the upper half of the key, and the y index in the
+    // lower half.
+    return (static_cast<uint64_t>(static_cast<uint32_t>(cellX)) << 32)
+           | static_cast<uint64_t>(static_cast<uint32_t>(cellY));
+  }
+
+  static uint64_t getGridCellKeyHash(uint64_t cellKey)
+  {
+    // The finalizer of MurmurHash3. Keys of nearby cells only differ in a few
+    // bits, which this spreads over all of them.
+    cellKey ^= cellKey >> 33;
+    cellKey *= 0xff51afd7ed558ccdull;
+    cellKey ^= cellKey >> 33;
+    cellKey *= 0xc4ceb9fe1a85ec53ull;
+    cellKey ^= cellKey >> 33;
+    return cellKey;
+  }
+
+  // The table is grown once it would get more than 3/4 full.
+  static bool isGridCellTableTooFull(int32_t numCells, int32_t numSlots)
+  {
+    return static_cast<int64_t>(numCells) * 4
+           > static_cast<int64_t>(numSlots) * 3;
+  }
+
+  static int32_t findGridCellSlot(const UniformGrid& grid, uint64_t cellKey)
+  {
+    // Returns the slot of the cell if it is in the table, or the empty slot
+    // it would go in otherwise. -1 if the table has no slots.
+    auto numSlots = static_cast<int32_t>(grid.cells.size());
+    if (numSlots == 0) {
+      return -1;
+    }
+
+    int32_t mask = numSlots - 1;
+    auto slot = static_cast<int32_t>(getGridCellKeyHash(cellKey) & mask);
+    while (grid.cells[slot].firstEntryID != -1
+           && grid.cells[slot].cellKey != cellKey) {
+      slot = (slot + 1) & mask;
+    }
+
+    return slot;
+  }
+
+  static void resizeGridCellTable(UniformGrid& grid, int32_t numSlots)
+  {
+    eastl::vector<GridCell> oldCells;
+    oldCells.swap(grid.cells);
+    grid.cells.resize(numSlots, GridCell{ 0, -1 });
+    for (const GridCell& cell : oldCells) {
+      if (cell.firstEntryID != -1) {
+        grid.cells[findGridCellSlot(grid, cell.cellKey)] = cell;
+      }
+    }
+  }
+
+  static int32_t addGridCell(UniformGrid& grid, uint64_t cellKey)
+  {
+    // Returns the slot of the cell, with a first entry ID of -1 if it was
+    // not occupied yet.
+    int32_t slot = findGridCellSlot(grid, cellKey);
+    if (slot < 0 || grid.cells[slot].firstEntryID == -1) {
+      auto numSlots = static_cast<int32_t>(grid.cells.size());
+      if (numSlots == 0 || isGridCellTableTooFull(grid.numCells + 1,
+                                                  numSlots)) {
+        resizeGridCellTable(grid, numSlots == 0 ? 16 : numSlots * 2);
+        slot = findGridCellSlot(grid, cellKey);
+      }
+
+      grid.cells[slot].cellKey = cellKey;
+      grid.numCells++;
+    }
+
+    return slot;
+  }
+
+  static void removeGridCell(UniformGrid& grid, int32_t slot)
+  {
+    // Backward shift deletion, like in removeSeparatingAxisCacheSlot(), since
+    // cells get emptied and occupied all the time as shapes move.
+    auto numSlots = static_cast<int32_t>(grid.cells.size());
+    int32_t mask = numSlots - 1;
+    int32_t hole = slot;
+    int32_t next = (hole + 1) & mask;
+    while (grid.cells[next].firstEntryID != -1) {
+      auto homeSlot = static_cast<int32_t>(
+          getGridCellKeyHash(grid.cells[next].cellKey) & mask);
+      if (((next - homeSlot) & mask) >= ((next - hole) & mask)) {
+        grid.cells[hole] = grid.cells[next];
+        hole = next;
+      }
+
+      next = (next + 1) & mask;
+    }
+
+    grid.cells[hole].firstEntryID = -1;
+    grid.numCells--;
+  }
+
+  static int32_t gridCellIndex(const UniformGrid& grid, float coordinate)
+  {
+    return static_cast<int32_t>(std::floor(coordinate / grid.cellSize));
+  }
+
+  static GridCellRange getGridCellRange(const UniformGrid& grid,
+                                        const AABB& bounds)
+  {
+    return GridCellRange{
+        gridCellIndex(grid, bounds.minX),
+        gridCellIndex(grid, bounds.minY),
+        gridCellIndex(grid, bounds.maxX),
+        gridCellIndex(grid, bounds.maxY)
+    };
+  }
+
+  static GridCellRange getGridProxyCellRange(const GridProxy& proxy)
+  {
+    return GridCellRange{
+        proxy.minCellX, proxy.minCellY, proxy.maxCellX, proxy.maxCellY
+    };
+  }
+
+  static void setGridProxyCellRange(GridProxy& proxy,
+                                    const GridCellRange& range)
+  {
+    proxy.minCellX = range.minCellX;
+    proxy.minCellY = range.minCellY;
+    proxy.maxCellX = range.maxCellX;
+    proxy.maxCellY = range.maxCellY;
+  }
+
+  static bool isCellInRange(int32_t cellX,
+                            int32_t cellY,
+                            const GridCellRange& range)
+  {
+    return cellX >= range.minCellX && cellX <= range.maxCellX
+           && cellY >= range.minCellY && cellY <= range.maxCellY;
+  }
+
+  static void addGridCellEntries(UniformGrid& grid,
+                                 int32_t proxyID,
+                                 const GridCellRange& cells,
+                                 const GridCellRange& skippedCells)
+  {
+    // New entries go at the front of the list of their cell.
+    for (int32_t cellX = cells.minCellX; cellX <= cells.maxCellX; cellX++) {
+      for (int32_t cellY = cells.minCellY;
+           cellY <= cells.maxCellY;
+           cellY++) {
+        if (isCellInRange(cellX, cellY, skippedCells)) {
+          continue;
+        }
+
+        int32_t entryID;
+        if (grid.freeCellEntryIDs.empty()) {
+          entryID = static_cast<int32_t>(grid.cellEntries.size());
+          grid.cellEntries.push_back(GridCellEntry{});
+        } else {
+          entryID = grid.freeCellEntryIDs.back();
+          grid.freeCellEntryIDs.pop_back();
+        }
+
+        GridCell& cell = grid.cells[addGridCell(grid,
+                                                gridCellKey(cellX, cellY))];
+        grid.cellEntries[entryID] = GridCellEntry{ proxyID,
+                                                   cell.firstEntryID };
+        cell.firstEntryID = entryID;
+      }
+    }
+  }
+
+  static void removeGridCellEntries(UniformGrid& grid,
+                                    int32_t proxyID,
+                                    const GridCellRange& cells,
+                                    const GridCellRange& skippedCells)
+  {
+    // Cells only have a few proxies each, when the cell size suits the
+    // shapes, so the entry of the proxy is found by walking its cell's list.
+    for (int32_t cellX = cells.minCellX; cellX <= cells.maxCellX; cellX++) {
+      for (int32_t cellY = cells.minCellY;
+           cellY <= cells.maxCellY;
+           cellY++) {
+        if (isCellInRange(cellX, cellY, skippedCells)) {
+          continue;
+        }
+
+        int32_t slot = findGridCellSlot(grid, gridCellKey(cellX, cellY));
+        assert(slot != -1 && grid.cells[slot].firstEntryID != -1);
+
+        int32_t* link = &grid.cells[slot].firstEntryID;
+        while (grid.cellEntries[*link].proxyID != proxyID) {
+          link = &grid.cellEntries[*link].nextEntryID;
+          assert(*link != -1);
+        }
+
+        int32_t entryID = *link;
+        *link = grid.cellEntries[entryID].nextEntryID;
+        grid.freeCellEntryIDs.push_back(entryID);
+        if (grid.cells[slot].firstEntryID == -1) {
+          removeGridCell(grid, slot);
+        }
+      }
+    }
+  }
+
+  int32_t insertIntoGrid(UniformGrid& grid,
+                         const AABB& bounds,
+                         int32_t userIndex)
+  {
+    COREX_MATH_INSTRUMENT(insertIntoGrid);
+    assert(grid.cellSize > 0.f);
+
+    int32_t proxyID;
+    if (grid.freeProxyIDs.empty()) {
+      proxyID = static_cast<int32_t>(grid.proxies.size());
+      grid.proxies.push_back(GridProxy{});
+    } else {
+      proxyID = grid.freeProxyIDs.back();
+      grid.freeProxyIDs.pop_back();
+    }
+
+    GridProxy& proxy = grid.proxies[proxyID];
+    GridCellRange cells = getGridCellRange(grid, bounds);
+    proxy.bounds = bounds;
+    setGridProxyCellRange(proxy, cells);
+    proxy.userIndex = userIndex;
+    proxy.isActive = true;
+
+    addGridCellEntries(grid, proxyID, cells, emptyGridCellRange);
+
+    return proxyID;
+  }
+
+  int32_t insertIntoGrid(UniformGrid& grid,
+                         const Rectangle& rect,
+                         int32_t userIndex)
+  {
+    return insertIntoGrid(grid, getRectangleAABB(rect), userIndex);
+  }
+
+  int32_t insertIntoGrid(UniformGrid& grid,
+                         const NPolygon& polygon,
+                         int32_t userIndex)
+  {
+    return insertIntoGrid(grid, getPolygonAABB(polygon), userIndex);
+  }
+
+  void moveInGrid(UniformGrid& grid, int32_t proxyID, const AABB& bounds)
+  {
+    COREX_MATH_INSTRUMENT(moveInGrid);
+    GridProxy& proxy = grid.proxies[proxyID];
+    assert(proxy.isActive);
+
+    // Moving within the same cells does not change which cells have the
+    // proxy. Otherwise, only the entries of the cells that the proxy left or
+    // entered change.
+    GridCellRange oldCells = getGridProxyCellRange(proxy);
+    GridCellRange newCells = getGridCellRange(grid, bounds);
+    if (newCells.minCellX != oldCells.minCellX
+        || newCells.minCellY != oldCells.minCellY
+        || newCells.maxCellX != oldCells.maxCellX
+        || newCells.maxCellY != oldCells.maxCellY) {
+      removeGridCellEntries(grid, proxyID, oldCells, newCells);
+      addGridCellEntries(grid, proxyID, newCells, oldCells);
+      setGridProxyCellRange(proxy, newCells);
+    }
+
+    proxy.bounds = bounds;
+  }
+
+  void moveInGrid(UniformGrid& grid, int32_t proxyID, const Rectangle& rect)
+  {
+    moveInGrid(grid, proxyID, getRectangleAABB(rect));
+  }
+
+  void moveInGrid(UniformGrid& grid,
+                  int32_t proxyID,
+                  const NPolygon& polygon)
+  {
+    moveInGrid(grid, proxyID, getPolygonAABB(polygon));
+  }
+
+  void removeFromGrid(UniformGrid& grid, int32_t proxyID)
+  {
+    COREX_MATH_INSTRUMENT(removeFromGrid);
+    GridProxy& proxy = grid.proxies[proxyID];
+    assert(proxy.isActive);
+    removeGridCellEntries(grid, proxyID, getGridProxyCellRange(proxy),
+                          emptyGridCellRange);
+    proxy.isActive = false;
+    grid.freeProxyIDs.push_back(proxyID);
+  }
+
+  void findGridCandidatePairs(UniformGrid& grid,
+                              eastl::vector<IndexPair>& pairs)
+  {
+    COREX_MATH_INSTRUMENT(findGridCandidatePairs);
+    pairs.clear();
+
+    // Pairs are found from the cells of each proxy, in the order of the
+    // proxy IDs, so that their order does not depend on where the cells
+    // ended up in the table. Each pair is found from its proxy with the
+    // lower ID.
+    const auto& entries = grid.cellEntries;
+    auto numProxies = static_cast<int32_t>(grid.proxies.size());
+    for (int32_t proxyID0 = 0; proxyID0 < numProxies; proxyID0++) {
+      const GridProxy& proxy0 = grid.proxies[proxyID0];
+      if (!proxy0.isActive) {
+        continue;
+      }
+
+      for (int32_t cellX = proxy0.minCellX;
+           cellX <= proxy0.maxCellX;
+           cellX++) {
+        for (int32_t cellY = proxy0.minCellY;
+             cellY <= proxy0.maxCellY;
+             cellY++) {
+          int32_t slot = findGridCellSlot(grid, gridCellKey(cellX, cellY));
+          for (int32_t i = grid.cells[slot].firstEntryID;
+               i != -1;
+               i = entries[i].nextEntryID) {
+            int32_t proxyID1 = entries[i].proxyID;
+            if (proxyID1 <= proxyID0) {
+              continue;
+            }
+
+            // Two proxies may share more than one cell. To report each pair
+            // once, only the first cell they share (the one with the lowest
+            // x and y indices) gets to report it.
+            const GridProxy& proxy1 = grid.proxies[proxyID1];
+            if (cellX == eastl::max(proxy0.minCellX, proxy1.minCellX)
+                && cellY == eastl::max(proxy0.minCellY, proxy1.minCellY)
+                && areTwoAABBsIntersecting(proxy0.bounds, proxy1.bounds)) {
+              pairs.push_back(IndexPair{ proxy0.userIndex,
+                                         proxy1.userIndex });
+            }
+          }
+        }
+      }
+    }
+  }
+
+  static void queryGridCell(const UniformGrid& grid,
+                            const AABB& bounds,
+                            const GridCellRange& queryCells,
+                            int32_t cellX,
+                            int32_t cellY,
+                            eastl::vector<int32_t>& userIndices)
+  {
+    int32_t slot = findGridCellSlot(grid, gridCellKey(cellX, cellY));
+    if (slot == -1) {
+      return;
+    }
+
+    const auto& entries = grid.cellEntries;
+    for (int32_t i = grid.cells[slot].firstEntryID;
+         i != -1;
+         i = entries[i].nextEntryID) {
+      const GridProxy& proxy = grid.proxies[entries[i].proxyID];
+
+      // Like in findGridCandidatePairs(), only report a proxy in the first
+      // cell it shares with the query bounds.
+      if (cellX == eastl::max(proxy.minCellX, queryCells.minCellX)
+          && cellY == eastl::max(proxy.minCellY, queryCells.minCellY)
+          && areTwoAABBsIntersecting(proxy.bounds, bounds)) {
+        userIndices.push_back(proxy.userIndex);
+      }
+    }
+  }
+
+  void queryGrid(UniformGrid& grid,
+                 const AABB& bounds,
+                 eastl::vector<int32_t>& userIndices)
+  {
+    COREX_MATH_INSTRUMENT(queryGrid);
+    userIndices.clear();
+
+    GridCellRange queryCells = getGridCellRange(grid, bounds);
+    int64_t numQueryCells =
+        (static_cast<int64_t>(queryCells.maxCellX) - queryCells.minCellX + 1)
+        * (static_cast<int64_t>(queryCells.maxCellY) - queryCells.minCellY
+           + 1);
+
+    // Bounds that cover more cells than the grid has proxies are cheaper to
+    // query by testing every proxy instead.
+    if (numQueryCells > static_cast<int64_t>(grid.proxies.size())) {
+      for (const GridProxy& proxy : grid.proxies) {
+        if (proxy.isActive && areTwoAABBsIntersecting(proxy.bounds, bounds)) {
+          userIndices.push_back(proxy.userIndex);
+        }
+      }
+
+      return;
+    }
+
+    for (int32_t cellX = queryCells.minCellX;
+         cellX <= queryCells.maxCellX;
+         cellX++) {
+      for (int32_t cellY = queryCells.minCellY;
+           cellY <= queryCells.maxCellY;
+           cellY++) {
+        queryGridCell(grid, bounds, queryCells, cellX, cellY, userIndices);
+      }
+    }
+  }
+
+  // The traversal stacks of the tree queries are kept inline for trees that
+  // are not too deep, so that the queries usually do not allocate.
+  using TreeNodeStack = eastl::fixed_vector<int32_t, 128>;
+  using TreeNodePairStack = eastl::fixed_vector<IndexPair, 128>;
+
+  static AABB combineAABBs(const AABB& box0, const AABB& box1)
+  {
+    return AABB{
+        eastl::min(box0.minX, box1.minX),
+        eastl::min(box0.minY, box1.minY),
+        eastl::max(box0.maxX, box1.maxX),
+        eastl::max(box0.maxY, box1.maxY)
+    };
+  }
+
+  static float aabbPerimeter(const AABB& box)
+  {
+    return 2.f * ((box.maxX - box.minX) + (box.maxY - box.minY));
+  }
+
+  static bool doesAABBContain(const AABB& outer, const AABB& inner)
+  {
+    return outer.minX <= inner.minX && outer.minY <= inner.minY
+           && inner.maxX <= outer.maxX && inner.maxY <= outer.maxY;
+  }
+
+  static bool isTreeNodeLeaf(const AABBTreeNode& node)
+  {
+    return node.child0 == nullTreeNode;
+  }
+
+  static int32_t allocateTreeNode(AABBTree& tree)
+  {
+    int32_t nodeIndex;
+    if (tree.freeList == nullTreeNode) {
+      nodeIndex = static_cast<int32_t>(tree.nodes.size());
+      tree.nodes.push_back(AABBTreeNode{});
+    } else {
+      nodeIndex = tree.freeList;
+      tree.freeList = tree.nodes[nodeIndex].parent;
+    }
+
+    AABBTreeNode& node = tree.nodes[nodeIndex];
+    node.parent = nullTreeNode;
+    node.child0 = nullTreeNode;
+    node.child1 = nullTreeNode;
+    node.height = 0;
+    node.userIndex = -1;
+
+    return nodeIndex;
+  }
+
+  static void freeTreeNode(AABBTree& tree, int32_t nodeIndex)
+  {
+    tree.nodes[nodeIndex].parent = tree.freeList;
+    tree.nodes[nodeIndex].height = -1;
+    tree.freeList = nodeIndex;
+  }
+
+  static void replaceTreeChild(AABBTree& tree,
+                               int32_t parentIndex,
+                               int32_t oldChild,
+                               int32_t newChild)
+  {
+    if (parentIndex == nullTreeNode) {
+      tree.root = newChild;
+    } else if (tree.nodes[parentIndex].child0 == oldChild) {
+      tree.nodes[parentIndex].child0 = newChild;
+    } else {
+      tree.nodes[parentIndex].child1 = newChild;
+    }
+  }
+
+  static void refitTreeNode(AABBTree& tree, int32_t nodeIndex)
+  {
+    AABBTreeNode& node = tree.nodes[nodeIndex];
+    const AABBTreeNode& child0 = tree.nodes[node.child0];
+    const AABBTreeNode& child1 = tree.nodes[node.child1];
+    node.bounds = combineAABBs(child0.bounds, child1.bounds);
+    node.height = 1 + eastl::max(child0.height, child1.height);
+  }
+
+  static int32_t rotateTreeChildUp(AABBTree& tree,
+                                   int32_t nodeIndex,
+                                   int32_t childIndex)
+  {
+    // Makes the given child of the node take the place of the node, and makes
+    // the node a child of it. The node takes the shorter grandchild, so that
+    // the taller one stays higher up in the tree.
+    AABBTreeNode& node = tree.nodes[nodeIndex];
+    AABBTreeNode& child = tree.nodes[childIndex];
+    bool isChild0 = node.child0 == childIndex;
+
+    int32_t grandchild0 = child.child0;
+    int32_t grandchild1 = child.child1;
+    int32_t tallGrandchild = grandchild0;
+    int32_t shortGrandchild = grandchild1;
+    if (tree.nodes[grandchild1].height > tree.nodes[grandchild0].height) {
+      tallGrandchild = grandchild1;
+      shortGrandchild = grandchild0;
+    }
+
+    child.parent = node.parent;
+    replaceTreeChild(tree, node.parent, nodeIndex, childIndex);
+    child.child0 = nodeIndex;
+    child.child1 = tallGrandchild;
+    node.parent = childIndex;
+
+    if (isChild0) {
+      node.child0 = shortGrandchild;
+    } else {
+      node.child1 = shortGrandchild;
+    }
+    tree.nodes[shortGrandchild].parent = nodeIndex;
+
+    refitTreeNode(tree, nodeIndex);
+    refitTreeNode(tree, childIndex);
+
+    return childIndex;
+  }
+
+  static int32_t balanceTreeNode(AABBTree& tree, int32_t nodeIndex)
+  {
+    // Performs a tree rotation when one subtree of the node is at least two
+    // levels taller than the other one. Returns the index of the node that
+    // is now in place of the node.
+    const AABBTreeNode& node = tree.nodes[nodeIndex];
+    if (isTreeNodeLeaf(node) || node.height < 2) {
+      return nodeIndex;
+    }
+
+    int32_t child0 = node.child0;
+    int32_t child1 = node.child1;
+    int32_t balance = tree.nodes[child1].height - tree.nodes[child0].height;
+    if (balance > 1) {
+      return rotateTreeChildUp(tree, nodeIndex, child1);
+    } else if (balance < -1) {
+      return rotateTreeChildUp(tree, nodeIndex, child0);
+    }
+
+    return nodeIndex;
+  }
+
+  static void refitTreeAncestors(AABBTree& tree, int32_t nodeIndex)
+  {
+    while (nodeIndex != nullTreeNode) {
+      nodeIndex = balanceTreeNode(tree, nodeIndex);
+      refitTreeNode(tree, nodeIndex);
+      nodeIndex = tree.nodes[nodeIndex].parent;
+    }
+  }
+
+  static void insertTreeLeaf(AABBTree& tree, int32_t leafIndex)
+  {
+    if (tree.root == nullTreeNode) {
+      tree.root = leafIndex;
+      tree.nodes[leafIndex].parent = nullTreeNode;
+      return;
+    }
+
+    // Let's find the best sibling for the leaf by descending the tree, picking
+    // the child that increases the total perimeter of the tree the least.
+    // This is the same heuristic used by Box2D.
+    AABB leafBounds = tree.nodes[leafIndex].bounds;
+    int32_t siblingIndex = tree.root;
+    while (!isTreeNodeLeaf(tree.nodes[siblingIndex])) {
+      const AABBTreeNode& node = tree.nodes[siblingIndex];
+      float perimeter = aabbPerimeter(node.bounds);
+      float combinedPerimeter = aabbPerimeter(combineAABBs(node.bounds,
+                                                           leafBounds));
+
+      // Cost of creating a new parent for this node and the leaf.
+      float cost = 2.f * combinedPerimeter;
+
+      // Minimum cost of pushing the leaf further down the tree.
+      float inheritanceCost = 2.f * (combinedPerimeter - perimeter);
+
+      float childCosts[2];
+      int32_t children[2] = { node.child0, node.child1 };
+      for (int32_t i = 0; i < 2; i++) {
+        const AABBTreeNode& child = tree.nodes[children[i]];
+        float newPerimeter = aabbPerimeter(combineAABBs(child.bounds,
+                                                        leafBounds));
+        if (isTreeNodeLeaf(child)) {
+          childCosts[i] = newPerimeter + inheritanceCost;
+        } else {
+          childCosts[i] = (newPerimeter - aabbPerimeter(child.bounds))
+                          + inheritanceCost;
+        }
+      }
+
+      if (cost < childCosts[0] && cost < childCosts[1]) {
+        break;
+      }
+
+      siblingIndex = (childCosts[0] < childCosts[1]) ? children[0]
+                                                     : children[1];
+    }
+
+    // NOTE: Allocating a node may reallocate the node pool. So, no node
+    //       references must be held across this call.
+    int32_t oldParent = tree.nodes[siblingIndex].parent;
+    int32_t newParent = allocateTreeNode(tree);
+    AABBTreeNode& parentNode = tree.nodes[newParent];
+    parentNode.parent = oldParent;
+    parentNode.child0 = siblingIndex;
+    parentNode.child1 = leafIndex;
+    replaceTreeChild(tree, oldParent, siblingIndex, newParent);
+    tree.nodes[siblingIndex].parent = newParent;
+    tree.nodes[leafIndex].parent = newParent;
+
+    refitTreeAncestors(tree, newParent);
+  }
+
+  static void removeTreeLeaf(AABBTree& tree, int32_t leafIndex)
+  {
+    if (leafIndex == tree.root) {
+      tree.root = nullTreeNode;
+      return;
+    }
+
+    int32_t parentIndex = tree.nodes[leafIndex].parent;
+    int32_t grandparentIndex = tree.nodes[parentIndex].parent;
+    int32_t siblingIndex = (tree.nodes[parentIndex].child0 == leafIndex)
+                           ? tree.nodes[parentIndex].child1
+                           : tree.nodes[parentIndex].child0;
+
+    // The sibling takes the place of the parent, which is no longer needed.
+    replaceTreeChild(tree, grandparentIndex, parentIndex, siblingIndex);
+    tree.nodes[siblingIndex].parent = grandparentIndex;
+    freeTreeNode(tree, parentIndex);
+
+    refitTreeAncestors(tree, grandparentIndex);
+  }
+
+  static AABB fattenAABB(const AABBTree& tree, const AABB& bounds)
+  {
+    return AABB{
+        bounds.minX - tree.fatMargin,
+        bounds.minY - tree.fatMargin,
+        bounds.maxX + tree.fatMargin,
+        bounds.maxY + tree.fatMargin
+    };
+  }
+
+  int32_t insertIntoTree(AABBTree& tree, const AABB& bounds, int32_t userIndex)
+  {
+    COREX_MATH_INSTRUMENT(insertIntoTree);
+    int32_t leafIndex = allocateTreeNode(tree);
+    tree.nodes[leafIndex].bounds = fattenAABB(tree, bounds);
+    tree.nodes[leafIndex].userIndex = userIndex;
+    insertTreeLeaf(tree, leafIndex);
+
+    return leafIndex;
+  }
+
+  int32_t insertIntoTree(AABBTree& tree,
+                         const Rectangle& rect,
+                         int32_t userIndex)
+  {
+    return insertIntoTree(tree, getRectangleAABB(rect), userIndex);
+  }
+
+  int32_t insertIntoTree(AABBTree& tree,
+                         const NPolygon& polygon,
+                         int32_t userIndex)
+  {
+    return insertIntoTree(tree, getPolygonAABB(polygon), userIndex);
+  }
+
+  bool moveInTree(AABBTree& tree, int32_t proxyID, const AABB& bounds)
+  {
+    COREX_MATH_INSTRUMENT(moveInTree);
+    assert(isTreeNodeLeaf(tree.nodes[proxyID]));
+
+    if (doesAABBContain(tree.nodes[proxyID].bounds, bounds)) {
+      // Still within its fat bounds, so the tree does not need to change.
+      return false;
+    }
+
+    removeTreeLeaf(tree, proxyID);
+    tree.nodes[proxyID].bounds = fattenAABB(tree, bounds);
+    insertTreeLeaf(tree, proxyID);
+
+    return true;
+  }
+
+  bool moveInTree(AABBTree& tree, int32_t proxyID, const Rectangle& rect)
+  {
+    return moveInTree(tree, proxyID, getRectangleAABB(rect));
+  }
+
+  bool moveInTree(AABBTree& tree, int32_t proxyID, const NPolygon& polygon)
+  {
+    return moveInTree(tree, proxyID, getPolygonAABB(polygon));
+  }
+
+  void removeFromTree(AABBTree& tree, int32_t proxyID)
+  {
+    COREX_MATH_INSTRUMENT(removeFromTree);
+    assert(isTreeNodeLeaf(tree.nodes[proxyID]));
+
+    removeTreeLeaf(tree, proxyID);
+    freeTreeNode(tree, proxyID);
+  }
+
+  void queryTree(const AABBTree& tree,
+                 const AABB& bounds,
+                 eastl::vector<int32_t>& userIndices)
+  {
+    COREX_MATH_INSTRUMENT(queryTree);
+    userIndices.clear();
+    if (tree.root == nullTreeNode) {
+      return;
+    }
+
+    TreeNodeStack stack;
+    stack.push_back(tree.root);
+    while (!stack.empty()) {
+      const AABBTreeNode& node = tree.nodes[stack.back()];
+      stack.pop_back();
+
+      if (!areTwoAABBsIntersecting(node.bounds, bounds)) {
+        continue;
+      }
+
+      if (isTreeNodeLeaf(node)) {
+        userIndices.push_back(node.userIndex);
+      } else {
+        stack.push_back(node.child0);
+        stack.push_back(node.child1);
+      }
+    }
+  }
+
+  static void findTreeNodePairs(const AABBTree& tree0,
+                                const AABBTree& tree1,
+                                TreeNodePairStack& stack,
+                                eastl::vector<IndexPair>& pairs)
+  {
+    // Descends both trees at the same time, only following pairs of nodes
+    // whose bounds overlap. When the same tree is given twice, a pair of the
+    // same node means finding the pairs within the subtree of the node.
+    bool isSameTree = &tree0 == &tree1;
+    while (!stack.empty()) {
+      IndexPair nodePair = stack.back();
+      stack.pop_back();
+
+      const AABBTreeNode& node0 = tree0.nodes[nodePair.first];
+      const AABBTreeNode& node1 = tree1.nodes[nodePair.second];
+      if (isSameTree && nodePair.first == nodePair.second) {
+        if (!isTreeNodeLeaf(node0)) {
+          stack.push_back(IndexPair{ node0.child0, node0.child0 });
+          stack.push_back(IndexPair{ node0.child1, node0.child1 });
+          stack.push_back(IndexPair{ node0.child0, node0.child1 });
+        }
+
+        continue;
+      }
+
+      if (!areTwoAABBsIntersecting(node0.bounds, node1.bounds)) {
+        continue;
+      }
+
+      bool isLeaf0 = isTreeNodeLeaf(node0);
+      bool isLeaf1 = isTreeNodeLeaf(node1);
+      if (isLeaf0 && isLeaf1) {
+        pairs.push_back(IndexPair{ node0.userIndex, node1.userIndex });
+      } else if (isLeaf1
+                 || (!isLeaf0 && aabbPerimeter(node0.bounds)
+                                   >= aabbPerimeter(node1.bounds))) {
+        // Descend into the bigger node first to prune more pairs earlier.
+        stack.push_back(IndexPair{ node0.child0, nodePair.second });
+        stack.push_back(IndexPair{ node0.child1, nodePair.second });
+      } else {
+        stack.push_back(IndexPair{ nodePair.first, node1.child0 });
+        stack.push_back(IndexPair{ nodePair.first, node1.child1 });
+      }
+    }
+  }
+
+  void findTreeCandidatePairs(const AABBTree& tree,
+                              eastl::vector<IndexPair>& pairs)
+  {
+    COREX_MATH_INSTRUMENT(findTreeCandidatePairs);
+    pairs.clear();
+    if (tree.root == nullTreeNode) {
+      return;
+    }
+
+    TreeNodePairStack stack;
+    stack.push_back(IndexPair{ tree.root, tree.root });
+    findTreeNodePairs(tree, tree, stack, pairs);
+  }
+
+  void findTreeVsTreeCandidatePairs(const AABBTree& tree0,
+                                    const AABBTree& tree1,
+                                    eastl::vector<IndexPair>& pairs)
+  {
+    COREX_MATH_INSTRUMENT(findTreeVsTreeCandidatePairs);
+    // The first index of each pair is from tree0, and the second index is
+    // from tree1.
+    pairs.clear();
+    if (tree0.root == nullTreeNode || tree1.root == nullTreeNode) {
+      return;
+    }
+
+    TreeNodePairStack stack;
+    stack.push_back(IndexPair{ tree0.root, tree1.root });
+    findTreeNodePairs(tree0, tree1, stack, pairs);
+  }
+}
@@ -0,0 +1,66 @@
+#ifndef COREX_MATH_BROADPHASE_HPP
+#define COREX_MATH_BROADPHASE_HPP
+
+#include <cstdint>
+
+#include <EASTL/vector.h>
+
+#include <corex/math/ds.hpp>
+
+namespace cx
+{
+  // Uniform grid broadphase. Shapes are inserted by their (rotated) bounds,
+  // and the candidate pairs found are pairs of the user indices given during
+  // insertion. Those can then be tested with a narrowphase function, such as
+  // areRectPairsIntersecting() or isRectIntersectingNPolygon().
+  //
+  // Shapes that are a lot bigger than the cell size overlap a lot of cells,
+  // so the cell size should be around the size of the typical shape.
+  int32_t insertIntoGrid(UniformGrid& grid,
+                         const AABB& bounds,
+                         int32_t userIndex);
+  int32_t insertIntoGrid(UniformGrid& grid,
+                         const Rectangle& rect,
+                         int32_t userIndex);
+  int32_t insertIntoGrid(UniformGrid& grid,
+                         const NPolygon& polygon,
+                         int32_t userIndex);
+  void moveInGrid(UniformGrid& grid, int32_t proxyID, const AABB& bounds);
+  void moveInGrid(UniformGrid& grid, int32_t proxyID, const Rectangle& rect);
+  void moveInGrid(UniformGrid& grid,
+                  int32_t proxyID,
+                  const NPolygon& polygon);
+  void removeFromGrid(UniformGrid& grid, int32_t proxyID);
+  void findGridCandidatePairs(UniformGrid& grid,
+                              eastl::vector<IndexPair>& pairs);
+  void queryGrid(UniformGrid& grid,
+                 const AABB& bounds,
+                 eastl::vector<int32_t>& userIndices);
+
+  // Dynamic AABB tree broadphase. Unlike the uniform grid, this handles
+  // shapes of very different sizes well. Shapes are inserted with fat bounds,
+  // and moveInTree() only changes the tree when a shape leaves its fat bounds,
+  // in which case it returns true. Like the grid, candidate pairs are pairs of
+  // the user indices given during insertion.
+  int32_t insertIntoTree(AABBTree& tree, const AABB& bounds, int32_t userIndex);
+  int32_t insertIntoTree(AABBTree& tree,
+                         const Rectangle& rect,
+                         int32_t userIndex);
+  int32_t insertIntoTree(AABBTree& tree,
+                         const NPolygon& polygon,
+                         int32_t userIndex);
+  bool moveInTree(AABBTree& tree, int32_t proxyID, const AABB& bounds);
+  bool moveInTree(AABBTree& tree, int32_t proxyID, const Rectangle& rect);
+  bool moveInTree(AABBTree& tree, int32_t proxyID, const NPolygon& polygon);
+  void removeFromTree(AABBTree& tree, int32_t proxyID);
+  void queryTree(const AABBTree& tree,
+                 const AABB& bounds,
+                 eastl::vector<int32_t>& userIndices);
+  void findTreeCandidatePairs(const AABBTree& tree,
+                              eastl::vector<IndexPair>& pairs);
+  void findTreeVsTreeCandidatePairs(const AABBTree& tree0,
+                                    const AABBTree& tree1,
+                                    eastl::vector<IndexPair>& pairs);
+}
+
+#endif
@@ -0,0 +1,287 @@
+#include <cstdint>
+
+#include <EASTL/algorithm.h>
+#include <EASTL/vector.h>
+
+#include <corex/math/clipping.hpp>
+#include <corex/math/ds.hpp>
+#include <corex/math/geometry.hpp>
+#include <corex/math/instrumentation.hpp>
+
+namespace cx
+{
+  static double signedDoubleArea(const Point* vertices, int32_t numVertices)
+  {
+    // Twice the signed area of a polygon, from the Shoelace algorithm.
+    double area = 0.0;
+    for (int32_t i = 0, j = numVertices - 1; i < numVertices; j = i++) {
+      area += (static_cast<double>(vertices[j].x)
+               * static_cast<double>(vertices[i].y))
+              - (static_cast<double>(vertices[i].x)
+                 * static_cast<double>(vertices[j].y));
+    }
+
+    return area;
+  }
+
+  static double sideOfEdge(const Point& edgeStart,
+                           const Point& edgeEnd,
+                           const Point& point)
+  {
+    // Positive when the point is to the left of the edge, if the y axis
+    // points up (or to the right, if it points down like in the windowing
+    // system), zero if it is on the line of the edge, and negative otherwise.
+    return ((static_cast<double>(edgeEnd.x) - edgeStart.x)
+            * (static_cast<double>(point.y) - edgeStart.y))
+           - ((static_cast<double>(edgeEnd.y) - edgeStart.y)
+              * (static_cast<double>(point.x) - edgeStart.x));
+  }
+
+  int32_t clipConvexPolygonVertices(const Point* targetVertices,
+                                    int32_t numTargetVertices,
+                                    const Point* clippingVertices,
+                                    int32_t numClippingVertices,
+                                    Point* clippedVertices,
+                                    Point* scratchVertices)
+  {
+    COREX_MATH_INSTRUMENT(clippedPolygonFromTwoConvexPolygons);
+    // Sutherland-Hodgman, but with any convex polygon as the clipping
+    // polygon. The inside of each clip edge depends on the winding of the
+    // clipping polygon.
+    double orientation = (signedDoubleArea(clippingVertices,
+                                           numClippingVertices) >= 0.0)
+                         ? 1.0
+                         : -1.0;
+    int32_t maxNumVertices = numTargetVertices + numClippingVertices;
+
+    // Each clip edge reads the vertices written by the previous one, so we
+    // alternate between the two buffers, starting with the one that makes the
+    // last clip edge write to clippedVertices.
+    const Point* inputVertices = targetVertices;
+    int32_t numInputVertices = numTargetVertices;
+    Point* outputVertices = (numClippingVertices % 2 == 1)
+                            ? clippedVertices
+                            : scratchVertices;
+    for (int32_t c = 0; c < numClippingVertices && numInputVertices > 0;
+         c++) {
+      const Point& edgeStart = clippingVertices[c];
+      const Point& edgeEnd = clippingVertices[(c + 1) % numClippingVertices];
+
+      int32_t numOutputVertices = 0;
+      double prevSide = orientation * sideOfEdge(
+        edgeStart, edgeEnd, inputVertices[numInputVertices - 1]);
+      for (int32_t i = 0; i < numInputVertices; i++) {
+        const Point& prevVertex = inputVertices[(i + numInputVertices - 1)
+                                                % numInputVertices];
+        const Point& currVertex = inputVertices[i];
+        double currSide = orientation * sideOfEdge(edgeStart, edgeEnd,
+                                                   currVertex);
+
+        // Convex polygons only ever get a vertex more from each clip edge.
+        // The checks against the maximum number of vertices only guard the
+        // buffers from polygons that aren't quite convex.
+        if ((prevSide >= 0.0) != (currSide >= 0.0)
+            && numOutputVertices < maxNumVertices) {
+          // The edge from the previous vertex to the current one crosses the
+          // clip edge.
+          double t = prevSide / (prevSide - currSide);
+          outputVertices[numOutputVertices++] = Point{
+              static_cast<float>(prevVertex.x
+                                 + (t * (static_cast<double>(currVertex.x)
+                                         - prevVertex.x))),
+              static_cast<float>(prevVertex.y
+                                 + (t * (static_cast<double>(currVertex.y)
+                                         - prevVertex.y)))
+          };
+        }
+
+        if (currSide >= 0.0 && numOutputVertices < maxNumVertices) {
+          outputVertices[numOutputVertices++] = currVertex;
+        }
+
+        prevSide = currSide;
+      }
+
+      inputVertices = outputVertices;
+      numInputVertices = numOutputVertices;
+      outputVertices = (outputVertices == clippedVertices)
+                       ? scratchVertices
+                       : clippedVertices;
+    }
+
+    if (numInputVertices < 3) {
+      // Polygons that are only touching each other have no overlap.
+      return 0;
+    }
+
+    if (inputVertices != clippedVertices) {
+      // We only get here when the clipping polygon has no vertices.
+      eastl::copy(inputVertices, inputVertices + numInputVertices,
+                  clippedVertices);
+    }
+
+    return numInputVertices;
+  }
+
+  static double sumOfEdgesInsidePolygon(const Point* edgeVertices,
+                                        int32_t numEdgeVertices,
+                                        double edgeOrientation,
+                                        const Point* polygonVertices,
+                                        int32_t numPolygonVertices,
+                                        double polygonOrientation,
+                                        bool isSharedEdgeCounted)
+  {
+    // The area of a polygon is half the sum of the cross products of the
+    // start and end of each of its edges, going counterclockwise when the y
+    // axis points up. The edges of the overlap of two convex polygons are the
+    // parts of the edges of each polygon that are inside the other polygon.
+    // So, this computes the sum for the parts of the edges of one polygon
+    // that are inside the other polygon, without ever building the overlap.
+    double sum = 0.0;
+    for (int32_t e = 0; e < numEdgeVertices; e++) {
+      // Go through the edges counterclockwise, since the overlap polygon
+      // needs to be traversed that way.
+      int32_t startIndex = e;
+      int32_t endIndex = (e + 1) % numEdgeVertices;
+      if (edgeOrientation < 0.0) {
+        eastl::swap(startIndex, endIndex);
+      }
+
+      const Point& start = edgeVertices[startIndex];
+      const Point& end = edgeVertices[endIndex];
+
+      // Cyrus-Beck clipping of the edge against each edge of the polygon.
+      double tStart = 0.0;
+      double tEnd = 1.0;
+      for (int32_t p = 0; p < numPolygonVertices && tStart < tEnd; p++) {
+        const Point& polyStart = polygonVertices[p];
+        const Point& polyEnd = polygonVertices[(p + 1) % numPolygonVertices];
+        double startSide = polygonOrientation * sideOfEdge(polyStart,
+                                                           polyEnd,
+                                                           start);
+        double endSide = polygonOrientation * sideOfEdge(polyStart,
+                                                         polyEnd,
+                                                         end);
+
+        if (startSide == 0.0 && endSide == 0.0) {
+          // The edge lies on the line of an edge of the polygon. If both
+          // polygons are on the same side of that line, the edge is part of
+          // the edges of the overlap, but we must only count it for one of the
+          // polygons. Otherwise, the polygons are only touching there.
+          double edgeDirection =
+              ((static_cast<double>(end.x) - start.x)
+               * (static_cast<double>(polyEnd.x) - polyStart.x)
+               + (static_cast<double>(end.y) - start.y)
+                 * (static_cast<double>(polyEnd.y) - polyStart.y))
+              * polygonOrientation;
+          if (!isSharedEdgeCounted || edgeDirection <= 0.0) {
+            tEnd = tStart;
+          }
+        } else if (startSide < 0.0 && endSide < 0.0) {
+          tEnd = tStart;
+        } else if (startSide < 0.0) {
+          tStart = eastl::max(tStart, startSide / (startSide - endSide));
+        } else if (endSide < 0.0) {
+          tEnd = eastl::min(tEnd, startSide / (startSide - endSide));
+        }
+      }
+
+      if (tStart < tEnd) {
+        double deltaX = static_cast<double>(end.x) - start.x;
+        double deltaY = static_cast<double>(end.y) - start.y;
+        double clippedStartX = start.x + (tStart * deltaX);
+        double clippedStartY = start.y + (tStart * deltaY);
+        double clippedEndX = start.x + (tEnd * deltaX);
+        double clippedEndY = start.y + (tEnd * deltaY);
+        sum += (clippedStartX * clippedEndY) - (clippedEndX * clippedStartY);
+      }
+    }
+
+    return sum;
+  }
+
+  double getConvexPolygonsOverlapArea(const Point* vertices0,
+                                      int32_t numVertices0,
+                                      const Point* vertices1,
+                                      int32_t numVertices1)
+  {
+    COREX_MATH_INSTRUMENT(getConvexPolygonsOverlapArea);
+    double orientation0 = (signedDoubleArea(vertices0, numVertices0) >= 0.0)
+                          ? 1.0
+                          : -1.0;
+    double orientation1 = (signedDoubleArea(vertices1, numVertices1) >= 0.0)
+                          ? 1.0
+                          : -1.0;
+
+    // Edges shared by both polygons are only counted for the first polygon.
+    double area = sumOfEdgesInsidePolygon(vertices0, numVertices0,
+                                          orientation0,
+                                          vertices1, numVertices1,
+                                          orientation1, true)
+                  + sumOfEdgesInsidePolygon(vertices1, numVertices1,
+                                            orientation1,
+                                            vertices0, numVertices0,
+                                            orientation0, false);
+
+    return eastl::max(area / 2.0, 0.0);
+  }
+
+  void clipConvexPolygonPairs(const eastl::vector<NPolygon>& polygons,
+                              const eastl::vector<IndexPair>& pairs,
+                              eastl::vector<Point>& clippedVertices,
+                              eastl::vector<int32_t>& clippedOffsets)
+  {
+    COREX_MATH_INSTRUMENT(clipConvexPolygonPairs);
+    // The scratch buffer gets reused across all pairs, so only the first few
+    // pairs would need to grow it. Each clipped polygon is written directly
+    // to the end of clippedVertices.
+    eastl::vector<Point> scratchVertices;
+
+    clippedVertices.clear();
+    int32_t numPairs = static_cast<int32_t>(pairs.size());
+    clippedOffsets.resize(numPairs + 1);
+    clippedOffsets[0] = 0;
+    for (int32_t i = 0; i < numPairs; i++) {
+      const NPolygon& targetPolygon = polygons[pairs[i].first];
+      const NPolygon& clippingPolygon = polygons[pairs[i].second];
+      int32_t numTargetVertices = static_cast<int32_t>(
+        targetPolygon.vertices.size());
+      int32_t numClippingVertices = static_cast<int32_t>(
+        clippingPolygon.vertices.size());
+      int32_t maxNumVertices = numTargetVertices + numClippingVertices;
+
+      int32_t offset = clippedOffsets[i];
+      clippedVertices.resize(offset + maxNumVertices);
+      if (static_cast<int32_t>(scratchVertices.size()) < maxNumVertices) {
+        scratchVertices.resize(maxNumVertices);
+      }
+
+      int32_t numClippedVertices = clipConvexPolygonVertices(
+        targetPolygon.vertices.data(), numTargetVertices,
+        clippingPolygon.vertices.data(), numClippingVertices,
+        clippedVertices.data() + offset, scratchVertices.data());
+      clippedOffsets[i + 1] = offset + numClippedVertices;
+    }
+
+    clippedVertices.resize(clippedOffsets[numPairs]);
+  }
+
+  void getConvexPolygonPairsOverlapAreas(
+      const eastl::vector<NPolygon>& polygons,
+      const eastl::vector<IndexPair>& pairs,
+      eastl::vector<double>& areas)
+  {
+    COREX_MATH_INSTRUMENT(getConvexPolygonPairsOverlapAreas);
+    int32_t numPairs = static_cast<int32_t>(pairs.size());
+    areas.resize(numPairs);
+    for (int32_t i = 0; i < numPairs; i++) {
+      const NPolygon& polygon0 = polygons[pairs[i].first];
+      const NPolygon& polygon1 = polygons[pairs[i].second];
+      areas[i] = getConvexPolygonsOverlapArea(
+        polygon0.vertices.data(),
+        static_cast<int32_t>(polygon0.vertices.size()),
+        polygon1.vertices.data(),
+        static_cast<int32_t>(polygon1.vertices.size()));
+    }
+  }
+}
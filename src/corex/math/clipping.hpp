@@ -0,0 +1,153 @@
+#ifndef COREX_MATH_CLIPPING_HPP
+#define COREX_MATH_CLIPPING_HPP
+
+#include <cstdint>
+
+#include <EASTL/vector.h>
+
+#include <corex/math/ds.hpp>
+
+namespace cx
+{
+  // Clipping and overlap area of two convex polygons. The polygons may be
+  // wound either way, but must be convex. The clipped polygon has the same
+  // winding as the target polygon, and areas follow the semantics of
+  // getPolygonArea(), i.e. they are unsigned and computed in doubles.
+  //
+  // clipConvexPolygonVertices() writes the clipped polygon to clippedVertices
+  // and returns its number of vertices. Both clippedVertices and
+  // scratchVertices must have room for numTargetVertices + numClippingVertices
+  // vertices.
+  int32_t clipConvexPolygonVertices(const Point* targetVertices,
+                                    int32_t numTargetVertices,
+                                    const Point* clippingVertices,
+                                    int32_t numClippingVertices,
+                                    Point* clippedVertices,
+                                    Point* scratchVertices);
+  double getConvexPolygonsOverlapArea(const Point* vertices0,
+                                      int32_t numVertices0,
+                                      const Point* vertices1,
+                                      int32_t numVertices1);
+
+  // Batch versions. The clipped polygon of the i-th pair is made up of the
+  // vertices in clippedVertices from clippedOffsets[i] up to, but not
+  // including, clippedOffsets[i + 1].
+  void clipConvexPolygonPairs(const eastl::vector<NPolygon>& polygons,
+                              const eastl::vector<IndexPair>& pairs,
+                              eastl::vector<Point>& clippedVertices,
+                              eastl::vector<int32_t>& clippedOffsets);
+  void getConvexPolygonPairsOverlapAreas(
+      const eastl::vector<NPolygon>& polygons,
+      const eastl::vector<IndexPair>& pairs,
+      eastl::vector<double>& areas);
+
+  // The clipped polygon, including the scratch memory needed to clip, is
+  // allocated with the allocator of the clipped polygon.
+  template <typename Allocator>
+  void clippedPolygonFromTwoConvexPolygons(
+      const Point* targetVertices,
+      int32_t numTargetVertices,
+      const Point* clippingVertices,
+      int32_t numClippingVertices,
+      BasicNPolygon<Allocator>& clippedPolygon)
+  {
+    int32_t maxNumVertices = numTargetVertices + numClippingVertices;
+    eastl::vector<Point, Allocator> scratchVertices{
+      clippedPolygon.vertices.get_allocator()
+    };
+    scratchVertices.resize(maxNumVertices);
+    clippedPolygon.vertices.resize(maxNumVertices);
+
+    int32_t numClippedVertices = clipConvexPolygonVertices(
+      targetVertices, numTargetVertices,
+      clippingVertices, numClippingVertices,
+      clippedPolygon.vertices.data(), scratchVertices.data());
+    clippedPolygon.vertices.resize(numClippedVertices);
+  }
+
+  template <typename TargetAllocator,
+            typename ClippingAllocator,
+            typename Allocator>
+  void clippedPolygonFromTwoConvexPolygons(
+      const BasicNPolygon<TargetAllocator>& targetPolygon,
+      const BasicNPolygon<ClippingAllocator>& clippingPolygon,
+      BasicNPolygon<Allocator>& clippedPolygon)
+  {
+    clippedPolygonFromTwoConvexPolygons(
+      targetPolygon.vertices.data(),
+      static_cast<int32_t>(targetPolygon.vertices.size()),
+      clippingPolygon.vertices.data(),
+      static_cast<int32_t>(clippingPolygon.vertices.size()),
+      clippedPolygon);
+  }
+
+  template <typename TargetAllocator,
+            typename ClippingAllocator,
+            typename Allocator = EASTLAllocatorType>
+  BasicNPolygon<Allocator> clippedPolygonFromTwoConvexPolygons(
+      const BasicNPolygon<TargetAllocator>& targetPolygon,
+      const BasicNPolygon<ClippingAllocator>& clippingPolygon,
+      const Allocator& allocator = Allocator())
+  {
+    BasicNPolygon<Allocator> clippedPolygon;
+    clippedPolygon.vertices.set_allocator(allocator);
+    clippedPolygonFromTwoConvexPolygons(targetPolygon, clippingPolygon,
+                                        clippedPolygon);
+    return clippedPolygon;
+  }
+
+  template <uint numTargetVertices,
+            uint numClippingVertices,
+            typename Allocator = EASTLAllocatorType>
+  BasicNPolygon<Allocator> clippedPolygonFromTwoConvexPolygons(
+      const Polygon<numTargetVertices>& targetPolygon,
+      const Polygon<numClippingVertices>& clippingPolygon,
+      const Allocator& allocator = Allocator())
+  {
+    BasicNPolygon<Allocator> clippedPolygon;
+    clippedPolygon.vertices.set_allocator(allocator);
+    clippedPolygonFromTwoConvexPolygons(targetPolygon.vertices.data(),
+                                        numTargetVertices,
+                                        clippingPolygon.vertices.data(),
+                                        numClippingVertices,
+                                        clippedPolygon);
+    return clippedPolygon;
+  }
+
+  template <typename Allocator0, typename Allocator1>
+  double getConvexPolygonsOverlapArea(
+      const BasicNPolygon<Allocator0>& polygon0,
+      const BasicNPolygon<Allocator1>& polygon1)
+  {
+    return getConvexPolygonsOverlapArea(
+      polygon0.vertices.data(),
+      static_cast<int32_t>(polygon0.vertices.size()),
+      polygon1.vertices.data(),
+      static_cast<int32_t>(polygon1.vertices.size()));
+  }
+
+  template <uint numVertices0, uint numVertices1>
+  double getConvexPolygonsOverlapArea(const Polygon<numVertices0>& polygon0,
+                                      const Polygon<numVertices1>& polygon1)
+  {
+    return getConvexPolygonsOverlapArea(polygon0.vertices.data(),
+                                        numVertices0,
+                                        polygon1.vertices.data(),
+                                        numVertices1);
+  }
+
+  template <uint numVertices>
+  void getConvexPolygonPairsOverlapAreas(
+      const eastl::vector<Polygon<numVertices>>& polygons,
+      const eastl::vector<IndexPair>& pairs,
+      eastl::vector<double>& areas)
+  {
+    areas.resize(pairs.size());
+    for (int32_t i = 0; i < pairs.size(); i++) {
+      areas[i] = getConvexPolygonsOverlapArea(polygons[pairs[i].first],
+                                              polygons[pairs[i].second]);
+    }
+  }
+}
+
+#endif
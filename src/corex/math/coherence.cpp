@@ -0,0 +1,195 @@
+#include <cstdint>
+
+#include <EASTL/vector.h>
+
+#include <corex/math/coherence.hpp>
+#include <corex/math/ds.hpp>
+#include <corex/math/instrumentation.hpp>
+
+namespace cx
+{
+  static uint64_t getPairIDHash(uint64_t pairID);
+  static int32_t findSeparatingAxisCacheSlot(
+      const SeparatingAxisCache& cache,
+      uint64_t pairID);
+  static void resizeSeparatingAxisCache(SeparatingAxisCache& cache,
+                                        int32_t numSlots);
+  static void removeSeparatingAxisCacheSlot(SeparatingAxisCache& cache,
+                                            int32_t slot);
+
+  // The table is grown once it would get more than 3/4 full.
+  static bool isSeparatingAxisCacheTooFull(int32_t numEntries,
+                                           int32_t numSlots)
+  {
+    return static_cast<int64_t>(numEntries) * 4
+           > static_cast<int64_t>(numSlots) * 3;
+  }
+
+  void reserveSeparatingAxisCache(SeparatingAxisCache& cache,
+                                  int32_t numPairs)
+  {
+    auto numSlots = static_cast<int32_t>(cache.entries.size());
+    if (numSlots == 0) {
+      numSlots = 16;
+    }
+
+    while (isSeparatingAxisCacheTooFull(numPairs, numSlots)) {
+      numSlots *= 2;
+    }
+
+    if (numSlots > static_cast<int32_t>(cache.entries.size())) {
+      resizeSeparatingAxisCache(cache, numSlots);
+    }
+  }
+
+  void clearSeparatingAxisCache(SeparatingAxisCache& cache)
+  {
+    for (SeparatingAxisCacheEntry& entry : cache.entries) {
+      entry.lastUsedFrame = 0;
+    }
+
+    cache.numEntries = 0;
+  }
+
+  void beginSeparatingAxisCacheFrame(SeparatingAxisCache& cache)
+  {
+    cache.frame++;
+
+    // 0 marks empty slots, so it is skipped when the frame number wraps
+    // around.
+    if (cache.frame == 0) {
+      cache.frame = 1;
+    }
+  }
+
+  void evictStaleSeparatingAxes(SeparatingAxisCache& cache,
+                                uint32_t maxIdleFrames)
+  {
+    COREX_MATH_INSTRUMENT(evictStaleSeparatingAxes);
+    if (cache.numEntries == 0) {
+      return;
+    }
+
+    // Removing an entry moves the entries after it in the same probe
+    // sequence back. Starting right after an empty slot means that no entry
+    // gets moved from a slot that was already visited to one that has not
+    // been yet, or the other way around, so one pass over the table is
+    // enough. There is always an empty slot, since the table is never full.
+    auto numSlots = static_cast<int32_t>(cache.entries.size());
+    int32_t mask = numSlots - 1;
+    int32_t emptySlot = 0;
+    while (cache.entries[emptySlot].lastUsedFrame != 0) {
+      emptySlot++;
+    }
+
+    int32_t numVisitedSlots = 0;
+    while (numVisitedSlots < numSlots) {
+      int32_t slot = (emptySlot + 1 + numVisitedSlots) & mask;
+      const SeparatingAxisCacheEntry& entry = cache.entries[slot];
+      if (entry.lastUsedFrame != 0
+          && cache.frame - entry.lastUsedFrame > maxIdleFrames) {
+        // The slot now has the next entry of the probe sequence, if any,
+        // which must be checked too.
+        removeSeparatingAxisCacheSlot(cache, slot);
+      } else {
+        numVisitedSlots++;
+      }
+    }
+  }
+
+  SeparatingAxisCacheEntry& getSeparatingAxisCacheEntry(
+      SeparatingAxisCache& cache,
+      uint64_t pairID)
+  {
+    int32_t slot = findSeparatingAxisCacheSlot(cache, pairID);
+    if (slot < 0 || cache.entries[slot].lastUsedFrame == 0) {
+      auto numSlots = static_cast<int32_t>(cache.entries.size());
+      if (numSlots == 0
+          || isSeparatingAxisCacheTooFull(cache.numEntries + 1, numSlots)) {
+        resizeSeparatingAxisCache(cache, numSlots == 0 ? 16 : numSlots * 2);
+        slot = findSeparatingAxisCacheSlot(cache, pairID);
+      }
+
+      cache.entries[slot] = SeparatingAxisCacheEntry{ pairID, 0, -1 };
+      cache.numEntries++;
+    }
+
+    SeparatingAxisCacheEntry& entry = cache.entries[slot];
+    entry.lastUsedFrame = cache.frame;
+    return entry;
+  }
+
+  static uint64_t getPairIDHash(uint64_t pairID)
+  {
+    // The finalizer of MurmurHash3. Pair IDs made from two indices only
+    // differ in a few bits, which this spreads over all of them.
+    pairID ^= pairID >> 33;
+    pairID *= 0xff51afd7ed558ccdull;
+    pairID ^= pairID >> 33;
+    pairID *= 0xc4ceb9fe1a85ec53ull;
+    pairID ^= pairID >> 33;
+    return pairID;
+  }
+
+  static int32_t findSeparatingAxisCacheSlot(
+      const SeparatingAxisCache& cache,
+      uint64_t pairID)
+  {
+    // Returns the slot of the pair if it is in the table, or the empty slot
+    // it would go in otherwise. -1 if the table has no slots.
+    auto numSlots = static_cast<int32_t>(cache.entries.size());
+    if (numSlots == 0) {
+      return -1;
+    }
+
+    int32_t mask = numSlots - 1;
+    auto slot = static_cast<int32_t>(getPairIDHash(pairID) & mask);
+    while (cache.entries[slot].lastUsedFrame != 0
+           && cache.entries[slot].pairID != pairID) {
+      slot = (slot + 1) & mask;
+    }
+
+    return slot;
+  }
+
+  static void resizeSeparatingAxisCache(SeparatingAxisCache& cache,
+                                        int32_t numSlots)
+  {
+    eastl::vector<SeparatingAxisCacheEntry> oldEntries;
+    oldEntries.swap(cache.entries);
+    cache.entries.resize(numSlots, SeparatingAxisCacheEntry{ 0, 0, -1 });
+    for (const SeparatingAxisCacheEntry& entry : oldEntries) {
+      if (entry.lastUsedFrame != 0) {
+        cache.entries[findSeparatingAxisCacheSlot(cache, entry.pairID)] =
+            entry;
+      }
+    }
+  }
+
+  static void removeSeparatingAxisCacheSlot(SeparatingAxisCache& cache,
+                                            int32_t slot)
+  {
+    // Backward shift deletion. Instead of leaving a tombstone, which would
+    // make probe sequences longer and longer in a table that gets entries
+    // added and removed every frame, the entries after the removed one are
+    // moved back into the hole, as long as that does not put them before
+    // the slot they hash to.
+    auto numSlots = static_cast<int32_t>(cache.entries.size());
+    int32_t mask = numSlots - 1;
+    int32_t hole = slot;
+    int32_t next = (hole + 1) & mask;
+    while (cache.entries[next].lastUsedFrame != 0) {
+      auto homeSlot = static_cast<int32_t>(
+          getPairIDHash(cache.entries[next].pairID) & mask);
+      if (((next - homeSlot) & mask) >= ((next - hole) & mask)) {
+        cache.entries[hole] = cache.entries[next];
+        hole = next;
+      }
+
+      next = (next + 1) & mask;
+    }
+
+    cache.entries[hole].lastUsedFrame = 0;
+    cache.numEntries--;
+  }
+}
@@ -0,0 +1,56 @@
+#ifndef COREX_MATH_COHERENCE_HPP
+#define COREX_MATH_COHERENCE_HPP
+
+#include <cstdint>
+
+#include <corex/math/ds.hpp>
+
+namespace cx
+{
+  // Temporal coherence. The same pairs of shapes tend to get tested every
+  // frame, and a pair that was separated by an axis in the last frame is
+  // most likely still separated by it. A SeparatingAxisCache remembers that
+  // axis per pair, so the next test of the pair can try it first, and stop
+  // right away if the pair is still apart. See the overloads of
+  // areTwoRectsIntersecting() that take one.
+  //
+  // Pairs are identified by IDs chosen by the caller, e.g. with getPairID()
+  // from the indices of the two shapes. An ID must always be used for the
+  // shapes in the same order, since the cached axis refers to one of them.
+
+  inline uint64_t getPairID(int32_t index0, int32_t index1)
+  {
+    return (static_cast<uint64_t>(static_cast<uint32_t>(index0)) << 32)
+           | static_cast<uint64_t>(static_cast<uint32_t>(index1));
+  }
+
+  inline uint64_t getPairID(const IndexPair& pair)
+  {
+    return getPairID(pair.first, pair.second);
+  }
+
+  // Makes room for the given number of pairs up front, so that the table
+  // does not need to grow while pairs are being tested.
+  void reserveSeparatingAxisCache(SeparatingAxisCache& cache,
+                                  int32_t numPairs);
+  void clearSeparatingAxisCache(SeparatingAxisCache& cache);
+
+  // Should be called once per frame, before the pairs of the frame are
+  // tested.
+  void beginSeparatingAxisCacheFrame(SeparatingAxisCache& cache);
+
+  // Removes the pairs that have not been tested in the last maxIdleFrames
+  // frames, e.g. ones the broadphase no longer reports. This goes over the
+  // whole table, so it does not need to be done every frame.
+  void evictStaleSeparatingAxes(SeparatingAxisCache& cache,
+                                uint32_t maxIdleFrames);
+
+  // Returns the entry for the pair, marked as used in the current frame. A
+  // pair that was not in the cache yet is added, with no axis. The entry
+  // stays valid until the next call that changes the cache.
+  SeparatingAxisCacheEntry& getSeparatingAxisCacheEntry(
+      SeparatingAxisCache& cache,
+      uint64_t pairID);
+}
+
+#endif
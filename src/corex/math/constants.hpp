@@ -1,4 +1,9 @@
+#ifndef COREX_MATH_CONSTANTS_HPP
+#define COREX_MATH_CONSTANTS_HPP
+
 namespace cx
 {
   constexpr double pi = 3.14159265358979323846;
-}
\ No newline at end of file
+}
+
+#endif
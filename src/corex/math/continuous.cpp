@@ -0,0 +1,310 @@
+#include <cmath>
+#include <cstdint>
+
+#include <EASTL/algorithm.h>
+#include <EASTL/numeric_limits.h>
+#include <EASTL/vector.h>
+
+#include <corex/utils.hpp>
+#include <corex/math/continuous.hpp>
+#include <corex/math/ds.hpp>
+#include <corex/math/geometry.hpp>
+#include <corex/math/instrumentation.hpp>
+#include <corex/math/linear_algebra.hpp>
+
+namespace cx
+{
+  // Rectangles that are apart by less than this fraction of the sum of their
+  // circumradii are considered to be touching by the conservative
+  // advancement. It is relative so that it stays above float precision for
+  // big rectangles that are far from the origin.
+  constexpr float relativeContactTolerance = 0.0001f;
+  constexpr int32_t maxAdvancementSteps = 64;
+
+  struct SweptRect
+  {
+    // A rectangle at some point in time during its motion, in the form that
+    // the separating axis tests use.
+    float centerX;
+    float centerY;
+    float halfWidth;
+    float halfHeight;
+    float cosine;
+    float sine;
+  };
+
+  struct RectsSeparation
+  {
+    // The largest distance between the projections of two rectangles onto
+    // one of their axes, which is negative if the rectangles intersect, and
+    // the axis, pointing from the first rectangle towards the second.
+    float distance;
+    Vec2 normal;
+  };
+
+  static SweptRect getSweptRect(const Rectangle& rect,
+                                const RectangleMotion& motion,
+                                float time);
+  static float getProjectionRadius(const SweptRect& rect,
+                                   float axisX,
+                                   float axisY);
+  static RectsSeparation getRectsSeparation(const SweptRect& rect0,
+                                            const SweptRect& rect1);
+  static ReturnValue<TimeOfImpact> getLinearTimeOfImpact(
+      const Rectangle& rect0,
+      const Vec2& velocity0,
+      const Rectangle& rect1,
+      const Vec2& velocity1,
+      float maxTime);
+  static ReturnValue<TimeOfImpact> getAngularTimeOfImpact(
+      const Rectangle& rect0,
+      const RectangleMotion& motion0,
+      const Rectangle& rect1,
+      const RectangleMotion& motion1,
+      float maxTime);
+
+  ReturnValue<TimeOfImpact> getRectsTimeOfImpact(const Rectangle& rect0,
+                                                 const Vec2& velocity0,
+                                                 const Rectangle& rect1,
+                                                 const Vec2& velocity1,
+                                                 float maxTime)
+  {
+    COREX_MATH_INSTRUMENT(getRectsTimeOfImpact);
+    return getLinearTimeOfImpact(rect0, velocity0, rect1, velocity1, maxTime);
+  }
+
+  ReturnValue<TimeOfImpact> getRectsTimeOfImpact(
+      const Rectangle& rect0,
+      const RectangleMotion& motion0,
+      const Rectangle& rect1,
+      const RectangleMotion& motion1,
+      float maxTime)
+  {
+    COREX_MATH_INSTRUMENT(getRectsTimeOfImpact);
+    if (motion0.angularVelocity == 0.f && motion1.angularVelocity == 0.f) {
+      return getLinearTimeOfImpact(rect0, motion0.velocity,
+                                   rect1, motion1.velocity,
+                                   maxTime);
+    }
+
+    return getAngularTimeOfImpact(rect0, motion0, rect1, motion1, maxTime);
+  }
+
+  void getRectPairsTimesOfImpact(const eastl::vector<Rectangle>& rects,
+                                 const eastl::vector<RectangleMotion>& motions,
+                                 const eastl::vector<IndexPair>& pairs,
+                                 float maxTime,
+                                 eastl::vector<uint64_t>& hitMask,
+                                 eastl::vector<TimeOfImpact>& timesOfImpact)
+  {
+    COREX_MATH_INSTRUMENT(getRectPairsTimesOfImpact);
+    int32_t numPairs = static_cast<int32_t>(pairs.size());
+    hitMask.assign((numPairs + 63) / 64, 0);
+    timesOfImpact.resize(numPairs);
+    for (int32_t i = 0; i < numPairs; i++) {
+      int32_t a = pairs[i].first;
+      int32_t b = pairs[i].second;
+      bool isLinear = motions[a].angularVelocity == 0.f
+                      && motions[b].angularVelocity == 0.f;
+      ReturnValue<TimeOfImpact> timeOfImpact = isLinear
+        ? getLinearTimeOfImpact(rects[a], motions[a].velocity,
+                                rects[b], motions[b].velocity,
+                                maxTime)
+        : getAngularTimeOfImpact(rects[a], motions[a],
+                                 rects[b], motions[b],
+                                 maxTime);
+
+      if (timeOfImpact.status == ReturnState::RETURN_OK) {
+        hitMask[i >> 6] |= uint64_t(1) << (i & 63);
+        timesOfImpact[i] = timeOfImpact.value;
+      } else {
+        timesOfImpact[i] = TimeOfImpact{ 0.f, Vec2{} };
+      }
+    }
+  }
+
+  static SweptRect getSweptRect(const Rectangle& rect,
+                                const RectangleMotion& motion,
+                                float time)
+  {
+    Rotation rotation = rotationFromAngle(
+      rect.angle + (motion.angularVelocity * time));
+    return SweptRect{
+      rect.x + (motion.velocity.x * time),
+      rect.y + (motion.velocity.y * time),
+      rect.width / 2.f,
+      rect.height / 2.f,
+      rotation.cosine,
+      rotation.sine
+    };
+  }
+
+  static float getProjectionRadius(const SweptRect& rect,
+                                   float axisX,
+                                   float axisY)
+  {
+    // The axes of a rectangle are (cos, sin) and (-sin, cos), just like in
+    // areTwoRectsIntersecting().
+    return (rect.halfWidth * std::fabs((rect.cosine * axisX)
+                                       + (rect.sine * axisY)))
+           + (rect.halfHeight * std::fabs((rect.cosine * axisY)
+                                          - (rect.sine * axisX)));
+  }
+
+  static RectsSeparation getRectsSeparation(const SweptRect& rect0,
+                                            const SweptRect& rect1)
+  {
+    const Vec2 axes[4] = {
+      Vec2{ rect0.cosine, rect0.sine },
+      Vec2{ -rect0.sine, rect0.cosine },
+      Vec2{ rect1.cosine, rect1.sine },
+      Vec2{ -rect1.sine, rect1.cosine }
+    };
+
+    float deltaX = rect1.centerX - rect0.centerX;
+    float deltaY = rect1.centerY - rect0.centerY;
+    RectsSeparation separation{ eastl::numeric_limits<float>::lowest(),
+                                Vec2{} };
+    for (const Vec2& axis : axes) {
+      float offset = (deltaX * axis.x) + (deltaY * axis.y);
+      float distance = std::fabs(offset)
+                       - getProjectionRadius(rect0, axis.x, axis.y)
+                       - getProjectionRadius(rect1, axis.x, axis.y);
+      if (distance > separation.distance) {
+        separation.distance = distance;
+        separation.normal = (offset >= 0.f) ? axis : Vec2{ -axis.x, -axis.y };
+      }
+    }
+
+    return separation;
+  }
+
+  static ReturnValue<TimeOfImpact> getLinearTimeOfImpact(
+      const Rectangle& rect0,
+      const Vec2& velocity0,
+      const Rectangle& rect1,
+      const Vec2& velocity1,
+      float maxTime)
+  {
+    // Swept SAT. Without rotation, the axes stay the same, and the distance
+    // between the centers of the rectangles along an axis changes linearly
+    // over time. So, each axis gives a single interval of time during which
+    // the projections of the rectangles overlap, and the rectangles
+    // intersect while all of the intervals do. The rectangles first touch
+    // when the last of the intervals starts.
+    SweptRect swept0 = getSweptRect(rect0, RectangleMotion{}, 0.f);
+    SweptRect swept1 = getSweptRect(rect1, RectangleMotion{}, 0.f);
+    const Vec2 axes[4] = {
+      Vec2{ swept0.cosine, swept0.sine },
+      Vec2{ -swept0.sine, swept0.cosine },
+      Vec2{ swept1.cosine, swept1.sine },
+      Vec2{ -swept1.sine, swept1.cosine }
+    };
+
+    float deltaX = swept1.centerX - swept0.centerX;
+    float deltaY = swept1.centerY - swept0.centerY;
+    float relativeVelocityX = velocity1.x - velocity0.x;
+    float relativeVelocityY = velocity1.y - velocity0.y;
+    float enterTime = eastl::numeric_limits<float>::lowest();
+    float exitTime = eastl::numeric_limits<float>::max();
+    Vec2 normal;
+    for (const Vec2& axis : axes) {
+      float offset = (deltaX * axis.x) + (deltaY * axis.y);
+      float radius = getProjectionRadius(swept0, axis.x, axis.y)
+                     + getProjectionRadius(swept1, axis.x, axis.y);
+      float speed = (relativeVelocityX * axis.x)
+                    + (relativeVelocityY * axis.y);
+      if (speed == 0.f) {
+        if (std::fabs(offset) > radius) {
+          // The projections are apart, and they'll stay that way.
+          return ReturnValue<TimeOfImpact>{
+            TimeOfImpact{}, ReturnState::RETURN_FAIL
+          };
+        }
+
+        continue;
+      }
+
+      // The projections overlap while -radius <= offset + speed * t <= radius.
+      float time0 = (-radius - offset) / speed;
+      float time1 = (radius - offset) / speed;
+      float axisEnterTime = eastl::min(time0, time1);
+      float axisExitTime = eastl::max(time0, time1);
+      if (axisEnterTime > enterTime) {
+        enterTime = axisEnterTime;
+
+        // The second rectangle enters from the side it was on.
+        normal = (offset + (speed * axisEnterTime) >= 0.f)
+                 ? axis
+                 : Vec2{ -axis.x, -axis.y };
+      }
+
+      exitTime = eastl::min(exitTime, axisExitTime);
+    }
+
+    if (enterTime > exitTime || exitTime < 0.f || enterTime > maxTime) {
+      return ReturnValue<TimeOfImpact>{
+        TimeOfImpact{}, ReturnState::RETURN_FAIL
+      };
+    }
+
+    if (enterTime <= 0.f) {
+      // Already intersecting.
+      return ReturnValue<TimeOfImpact>{
+        TimeOfImpact{ 0.f, getRectsSeparation(swept0, swept1).normal },
+        ReturnState::RETURN_OK
+      };
+    }
+
+    return ReturnValue<TimeOfImpact>{
+      TimeOfImpact{ enterTime, normal }, ReturnState::RETURN_OK
+    };
+  }
+
+  static ReturnValue<TimeOfImpact> getAngularTimeOfImpact(
+      const Rectangle& rect0,
+      const RectangleMotion& motion0,
+      const Rectangle& rect1,
+      const RectangleMotion& motion1,
+      float maxTime)
+  {
+    // Conservative advancement. The separation along the axes of the
+    // rectangles is never more than the actual distance between them, and no
+    // point of one rectangle moves towards the other faster than maxSpeed.
+    // So, the rectangles can be advanced by separation / maxSpeed without
+    // them ever passing through each other.
+    float circumradius0 = std::hypot(rect0.width, rect0.height) / 2.f;
+    float circumradius1 = std::hypot(rect1.width, rect1.height) / 2.f;
+    float maxSpeed = std::hypot(motion1.velocity.x - motion0.velocity.x,
+                                motion1.velocity.y - motion0.velocity.y)
+                     + (std::fabs(degreesToRadians(motion0.angularVelocity))
+                        * circumradius0)
+                     + (std::fabs(degreesToRadians(motion1.angularVelocity))
+                        * circumradius1);
+    float contactTolerance = relativeContactTolerance
+                             * (circumradius0 + circumradius1);
+
+    float time = 0.f;
+    RectsSeparation separation;
+    for (int32_t step = 0; step < maxAdvancementSteps; step++) {
+      separation = getRectsSeparation(getSweptRect(rect0, motion0, time),
+                                      getSweptRect(rect1, motion1, time));
+      if (separation.distance <= contactTolerance) {
+        return ReturnValue<TimeOfImpact>{
+          TimeOfImpact{ time, separation.normal }, ReturnState::RETURN_OK
+        };
+      }
+
+      time += separation.distance / maxSpeed;
+      if (time > maxTime) {
+        return ReturnValue<TimeOfImpact>{
+          TimeOfImpact{}, ReturnState::RETURN_FAIL
+        };
+      }
+    }
+
+    return ReturnValue<TimeOfImpact>{
+      TimeOfImpact{ time, separation.normal }, ReturnState::RETURN_OK
+    };
+  }
+}
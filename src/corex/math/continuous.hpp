@@ -0,0 +1,54 @@
+#ifndef COREX_MATH_CONTINUOUS_HPP
+#define COREX_MATH_CONTINUOUS_HPP
+
+#include <cstdint>
+
+#include <EASTL/vector.h>
+
+#include <corex/math/ds.hpp>
+#include <corex/utils.hpp>
+
+namespace cx
+{
+  // Continuous collision detection of moving rectangles, so that fast
+  // rectangles can't pass through thin ones between two static tests.
+  //
+  // Rectangles move from where they are at time 0 up to maxTime, e.g. the
+  // duration of a frame if velocities are per second. The time of impact is
+  // the first time in [0, maxTime] at which the rectangles touch, and
+  // RETURN_FAIL is returned if they don't touch within it. Rectangles that
+  // already intersect at time 0 have a time of impact of 0 and a normal
+  // along the axis of least penetration.
+  //
+  // Without angular velocities, the time of impact is exact, since the
+  // projections of the rectangles onto their axes move linearly over time.
+  // With angular velocities, the rectangles are advanced towards each other
+  // by as much as they can be without touching, until they are close enough
+  // to be considered touching. That never skips over a contact, but can
+  // report one a bit early. It also gives up after a fixed number of steps,
+  // in which case a contact is reported at the time it got to, erring on the
+  // side of a collision rather than a rectangle tunneling through another.
+  ReturnValue<TimeOfImpact> getRectsTimeOfImpact(const Rectangle& rect0,
+                                                 const Vec2& velocity0,
+                                                 const Rectangle& rect1,
+                                                 const Vec2& velocity1,
+                                                 float maxTime);
+  ReturnValue<TimeOfImpact> getRectsTimeOfImpact(
+      const Rectangle& rect0,
+      const RectangleMotion& motion0,
+      const Rectangle& rect1,
+      const RectangleMotion& motion1,
+      float maxTime);
+
+  // Batch version. The i-th rectangle moves with the i-th motion. Whether the
+  // i-th pair touches is stored in hitMask, just like in the functions in
+  // batch.hpp, and its time of impact, if any, in timesOfImpact[i].
+  void getRectPairsTimesOfImpact(const eastl::vector<Rectangle>& rects,
+                                 const eastl::vector<RectangleMotion>& motions,
+                                 const eastl::vector<IndexPair>& pairs,
+                                 float maxTime,
+                                 eastl::vector<uint64_t>& hitMask,
+                                 eastl::vector<TimeOfImpact>& timesOfImpact);
+}
+
+#endif
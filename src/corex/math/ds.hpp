@@ -1,13 +1,36 @@
 #ifndef COREX_MATH_DS_HPP
 #define COREX_MATH_DS_HPP
 
+#include <corex/math/ds/AABB.hpp>
+#include <corex/math/ds/AABBTree.hpp>
 #include <corex/math/ds/Circle.hpp>
+#include <corex/math/ds/CircleBuffer.hpp>
+#include <corex/math/ds/FixedNPolygon.hpp>
+#include <corex/math/ds/IncrementalConvexHull.hpp>
+#include <corex/math/ds/IndexPair.hpp>
 #include <corex/math/ds/Line.hpp>
 #include <corex/math/ds/LineSegments.hpp>
 #include <corex/math/ds/NPolygon.hpp>
+#include <corex/math/ds/Penetration.hpp>
 #include <corex/math/ds/Point.hpp>
+#include <corex/math/ds/PointBuffer.hpp>
 #include <corex/math/ds/Polygon.hpp>
+#include <corex/math/ds/PolygonBuffer.hpp>
+#include <corex/math/ds/PolygonProperties.hpp>
+#include <corex/math/ds/PolygonWinding.hpp>
+#include <corex/math/ds/Polytope.hpp>
+#include <corex/math/ds/PreparedNPolygon.hpp>
+#include <corex/math/ds/PreparedRectangle.hpp>
+#include <corex/math/ds/QuantizedNPolygon.hpp>
 #include <corex/math/ds/Rectangle.hpp>
+#include <corex/math/ds/RectangleBuffer.hpp>
+#include <corex/math/ds/RectangleMotion.hpp>
+#include <corex/math/ds/Rotation.hpp>
+#include <corex/math/ds/SeparatingAxisCache.hpp>
+#include <corex/math/ds/Simplex.hpp>
+#include <corex/math/ds/TimeOfImpact.hpp>
+#include <corex/math/ds/TriangulationScratch.hpp>
+#include <corex/math/ds/UniformGrid.hpp>
 #include <corex/math/ds/Vec2.hpp>
 
 #endif
@@ -0,0 +1,17 @@
+#ifndef COREX_MATH_DS_AABB_HPP
+#define COREX_MATH_DS_AABB_HPP
+
+namespace cx
+{
+  struct AABB
+  {
+    // An axis-aligned bounding box. Unlike Rectangle, the box is described by
+    // its minimum and maximum corners, since that is what overlap tests need.
+    float minX;
+    float minY;
+    float maxX;
+    float maxY;
+  };
+}
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef COREX_MATH_DS_AABB_TREE_HPP
+#define COREX_MATH_DS_AABB_TREE_HPP
+
+#include <cstdint>
+
+#include <EASTL/vector.h>
+
+#include <corex/math/ds/AABB.hpp>
+
+namespace cx
+{
+  // Index used in place of a node index when there is no node, like a null
+  // pointer.
+  constexpr int32_t nullTreeNode = -1;
+
+  struct AABBTreeNode
+  {
+    // For leaves, this is the fat bounds, i.e. the bounds of the shape
+    // enlarged by the fat margin of the tree. For internal nodes, this is the
+    // union of the bounds of both children.
+    AABB bounds;
+
+    // When the node is in the free list, this is the index of the next free
+    // node instead.
+    int32_t parent;
+    int32_t child0;
+    int32_t child1;
+
+    // Leaves have a height of 0. Free nodes have a height of -1.
+    int32_t height;
+
+    // Index given by the caller when inserting a leaf. Unused for internal
+    // nodes.
+    int32_t userIndex;
+  };
+
+  struct AABBTree
+  {
+    // A dynamic bounding volume hierarchy. Nodes are stored in one contiguous
+    // pool and link to each other by index. Leaves are referred to by their
+    // node index, which stays the same until the leaf is removed.
+    eastl::vector<AABBTreeNode> nodes;
+    int32_t root = nullTreeNode;
+    int32_t freeList = nullTreeNode;
+
+    // How much the bounds of a shape get enlarged on each side when the shape
+    // is inserted. Moves that keep a shape within its enlarged bounds do not
+    // change the tree.
+    float fatMargin = 0.1f;
+  };
+}
+
+#endif
@@ -0,0 +1,19 @@
+#ifndef COREX_MATH_DS_CIRCLE_BUFFER_HPP
+#define COREX_MATH_DS_CIRCLE_BUFFER_HPP
+
+#include <EASTL/vector.h>
+
+namespace cx
+{
+  struct CircleBuffer
+  {
+    // A structure-of-arrays version of a list of Circles. The i-th circle is
+    // made up of the i-th element of each array. All arrays must have the
+    // same size. x and y refer to the center of a circle.
+    eastl::vector<float> x;
+    eastl::vector<float> y;
+    eastl::vector<float> radius;
+  };
+}
+
+#endif
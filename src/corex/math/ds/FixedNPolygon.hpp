@@ -0,0 +1,23 @@
+#ifndef COREX_MATH_DS_FIXED_NPOLYGON_HPP
+#define COREX_MATH_DS_FIXED_NPOLYGON_HPP
+
+#include <cstdint>
+
+#include <EASTL/fixed_vector.h>
+
+#include <corex/math/ds/Point.hpp>
+
+namespace cx
+{
+  template <uint32_t maxVertices>
+  struct FixedNPolygon
+  {
+    // Like an NPolygon, but with storage for up to maxVertices vertices inside
+    // the polygon itself, so that polygons whose number of vertices is known
+    // to be small never need a heap allocation. Going over maxVertices still
+    // works, but the vertices are then moved to the heap.
+    eastl::fixed_vector<Point, maxVertices> vertices;
+  };
+}
+
+#endif
@@ -0,0 +1,24 @@
+#ifndef COREX_MATH_DS_INCREMENTAL_CONVEX_HULL_HPP
+#define COREX_MATH_DS_INCREMENTAL_CONVEX_HULL_HPP
+
+#include <EASTL/vector.h>
+
+#include <corex/math/ds/Point.hpp>
+
+namespace cx
+{
+  struct IncrementalConvexHull
+  {
+    // The convex hull of all of the points added so far with
+    // addToConvexHull(). It is kept as the two chains that the monotone chain
+    // algorithm builds, each going from the leftmost point to the rightmost
+    // one, sorted by x and then by y. The lower chain is the one below the
+    // other in a y-up coordinate system. Both chains start and end with the
+    // same points. Clearing both chains empties the hull, but keeps their
+    // memory around for the next points.
+    eastl::vector<Point> lowerChain;
+    eastl::vector<Point> upperChain;
+  };
+}
+
+#endif
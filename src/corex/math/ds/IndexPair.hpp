@@ -0,0 +1,17 @@
+#ifndef COREX_MATH_DS_INDEX_PAIR_HPP
+#define COREX_MATH_DS_INDEX_PAIR_HPP
+
+#include <cstdint>
+
+namespace cx
+{
+  struct IndexPair
+  {
+    // Indices to two elements of the same (or, sometimes, two different)
+    // buffers, e.g. two rectangles that must be tested against each other.
+    int32_t first;
+    int32_t second;
+  };
+}
+
+#endif
@@ -7,10 +7,13 @@
 
 namespace cx
 {
-  struct LineSegments
+  template <typename Allocator = EASTLAllocatorType>
+  struct BasicLineSegments
   {
-    eastl::vector<Point> vertices;
+    eastl::vector<Point, Allocator> vertices;
   };
+
+  using LineSegments = BasicLineSegments<>;
 }
 
 #endif
@@ -7,13 +7,20 @@
 
 namespace cx
 {
-  struct NPolygon
+  template <typename Allocator = EASTLAllocatorType>
+  struct BasicNPolygon
   {
     // Sometimes, we don't know how many vertices a polygon have during
     // compile-time. So, we're going to use a polygon whose number of vertices
     // is only known during runtime.
-    eastl::vector<Point> vertices;
+    //
+    // The vertices can be stored using any EASTL allocator, such as the ones
+    // in corex/math/allocators.hpp, to keep short-lived polygons off the
+    // global heap.
+    eastl::vector<Point, Allocator> vertices;
   };
+
+  using NPolygon = BasicNPolygon<>;
 }
 
 #endif
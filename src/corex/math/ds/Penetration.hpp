@@ -0,0 +1,20 @@
+#ifndef COREX_MATH_DS_PENETRATION_HPP
+#define COREX_MATH_DS_PENETRATION_HPP
+
+#include <corex/math/ds/Vec2.hpp>
+
+namespace cx
+{
+  struct Penetration
+  {
+    // How deep two intersecting shapes are into each other. The normal is a
+    // unit vector that points from the first shape towards the second, like
+    // in TimeOfImpact, and moving the second shape by the penetration
+    // vector, i.e. the normal times the depth, separates the shapes.
+    Vec2 normal;
+    float depth;
+    Vec2 vector;
+  };
+}
+
+#endif
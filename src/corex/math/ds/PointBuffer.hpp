@@ -0,0 +1,18 @@
+#ifndef COREX_MATH_DS_POINT_BUFFER_HPP
+#define COREX_MATH_DS_POINT_BUFFER_HPP
+
+#include <EASTL/vector.h>
+
+namespace cx
+{
+  struct PointBuffer
+  {
+    // A structure-of-arrays version of a list of Points. The i-th point is
+    // made up of the i-th element of each array. Both arrays must have the
+    // same size.
+    eastl::vector<float> x;
+    eastl::vector<float> y;
+  };
+}
+
+#endif
@@ -0,0 +1,23 @@
+#ifndef COREX_MATH_DS_POLYGON_BUFFER_HPP
+#define COREX_MATH_DS_POLYGON_BUFFER_HPP
+
+#include <cstdint>
+
+#include <EASTL/vector.h>
+
+namespace cx
+{
+  struct PolygonBuffer
+  {
+    // A structure-of-arrays version of a list of polygons, with the vertices
+    // of all of the polygons stored back to back in x and y. The vertices of
+    // the i-th polygon are the ones in [offsets[i], offsets[i + 1]), so there
+    // is one more offset than there are polygons, and the last offset is the
+    // total number of vertices.
+    eastl::vector<float> x;
+    eastl::vector<float> y;
+    eastl::vector<int32_t> offsets;
+  };
+}
+
+#endif
@@ -0,0 +1,19 @@
+#ifndef COREX_MATH_DS_POLYGON_PROPERTIES_HPP
+#define COREX_MATH_DS_POLYGON_PROPERTIES_HPP
+
+#include <corex/math/ds/Point.hpp>
+#include <corex/math/ds/PolygonWinding.hpp>
+
+namespace cx
+{
+  struct PolygonProperties
+  {
+    // The signed area is positive for clockwise polygons, which is how our
+    // polygons are normally wound, and negative for counterclockwise ones.
+    double signedArea;
+    PolygonWinding winding;
+    Point centroid;
+  };
+}
+
+#endif
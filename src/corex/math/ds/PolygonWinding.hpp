@@ -0,0 +1,18 @@
+#ifndef COREX_MATH_DS_POLYGON_WINDING_HPP
+#define COREX_MATH_DS_POLYGON_WINDING_HPP
+
+namespace cx
+{
+  // The direction the vertices of a polygon go around in, as seen on screen,
+  // i.e. with the origin in the top-left corner and y pointing down. Polygons
+  // whose vertices are all on a line, or whose parts cancel each other out,
+  // have no winding.
+  enum class PolygonWinding
+  {
+    CLOCKWISE,
+    COUNTERCLOCKWISE,
+    DEGENERATE
+  };
+}
+
+#endif
@@ -0,0 +1,37 @@
+#ifndef COREX_MATH_DS_POLYTOPE_HPP
+#define COREX_MATH_DS_POLYTOPE_HPP
+
+#include <cstdint>
+
+#include <EASTL/fixed_vector.h>
+
+namespace cx
+{
+  struct PolytopeVertex
+  {
+    double x;
+    double y;
+  };
+
+  struct PolytopeEdge
+  {
+    // Edge i goes from vertex i to the next one. The normal is a unit
+    // vector pointing out of the polytope, and the distance is the one from
+    // the origin to the line of the edge.
+    int32_t index;
+    double normalX;
+    double normalY;
+    double distance;
+  };
+
+  struct Polytope
+  {
+    // The polygon that EPA grows inside of the Minkowski difference of two
+    // shapes. It contains the origin, and its vertices go counterclockwise
+    // in a y-up coordinate system. Most shapes only need a few vertices, so
+    // they are stored inside the polytope itself.
+    eastl::fixed_vector<PolytopeVertex, 32> vertices;
+  };
+}
+
+#endif
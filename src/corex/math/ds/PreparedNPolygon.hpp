@@ -0,0 +1,39 @@
+#ifndef COREX_MATH_DS_PREPARED_NPOLYGON_HPP
+#define COREX_MATH_DS_PREPARED_NPOLYGON_HPP
+
+#include <cstdint>
+
+#include <EASTL/vector.h>
+
+#include <corex/math/ds/AABB.hpp>
+#include <corex/math/ds/Line.hpp>
+#include <corex/math/ds/NPolygon.hpp>
+#include <corex/math/ds/Vec2.hpp>
+
+namespace cx
+{
+  struct PreparedNPolygon
+  {
+    // A polygon along with an index of its edges, so that queries only need
+    // to look at the edges near the query shape. Create one with
+    // prepareNPolygon(). Queries do not modify it, so one prepared polygon
+    // can be shared by several threads.
+    NPolygon polygon;
+    AABB bounds;
+
+    // Edge i goes from vertex i to vertex i + 1, wrapping around.
+    eastl::vector<Line> edges;
+    eastl::vector<AABB> edgeBounds;
+    eastl::vector<Vec2> edgeNormals;
+
+    // The bounds of the polygon are cut into horizontal slabs of the same
+    // height. The edges overlapping slab i are in slabEdges, from
+    // slabEdgeOffsets[i] up to, but not including, slabEdgeOffsets[i + 1].
+    float slabHeight;
+    int32_t numSlabs;
+    eastl::vector<int32_t> slabEdgeOffsets;
+    eastl::vector<int32_t> slabEdges;
+  };
+}
+
+#endif
@@ -0,0 +1,50 @@
+#ifndef COREX_MATH_DS_PREPARED_RECTANGLE_HPP
+#define COREX_MATH_DS_PREPARED_RECTANGLE_HPP
+
+#include <cmath>
+
+#include <corex/math/ds/Line.hpp>
+#include <corex/math/ds/Polygon.hpp>
+#include <corex/math/ds/Rectangle.hpp>
+#include <corex/math/ds/Rotation.hpp>
+#include <corex/math/ds/Vec2.hpp>
+
+namespace cx
+{
+  struct PreparedRectangle
+  {
+    // A rectangle along with the data that geometry functions derive from it,
+    // so that the data is only computed once for rectangles that are queried
+    // a lot but rarely change, like static level geometry. Create one with
+    // prepareRectangle().
+    //
+    // The fields of rect may be changed freely, as long as
+    // updatePreparedRectangle() is called afterwards to recompute the rest of
+    // the fields. Functions that take a PreparedRectangle never change it,
+    // so one can be shared between threads. If rect no longer matches
+    // preparedRect, they compute what they need from rect instead, like the
+    // functions that take a plain Rectangle do.
+    Rectangle rect{};
+
+    // The version of rect that the fields below were computed from. NaN
+    // until the fields are first computed, so that it never matches rect.
+    Rectangle preparedRect{ NAN, NAN, NAN, NAN, NAN };
+    Rotation rotation;
+
+    // Same as the result of rotateRectangle(preparedRect).
+    Polygon<4> vertices;
+
+    // The x and y axes of the rectangle, and the projection of the rectangle
+    // onto each of them.
+    Vec2 axisX;
+    Vec2 axisY;
+    Line projectionX;
+    Line projectionY;
+
+    // Half of the width and the height of preparedRect.
+    float halfWidth;
+    float halfHeight;
+  };
+}
+
+#endif
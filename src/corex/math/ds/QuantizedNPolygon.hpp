@@ -0,0 +1,32 @@
+#ifndef COREX_MATH_DS_QUANTIZED_NPOLYGON_HPP
+#define COREX_MATH_DS_QUANTIZED_NPOLYGON_HPP
+
+#include <EASTL/vector.h>
+
+#include <corex/math/ds/Point.hpp>
+
+namespace cx
+{
+  template <typename Coord>
+  struct QuantizedPoint
+  {
+    Coord x;
+    Coord y;
+  };
+
+  template <typename Coord>
+  struct QuantizedNPolygon
+  {
+    // A compact version of an NPolygon for large, static geometry. Vertices
+    // are stored as integer offsets from an origin, in units of scale, so the
+    // i-th vertex is at origin + (vertices[i] * scale). Coord is either
+    // int16_t or int32_t, which takes a half or the same amount of memory as
+    // float coordinates, respectively. Polygons in the same chunk of a level
+    // may share the same origin and scale.
+    Point origin;
+    float scale;
+    eastl::vector<QuantizedPoint<Coord>> vertices;
+  };
+}
+
+#endif
@@ -0,0 +1,22 @@
+#ifndef COREX_MATH_DS_RECTANGLE_BUFFER_HPP
+#define COREX_MATH_DS_RECTANGLE_BUFFER_HPP
+
+#include <EASTL/vector.h>
+
+namespace cx
+{
+  struct RectangleBuffer
+  {
+    // A structure-of-arrays version of a list of Rectangles. The i-th
+    // rectangle is made up of the i-th element of each array. All arrays must
+    // have the same size. Just like in Rectangle, x and y refer to the center
+    // of a rectangle, and angle is in degrees.
+    eastl::vector<float> x;
+    eastl::vector<float> y;
+    eastl::vector<float> width;
+    eastl::vector<float> height;
+    eastl::vector<float> angle;
+  };
+}
+
+#endif
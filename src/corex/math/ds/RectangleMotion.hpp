@@ -0,0 +1,18 @@
+#ifndef COREX_MATH_DS_RECTANGLE_MOTION_HPP
+#define COREX_MATH_DS_RECTANGLE_MOTION_HPP
+
+#include <corex/math/ds/Vec2.hpp>
+
+namespace cx
+{
+  struct RectangleMotion
+  {
+    // How a rectangle moves over time. The center of the rectangle moves by
+    // velocity per unit of time, and the rectangle rotates around its center
+    // by angularVelocity degrees per unit of time.
+    Vec2 velocity;
+    float angularVelocity;
+  };
+}
+
+#endif
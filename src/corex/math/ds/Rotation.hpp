@@ -0,0 +1,16 @@
+#ifndef COREX_MATH_DS_ROTATION_HPP
+#define COREX_MATH_DS_ROTATION_HPP
+
+namespace cx
+{
+  struct Rotation
+  {
+    // The cosine and sine of an angle. Rotating by the same angle many times
+    // with this only requires computing them once. Use rotationFromAngle() to
+    // create one from an angle in degrees.
+    float cosine;
+    float sine;
+  };
+}
+
+#endif
@@ -0,0 +1,41 @@
+#ifndef COREX_MATH_DS_SEPARATING_AXIS_CACHE_HPP
+#define COREX_MATH_DS_SEPARATING_AXIS_CACHE_HPP
+
+#include <cstdint>
+
+#include <EASTL/vector.h>
+
+namespace cx
+{
+  struct SeparatingAxisCacheEntry
+  {
+    // The ID given by the caller for a pair of shapes.
+    uint64_t pairID;
+
+    // The frame the entry was last used in. 0 for an empty slot.
+    uint32_t lastUsedFrame;
+
+    // The axis that separated the pair the last time it was tested, or -1 if
+    // the pair was in contact. The meaning of the rest depends on the kind
+    // of test, e.g. for two rectangles it is 0 and 1 for the x and y axes of
+    // the first rectangle, and 2 and 3 for those of the second one.
+    int32_t axis;
+  };
+
+  struct SeparatingAxisCache
+  {
+    // An open addressing hash table, with linear probing, from pair IDs to
+    // the last result of testing the pair. It is only ever a hint, so results
+    // are the same with or without it, and a pair that is not in it yet just
+    // gets tested the usual way.
+    //
+    // The number of slots is 0 or a power of 2, and is doubled when the
+    // table gets more than 3/4 full. Entries that have not been used for a
+    // while are removed by evictStaleSeparatingAxes().
+    eastl::vector<SeparatingAxisCacheEntry> entries;
+    int32_t numEntries = 0;
+    uint32_t frame = 1;
+  };
+}
+
+#endif
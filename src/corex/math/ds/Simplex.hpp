@@ -0,0 +1,35 @@
+#ifndef COREX_MATH_DS_SIMPLEX_HPP
+#define COREX_MATH_DS_SIMPLEX_HPP
+
+#include <cstdint>
+
+#include <EASTL/array.h>
+
+#include <corex/math/ds/Point.hpp>
+
+namespace cx
+{
+  struct SimplexVertex
+  {
+    // A vertex of the Minkowski difference of two shapes, i.e. the support
+    // point of the second shape minus the one of the first shape, and its
+    // barycentric weight in the point of the simplex closest to the origin.
+    Point support0;
+    Point support1;
+    double x;
+    double y;
+    double weight;
+  };
+
+  struct Simplex
+  {
+    // The simplex that GJK keeps, which is a point, a segment or a
+    // triangle, and its point that is the closest to the origin.
+    eastl::array<SimplexVertex, 3> vertices;
+    int32_t numVertices;
+    double closestX;
+    double closestY;
+  };
+}
+
+#endif
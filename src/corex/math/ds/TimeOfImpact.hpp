@@ -0,0 +1,17 @@
+#ifndef COREX_MATH_DS_TIME_OF_IMPACT_HPP
+#define COREX_MATH_DS_TIME_OF_IMPACT_HPP
+
+#include <corex/math/ds/Vec2.hpp>
+
+namespace cx
+{
+  struct TimeOfImpact
+  {
+    // The time at which two moving shapes first touch, and the unit normal
+    // of the contact, which points from the first shape towards the second.
+    float time;
+    Vec2 normal;
+  };
+}
+
+#endif
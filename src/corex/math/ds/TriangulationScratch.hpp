@@ -0,0 +1,41 @@
+#ifndef COREX_MATH_DS_TRIANGULATION_SCRATCH_HPP
+#define COREX_MATH_DS_TRIANGULATION_SCRATCH_HPP
+
+#include <cstdint>
+
+#include <EASTL/vector.h>
+
+namespace cx
+{
+  struct TriangulationNode
+  {
+    // A vertex of the part of the polygon that has not been cut off yet.
+    // Nodes are linked into a ring along the polygon, into either a ring of
+    // the ones that might be ears or a list of the ones blocked by the same
+    // vertex, and, for big polygons, into a list sorted by z-order, all
+    // through indices into the nodes. Links that point nowhere are -1.
+    double x;
+    double y;
+    uint32_t z;
+    int32_t vertex;
+    int32_t prev;
+    int32_t next;
+    int32_t prevCandidate;
+    int32_t nextCandidate;
+    int32_t blocker;
+    int32_t firstBlocked;
+    int32_t prevZ;
+    int32_t nextZ;
+  };
+
+  struct TriangulationScratch
+  {
+    // Memory used by triangulatePolygon(). It can be reused across calls, in
+    // which case it only gets allocated when a polygon needs more of it than
+    // any polygon before did.
+    eastl::vector<TriangulationNode> nodes;
+    eastl::vector<int32_t> zOrderedNodes;
+  };
+}
+
+#endif
@@ -0,0 +1,70 @@
+#ifndef COREX_MATH_DS_UNIFORM_GRID_HPP
+#define COREX_MATH_DS_UNIFORM_GRID_HPP
+
+#include <cstdint>
+
+#include <EASTL/vector.h>
+
+#include <corex/math/ds/AABB.hpp>
+
+namespace cx
+{
+  struct GridProxy
+  {
+    AABB bounds;
+
+    // Range of cells, inclusive, that the bounds of the proxy overlap.
+    int32_t minCellX;
+    int32_t minCellY;
+    int32_t maxCellX;
+    int32_t maxCellY;
+
+    // Index given by the caller when inserting the proxy. This is what gets
+    // reported in candidate pairs, so it can be the index of the shape in the
+    // caller's own buffers.
+    int32_t userIndex;
+    bool isActive;
+  };
+
+  struct GridCellEntry
+  {
+    int32_t proxyID;
+
+    // Index of the next entry in the same cell, or -1 for the last one.
+    int32_t nextEntryID;
+  };
+
+  struct GridCell
+  {
+    // The x index of the cell in the upper half, and the y index in the
+    // lower half.
+    uint64_t cellKey;
+
+    // Index of the first entry in the cell, or -1 for an empty slot.
+    int32_t firstEntryID;
+  };
+
+  struct UniformGrid
+  {
+    // A spatial hash of shapes over a uniform grid of square cells. All data
+    // is kept in flat arrays. Proxies are referred to by their index in
+    // proxies, and removed proxies are recycled.
+    float cellSize = 1.f;
+    eastl::vector<GridProxy> proxies;
+    eastl::vector<int32_t> freeProxyIDs;
+
+    // Every (cell, proxy) combination, as a list of entries per occupied
+    // cell. Only the entries of the cells that a proxy left or entered change
+    // when it moves. Removed entries are recycled.
+    //
+    // The occupied cells are in an open addressing hash table, with linear
+    // probing, like SeparatingAxisCache. The number of slots is 0 or a power
+    // of 2, and is doubled when the table gets more than 3/4 full.
+    eastl::vector<GridCell> cells;
+    int32_t numCells = 0;
+    eastl::vector<GridCellEntry> cellEntries;
+    eastl::vector<int32_t> freeCellEntryIDs;
+  };
+}
+
+#endif
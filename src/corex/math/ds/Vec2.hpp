@@ -1,6 +1,8 @@
 #ifndef COREX_MATH_DS_VEC2_HPP
 #define COREX_MATH_DS_VEC2_HPP
 
+#include <corex/math/algebra.hpp>
+
 namespace cx
 {
   struct Vec2
@@ -8,19 +10,70 @@ namespace cx
     float x;
     float y;
 
-    Vec2();
-    Vec2(float x, float y);
-    Vec2(const Vec2& rhs);
+    constexpr Vec2()
+      : x()
+      , y() {}
+
+    constexpr Vec2(float x, float y)
+      : x(x)
+      , y(y) {}
+
+    constexpr Vec2(const Vec2& rhs) = default;
   };
 
-  Vec2 operator+(const Vec2& p, const Vec2& q);
-  Vec2 operator-(const Vec2& p, const Vec2& q);
-  Vec2 operator*(const Vec2& p, const int& a);
-  Vec2 operator*(const Vec2& p, const float& a);
-  Vec2 operator*(const int& a, const Vec2& p);
-  Vec2 operator*(const float& a, const Vec2& p);
-  Vec2 operator/(const Vec2& p, const int& a);
-  Vec2 operator/(const Vec2& p, const float& a);
+  // These are defined here, rather than in a source file, so that they can be
+  // inlined into loops and used in constant expressions.
+  inline constexpr Vec2 operator+(const Vec2& p, const Vec2& q)
+  {
+    return Vec2{ setDecPlaces(p.x + q.x, 6), setDecPlaces(p.y + q.y, 6) };
+  }
+
+  inline constexpr Vec2 operator-(const Vec2& p, const Vec2& q)
+  {
+    return Vec2{ setDecPlaces(p.x - q.x, 6), setDecPlaces(p.y - q.y, 6) };
+  }
+
+  inline constexpr Vec2 operator*(const Vec2& p, const int& a)
+  {
+    return Vec2{
+      setDecPlaces(p.x * static_cast<float>(a), 6),
+      setDecPlaces(p.y * static_cast<float>(a), 6)
+    };
+  }
+
+  inline constexpr Vec2 operator*(const Vec2& p, const float& a)
+  {
+    return Vec2{ setDecPlaces(p.x * a, 6), setDecPlaces(p.y * a, 6) };
+  }
+
+  inline constexpr Vec2 operator*(const int& a, const Vec2& p)
+  {
+    return Vec2{
+      setDecPlaces(static_cast<float>(a) * p.x, 6),
+      setDecPlaces(static_cast<float>(a) * p.y, 6)
+    };
+  }
+
+  inline constexpr Vec2 operator*(const float& a, const Vec2& p)
+  {
+    return Vec2{
+      setDecPlaces(a * p.x, 6),
+      setDecPlaces(a * p.y, 6)
+    };
+  }
+
+  inline constexpr Vec2 operator/(const Vec2& p, const int& a)
+  {
+    return Vec2{
+      setDecPlaces(p.x / static_cast<float>(a), 6),
+      setDecPlaces(p.y / static_cast<float>(a), 6)
+    };
+  }
+
+  inline constexpr Vec2 operator/(const Vec2& p, const float& a)
+  {
+    return Vec2{ setDecPlaces(p.x / a, 6), setDecPlaces(p.y / a, 6) };
+  }
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,110 @@
+#include <cmath>
+
+#include <corex/math/ds.hpp>
+#include <corex/math/fast.hpp>
+#include <corex/math/geometry.hpp>
+#include <corex/math/linear_algebra.hpp>
+
+namespace cx::fast
+{
+  Vec2 add(const Vec2& p, const Vec2& q)
+  {
+    return Vec2{ p.x + q.x, p.y + q.y };
+  }
+
+  Vec2 subtract(const Vec2& p, const Vec2& q)
+  {
+    return Vec2{ p.x - q.x, p.y - q.y };
+  }
+
+  Vec2 multiply(const Vec2& p, float a)
+  {
+    return Vec2{ p.x * a, p.y * a };
+  }
+
+  Vec2 multiply(float a, const Vec2& p)
+  {
+    return Vec2{ a * p.x, a * p.y };
+  }
+
+  Vec2 divide(const Vec2& p, float a)
+  {
+    return Vec2{ p.x / a, p.y / a };
+  }
+
+  float vec2Magnitude(const Vec2& p)
+  {
+    return std::sqrt((p.x * p.x) + (p.y * p.y));
+  }
+
+  Vec2 rotateVec2(const Vec2& p, float angle)
+  {
+    // The angle parameter is expected to be in degrees, just like in
+    // cx::rotateVec2().
+    Rotation rotation = rotationFromAngle(angle);
+    return Vec2{
+      (p.x * rotation.cosine) - (p.y * rotation.sine),
+      (p.x * rotation.sine) + (p.y * rotation.cosine)
+    };
+  }
+
+  Vec2 projectVec2(const Vec2& p, const Vec2& q)
+  {
+    return fast::multiply(dotProduct(p, q) / dotProduct(q, q), q);
+  }
+
+  Vec2 vec2Perp(const Vec2& p)
+  {
+    // cx::vec2Perp() rotates the vector by -90 degrees. Doing that with
+    // cos() and sin() only adds rounding errors, so let's just swap.
+    return Vec2{ p.y, -p.x };
+  }
+
+  Vec2 unitVector(const Vec2& vec)
+  {
+    return fast::divide(vec, fast::vec2Magnitude(vec));
+  }
+
+  Vec2 lineDirectionVector(const Line& line)
+  {
+    return fast::unitVector(lineToVec(line));
+  }
+
+  Vec2 lineNormalVector(const Line& line)
+  {
+    // See cx::lineNormalVector() for why this is a -90 degree rotation.
+    return fast::vec2Perp(fast::lineDirectionVector(line));
+  }
+
+  float signedDistPointToInfLine(const Point& point, const Line& line)
+  {
+    return dotProduct(fast::lineNormalVector(line),
+                      fast::subtract(point, line.end));
+  }
+
+  Polygon<4> rotateRectangle(const Rectangle& rect)
+  {
+    // NOTE: Angle is expected to be in degrees.
+    Rotation rotation = rotationFromAngle(rect.angle);
+    float halfWidth = rect.width / 2.f;
+    float halfHeight = rect.height / 2.f;
+
+    // The corners are rotated around the center of the rectangle, and are in
+    // the same order as the ones from cx::rotateRectangle().
+    auto rotateCorner = [&](float offsetX, float offsetY) {
+      return Point{
+        rect.x + ((offsetX * rotation.cosine) - (offsetY * rotation.sine)),
+        rect.y + ((offsetX * rotation.sine) + (offsetY * rotation.cosine))
+      };
+    };
+
+    return Polygon<4>{
+        {
+            rotateCorner(-halfWidth, -halfHeight),
+            rotateCorner(halfWidth, -halfHeight),
+            rotateCorner(halfWidth, halfHeight),
+            rotateCorner(-halfWidth, halfHeight)
+        }
+    };
+  }
+}
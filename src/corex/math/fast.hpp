@@ -0,0 +1,62 @@
+#ifndef COREX_MATH_FAST_HPP
+#define COREX_MATH_FAST_HPP
+
+#include <corex/math/ds.hpp>
+
+// Versions of the Vec2 operators and linear algebra functions that do not
+// snap their results to a fixed number of decimal places via setDecPlaces().
+//
+// The functions in cx, outside of this namespace, round every component of
+// their results to 6 decimal places (4 for signedDistPointToInfLine()) so that
+// their results are deterministic enough to be compared and hashed. This
+// rounding is expensive in hot loops, so callers that do not need it can use
+// the functions here instead.
+//
+// Error bounds:
+//   The bounds below are on the difference between a function here and its cx
+//   counterpart, per result component. eps is FLT_EPSILON, and M is the
+//   largest absolute component of the inputs named for each function. The
+//   constant term comes from the decimal place snapping of the cx version,
+//   and the eps term from the float rounding of both versions, including that
+//   of the snapping itself, which dominates for large components. They hold
+//   for components that are zero or at least 1e-3 in magnitude, since the cx
+//   versions round squared components below the corex-utils float tolerance
+//   to zero.
+//   - add(), subtract(): 5e-7 + 4 eps M, with M over both vectors.
+//   - multiply(), divide(): 5e-7 + 2 eps M, with M over the result.
+//   - vec2Magnitude(): none, since neither version snaps it.
+//   - rotateVec2(), projectVec2(), vec2Perp(): 5e-7 + 6 eps M, with M over p.
+//     vec2Perp() is itself exact, since it only swaps and negates
+//     components, but cx::vec2Perp() rotates p by -90 degrees.
+//   - unitVector(), lineDirectionVector(), lineNormalVector(): 1e-6.
+//   - signedDistPointToInfLine(): 5.1e-5 + 24 eps M, with M over the point
+//     and the end of the line. The cx version snaps the distance to 4
+//     decimal places, and the vector from the line to the point to 6.
+//   - rotateRectangle(): 5e-7 + 6 eps M, with M over the position and the
+//     size of the rectangle.
+//   tests/fast.cpp checks these bounds on random inputs.
+//
+// NOTE: Since Vec2 is in cx, argument-dependent lookup will also find the cx
+//       versions of these functions. Calls to them must be qualified, e.g.
+//       fast::rotateVec2(p, angle).
+namespace cx::fast
+{
+  Vec2 add(const Vec2& p, const Vec2& q);
+  Vec2 subtract(const Vec2& p, const Vec2& q);
+  Vec2 multiply(const Vec2& p, float a);
+  Vec2 multiply(float a, const Vec2& p);
+  Vec2 divide(const Vec2& p, float a);
+
+  float vec2Magnitude(const Vec2& p);
+  Vec2 rotateVec2(const Vec2& p, float angle);
+  Vec2 projectVec2(const Vec2& p, const Vec2& q);
+  Vec2 vec2Perp(const Vec2& p);
+  Vec2 unitVector(const Vec2& vec);
+  Vec2 lineDirectionVector(const Line& line);
+  Vec2 lineNormalVector(const Line& line);
+
+  float signedDistPointToInfLine(const Point& point, const Line& line);
+  Polygon<4> rotateRectangle(const Rectangle& rect);
+}
+
+#endif
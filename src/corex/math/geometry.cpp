@@ -1,37 +1,80 @@
+#include <cfloat>
 #include <cmath>
+#include <cstdint>
+
+#include <EASTL/algorithm.h>
+#include <EASTL/fixed_vector.h>
+#include <EASTL/numeric_limits.h>
+#include <EASTL/vector.h>
 
 #include <corex/utils.hpp>
 #include <corex/math/algebra.hpp>
+#include <corex/math/coherence.hpp>
 #include <corex/math/constants.hpp>
 #include <corex/math/ds.hpp>
 #include <corex/math/geometry.hpp>
+#include <corex/math/instrumentation.hpp>
 #include <corex/math/linear_algebra.hpp>
 #include <corex/math/utils.hpp>
 
 namespace cx
 {
-  float degreesToRadians(float degrees)
-  {
-    return static_cast<float>(degrees * (pi / 180.0));
-  }
-
-  float radiansToDegrees(float radians)
-  {
-    return static_cast<float>(radians * (180.0 / pi));
-  }
+  static bool areTwoProjectionsOverlapping(const Line& projLine0,
+                                           const Line& projLine1);
+  static bool isPreparedRectangleStale(const PreparedRectangle& prepared);
+  static Polygon<4> getPreparedRectangleVertices(
+      const PreparedRectangle& prepared);
+  static Vec2 getRectPairAxis(const Rotation& rotation0,
+                              const Rotation& rotation1,
+                              int32_t axis);
+  static bool arePreparedRectsOverlappingInAnAxis(
+      const PreparedRectangle& rect0,
+      const PreparedRectangle& rect1,
+      int32_t axis);
+  static bool areTwoRotatedRectsIntersecting(const Rectangle& rect0,
+                                             const Rotation& rotation0,
+                                             const Rectangle& rect1,
+                                             const Rotation& rotation1);
+  static bool areTwoRotatedRectsIntersecting(const Rectangle& rect0,
+                                             const Rotation& rotation0,
+                                             const Rectangle& rect1,
+                                             const Rotation& rotation1,
+                                             SeparatingAxisCache& cache,
+                                             uint64_t pairID);
+  static void clippedPolygonFromTwoRectPolygons(
+      const Polygon<4>& targetRectPoly,
+      const Polygon<4>& clippingRectPoly,
+      FixedNPolygon<8>& clippedPolygon);
+  static bool isRectPolygonWithinNPolygon(const Polygon<4>& rectPoly,
+                                          const NPolygon& polygon);
+  static bool isRectPolygonIntersectingNPolygon(const Polygon<4>& rectPoly,
+                                                const NPolygon& polygon);
+  static float squaredDistPointToRect(const Point& point,
+                                      const Rectangle& rect);
+  static float squaredDistPointToLine(const Point& point, const Line& line);
+  static float squaredDistPointToNPolygonEdges(const Point& point,
+                                               const Point* vertices,
+                                               int32_t numVertices);
+#if defined(COREX_MATH_BOUNDING_CIRCLE_EARLY_OUT)
+  static bool areRectBoundingCirclesApart(const Rectangle& rect0,
+                                          const Rectangle& rect1);
+#endif
 
   float distance2D(const Point& start, const Point& end)
   {
+    COREX_MATH_INSTRUMENT(distance2D);
     return sqrt(cx::pow(end.x - start.x, 2) + cx::pow(end.y - start.y, 2));
   }
 
   float lineLength(const Line& line)
   {
+    COREX_MATH_INSTRUMENT(lineLength);
     return distance2D(line.start, line.end);
   }
 
   float signedDistPointToInfLine(const Point& point, const Line& line)
   {
+    COREX_MATH_INSTRUMENT(signedDistPointToInfLine);
     return setDecPlaces(dotProduct(lineNormalVector(line), (point - line.end)),
                         4);
   }
@@ -40,6 +83,14 @@ namespace cx
                              float height, float angle)
   {
     // NOTE: Angle is expected to be in degrees.
+    return rotateRectangle(centerX, centerY, width, height,
+                           rotationFromAngle(angle));
+  }
+
+  Polygon<4> rotateRectangle(float centerX, float centerY, float width,
+                             float height, const Rotation& rotation)
+  {
+    COREX_MATH_INSTRUMENT(rotateRectangle);
     Point topLeftPt = Point{centerX - (width / 2.f), centerY - (height / 2.f)};
     Point topRightPt = Point{topLeftPt.x + width, topLeftPt.y};
     Point bottomLeftPt = Point{topLeftPt.x, topLeftPt.y + height};
@@ -54,10 +105,10 @@ namespace cx
                                               -centerX,
                                               -centerY);
 
-    Point rotatedTopLeftPt = rotatePoint(transTopLeftPt, angle);
-    Point rotatedTopRightPt = rotatePoint(transTopRightPt, angle);
-    Point rotatedBottomLeftPt = rotatePoint(transBottomLeftPt, angle);
-    Point rotatedBottomRightPt = rotatePoint(transBottomRightPt, angle);
+    Point rotatedTopLeftPt = rotatePoint(transTopLeftPt, rotation);
+    Point rotatedTopRightPt = rotatePoint(transTopRightPt, rotation);
+    Point rotatedBottomLeftPt = rotatePoint(transBottomLeftPt, rotation);
+    Point rotatedBottomRightPt = rotatePoint(transBottomRightPt, rotation);
 
     return Polygon<4>{
         {
@@ -75,13 +126,37 @@ namespace cx
     return rotateRectangle(rect.x, rect.y, rect.width, rect.height, rect.angle);
   }
 
+  Polygon<4> rotateRectangle(const Rectangle& rect, const Rotation& rotation)
+  {
+    return rotateRectangle(rect.x, rect.y, rect.width, rect.height, rotation);
+  }
+
+  bool areTwoRectsIntersectingInAnAxis(const Rectangle& rect0,
+                                       const Rectangle& rect1,
+                                       const Vec2& axis)
+  {
+    return areTwoRectsIntersectingInAnAxis(rect0,
+                                           rotationFromAngle(rect0.angle),
+                                           rect1,
+                                           rotationFromAngle(rect1.angle),
+                                           axis);
+  }
+
   bool areTwoRectsIntersectingInAnAxis(const Rectangle& rect0,
+                                       const Rotation& rotation0,
                                        const Rectangle& rect1,
+                                       const Rotation& rotation1,
                                        const Vec2& axis)
   {
-    Line projLine0 = projectRectToAnAxis(rect0, axis);
-    Line projLine1 = projectRectToAnAxis(rect1, axis);
+    COREX_MATH_INSTRUMENT(areTwoRectsIntersectingInAnAxis);
+    return areTwoProjectionsOverlapping(
+        projectRectToAnAxis(rect0, rotation0, axis),
+        projectRectToAnAxis(rect1, rotation1, axis));
+  }
 
+  static bool areTwoProjectionsOverlapping(const Line& projLine0,
+                                           const Line& projLine1)
+  {
     // We need to find the line that merges both segments together (whether
     // or not they are intersecting). We could have used a loop here for
     // generalization, but we don't need to do so for now. So, no loops.
@@ -109,21 +184,238 @@ namespace cx
 
   bool areTwoRectsIntersecting(const Rectangle& rect0, const Rectangle& rect1)
   {
-    // Oh, boy. Let's do some SAT (Separating Axis Theorem)!
-    Vec2 axisX0 = rotateVec2(Vec2{1.f, 0.f}, rect0.angle);
-    Vec2 axisY0 = rotateVec2(Vec2{0.f, 1.f}, rect0.angle);
-    Vec2 axisX1 = rotateVec2(Vec2{1.f, 0.f}, rect1.angle);
-    Vec2 axisY1 = rotateVec2(Vec2{0.f, 1.f}, rect1.angle);
+    COREX_MATH_INSTRUMENT(areTwoRectsIntersecting);
+#if defined(COREX_MATH_BOUNDING_CIRCLE_EARLY_OUT)
+    if (areRectBoundingCirclesApart(rect0, rect1)) {
+      return false;
+    }
+#endif
+
+    return areTwoRotatedRectsIntersecting(
+        rect0, rotationFromAngle(rect0.angle),
+        rect1, rotationFromAngle(rect1.angle));
+  }
+
+  bool areTwoRectsIntersecting(const Rectangle& rect0,
+                               const Rotation& rotation0,
+                               const Rectangle& rect1,
+                               const Rotation& rotation1)
+  {
+    COREX_MATH_INSTRUMENT(areTwoRectsIntersecting);
+#if defined(COREX_MATH_BOUNDING_CIRCLE_EARLY_OUT)
+    if (areRectBoundingCirclesApart(rect0, rect1)) {
+      return false;
+    }
+#endif
+
+    return areTwoRotatedRectsIntersecting(rect0, rotation0, rect1, rotation1);
+  }
+
+  bool areTwoRectsIntersecting(const PreparedRectangle& rect0,
+                               const PreparedRectangle& rect1)
+  {
+    COREX_MATH_INSTRUMENT(areTwoRectsIntersecting);
+#if defined(COREX_MATH_BOUNDING_CIRCLE_EARLY_OUT)
+    if (areRectBoundingCirclesApart(rect0.rect, rect1.rect)) {
+      return false;
+    }
+#endif
+
+    // Rectangles whose rect was changed without updating them are tested like
+    // plain Rectangles, which gives the same result.
+    if (isPreparedRectangleStale(rect0) || isPreparedRectangleStale(rect1)) {
+      return areTwoRotatedRectsIntersecting(
+          rect0.rect, rotationFromAngle(rect0.rect.angle),
+          rect1.rect, rotationFromAngle(rect1.rect.angle));
+    }
+
+    return arePreparedRectsOverlappingInAnAxis(rect0, rect1, 0)
+           && arePreparedRectsOverlappingInAnAxis(rect0, rect1, 1)
+           && arePreparedRectsOverlappingInAnAxis(rect0, rect1, 2)
+           && arePreparedRectsOverlappingInAnAxis(rect0, rect1, 3);
+  }
+
+  bool areTwoRectsIntersecting(const Rectangle& rect0,
+                               const Rectangle& rect1,
+                               SeparatingAxisCache& cache,
+                               uint64_t pairID)
+  {
+    COREX_MATH_INSTRUMENT(areTwoRectsIntersecting);
+#if defined(COREX_MATH_BOUNDING_CIRCLE_EARLY_OUT)
+    if (areRectBoundingCirclesApart(rect0, rect1)) {
+      return false;
+    }
+#endif
+
+    return areTwoRotatedRectsIntersecting(
+        rect0, rotationFromAngle(rect0.angle),
+        rect1, rotationFromAngle(rect1.angle),
+        cache, pairID);
+  }
+
+  bool areTwoRectsIntersecting(const Rectangle& rect0,
+                               const Rotation& rotation0,
+                               const Rectangle& rect1,
+                               const Rotation& rotation1,
+                               SeparatingAxisCache& cache,
+                               uint64_t pairID)
+  {
+    COREX_MATH_INSTRUMENT(areTwoRectsIntersecting);
+#if defined(COREX_MATH_BOUNDING_CIRCLE_EARLY_OUT)
+    if (areRectBoundingCirclesApart(rect0, rect1)) {
+      return false;
+    }
+#endif
+
+    return areTwoRotatedRectsIntersecting(rect0, rotation0, rect1, rotation1,
+                                          cache, pairID);
+  }
+
+  bool areTwoRectsIntersecting(const PreparedRectangle& rect0,
+                               const PreparedRectangle& rect1,
+                               SeparatingAxisCache& cache,
+                               uint64_t pairID)
+  {
+    COREX_MATH_INSTRUMENT(areTwoRectsIntersecting);
+#if defined(COREX_MATH_BOUNDING_CIRCLE_EARLY_OUT)
+    if (areRectBoundingCirclesApart(rect0.rect, rect1.rect)) {
+      return false;
+    }
+#endif
+
+    // Rectangles whose rect was changed without updating them are tested like
+    // plain Rectangles, which gives the same result.
+    if (isPreparedRectangleStale(rect0) || isPreparedRectangleStale(rect1)) {
+      return areTwoRotatedRectsIntersecting(
+          rect0.rect, rotationFromAngle(rect0.rect.angle),
+          rect1.rect, rotationFromAngle(rect1.rect.angle),
+          cache, pairID);
+    }
+
+    SeparatingAxisCacheEntry& entry = getSeparatingAxisCacheEntry(cache,
+                                                                   pairID);
+    if (entry.axis >= 0
+        && !arePreparedRectsOverlappingInAnAxis(rect0, rect1, entry.axis)) {
+      return false;
+    }
+
+    for (int32_t axis = 0; axis < 4; axis++) {
+      if (axis != entry.axis
+          && !arePreparedRectsOverlappingInAnAxis(rect0, rect1, axis)) {
+        entry.axis = axis;
+        return false;
+      }
+    }
+
+    entry.axis = -1;
+    return true;
+  }
+
+  static Vec2 getRectPairAxis(const Rotation& rotation0,
+                              const Rotation& rotation1,
+                              int32_t axis)
+  {
+    // Axes 0 and 1 are the x and y axes of the first rectangle, and 2 and 3
+    // are those of the second one, in the order areTwoRectsIntersecting()
+    // tests them in.
+    const Rotation& rotation = (axis < 2) ? rotation0 : rotation1;
+    if (axis % 2 == 0) {
+      return rotateVec2(Vec2{1.f, 0.f}, rotation);
+    }
+
+    return rotateVec2(Vec2{0.f, 1.f}, rotation);
+  }
+
+  static bool arePreparedRectsOverlappingInAnAxis(
+      const PreparedRectangle& rect0,
+      const PreparedRectangle& rect1,
+      int32_t axis)
+  {
+    // Each rectangle was already projected onto its own axes. So, only the
+    // projection of the other rectangle onto the axis is left to compute.
+    // The axes are numbered like in getRectPairAxis().
+    switch (axis) {
+      case 0:
+        return areTwoProjectionsOverlapping(
+            rect0.projectionX,
+            projectRectToAnAxis(rect1.vertices, rect0.axisX));
+      case 1:
+        return areTwoProjectionsOverlapping(
+            rect0.projectionY,
+            projectRectToAnAxis(rect1.vertices, rect0.axisY));
+      case 2:
+        return areTwoProjectionsOverlapping(
+            projectRectToAnAxis(rect0.vertices, rect1.axisX),
+            rect1.projectionX);
+      default:
+        return areTwoProjectionsOverlapping(
+            projectRectToAnAxis(rect0.vertices, rect1.axisY),
+            rect1.projectionY);
+    }
+  }
+
+  static void recomputePreparedRectangle(PreparedRectangle& prepared)
+  {
+    // The cached data must be the same as what the functions taking a
+    // plain Rectangle compute, so that both give the same results.
+    const Rectangle& rect = prepared.rect;
+    prepared.preparedRect = rect;
+    prepared.rotation = rotationFromAngle(rect.angle);
+    prepared.vertices = rotateRectangle(rect, prepared.rotation);
+    prepared.axisX = rotateVec2(Vec2{1.f, 0.f}, prepared.rotation);
+    prepared.axisY = rotateVec2(Vec2{0.f, 1.f}, prepared.rotation);
+    prepared.projectionX = projectRectToAnAxis(prepared.vertices,
+                                               prepared.axisX);
+    prepared.projectionY = projectRectToAnAxis(prepared.vertices,
+                                               prepared.axisY);
+    prepared.halfWidth = rect.width / 2.f;
+    prepared.halfHeight = rect.height / 2.f;
+  }
+
+  PreparedRectangle prepareRectangle(const Rectangle& rect)
+  {
+    COREX_MATH_INSTRUMENT(prepareRectangle);
+    PreparedRectangle prepared;
+    prepared.rect = rect;
+    recomputePreparedRectangle(prepared);
+
+    return prepared;
+  }
+
+  void updatePreparedRectangle(PreparedRectangle& prepared)
+  {
+    COREX_MATH_INSTRUMENT(updatePreparedRectangle);
+    if (isPreparedRectangleStale(prepared)) {
+      recomputePreparedRectangle(prepared);
+    }
+  }
+
+  static bool isPreparedRectangleStale(const PreparedRectangle& prepared)
+  {
+    // The preparedRect of a default constructed PreparedRectangle is NaN,
+    // which never compares equal to rect, so it is always stale.
+    const Rectangle& rect = prepared.rect;
+    const Rectangle& preparedRect = prepared.preparedRect;
+    return rect.x != preparedRect.x || rect.y != preparedRect.y
+           || rect.width != preparedRect.width
+           || rect.height != preparedRect.height
+           || rect.angle != preparedRect.angle;
+  }
+
+  static Polygon<4> getPreparedRectangleVertices(
+      const PreparedRectangle& prepared)
+  {
+    if (isPreparedRectangleStale(prepared)) {
+      return rotateRectangle(prepared.rect);
+    }
 
-    return areTwoRectsIntersectingInAnAxis(rect0, rect1, axisX0)
-           && areTwoRectsIntersectingInAnAxis(rect0, rect1, axisY0)
-           && areTwoRectsIntersectingInAnAxis(rect0, rect1, axisX1)
-           && areTwoRectsIntersectingInAnAxis(rect0, rect1, axisY1);
+    return prepared.vertices;
   }
 
   ReturnValue<Point> intersectionOfTwoInfLines(const Line& line0,
                                                const Line& line1)
   {
+    COREX_MATH_INSTRUMENT(intersectionOfTwoInfLines);
     // We're using the vector form of a line equation since it's easier to
     // determine whether two lines are intersecting or not with such a form.
     Vec2 line0DirVec = lineDirectionVector(line0);
@@ -154,6 +446,7 @@ namespace cx
   ReturnValue<Point> intersectionOfLineandInfLine(const Line& line,
                                                   const Line& infLine)
   {
+    COREX_MATH_INSTRUMENT(intersectionOfLineandInfLine);
     auto intersectionPt = intersectionOfTwoInfLines(line, infLine);
     if (intersectionPt.status == ReturnState::RETURN_FAIL) {
       return intersectionPt;
@@ -178,6 +471,7 @@ namespace cx
   ReturnValue<Point> intersectionOfLineAndLine(const Line& line0,
                                                const Line& line1)
   {
+    COREX_MATH_INSTRUMENT(intersectionOfLineAndLine);
     auto intersectionPt = intersectionOfTwoInfLines(line0, line1);
     if (intersectionPt.status == ReturnState::RETURN_FAIL) {
       return intersectionPt;
@@ -199,124 +493,146 @@ namespace cx
 
   bool areTwoLinesIntersecting(const Line& line0, const Line& line1)
   {
+    COREX_MATH_INSTRUMENT(areTwoLinesIntersecting);
     auto intersectionPt = intersectionOfLineAndLine(line0, line1);
     return intersectionPt.status == ReturnState::RETURN_OK;
   }
 
   NPolygon clippedPolygonFromTwoRects(const Rectangle& targetRect,
                                       const Rectangle& clippingRect)
+  {
+    FixedNPolygon<8> clippedPolygon;
+    clippedPolygonFromTwoRects(targetRect, clippingRect, clippedPolygon);
+
+    auto& vertices = clippedPolygon.vertices;
+    return NPolygon{ eastl::vector<Point>(vertices.begin(), vertices.end()) };
+  }
+
+  NPolygon clippedPolygonFromTwoRects(const PreparedRectangle& targetRect,
+                                      const PreparedRectangle& clippingRect)
+  {
+    FixedNPolygon<8> clippedPolygon;
+    clippedPolygonFromTwoRects(targetRect, clippingRect, clippedPolygon);
+
+    auto& vertices = clippedPolygon.vertices;
+    return NPolygon{ eastl::vector<Point>(vertices.begin(), vertices.end()) };
+  }
+
+  void clippedPolygonFromTwoRects(const Rectangle& targetRect,
+                                  const Rectangle& clippingRect,
+                                  FixedNPolygon<8>& clippedPolygon)
+  {
+    COREX_MATH_INSTRUMENT(clippedPolygonFromTwoRects);
+    clippedPolygonFromTwoRectPolygons(convertRectangleToPolygon(targetRect),
+                                      convertRectangleToPolygon(clippingRect),
+                                      clippedPolygon);
+  }
+
+  void clippedPolygonFromTwoRects(const PreparedRectangle& targetRect,
+                                  const PreparedRectangle& clippingRect,
+                                  FixedNPolygon<8>& clippedPolygon)
+  {
+    COREX_MATH_INSTRUMENT(clippedPolygonFromTwoRects);
+    clippedPolygonFromTwoRectPolygons(
+        getPreparedRectangleVertices(targetRect),
+        getPreparedRectangleVertices(clippingRect),
+        clippedPolygon);
+  }
+
+  static void clippedPolygonFromTwoRectPolygons(
+      const Polygon<4>& targetRectPoly,
+      const Polygon<4>& clippingRectPoly,
+      FixedNPolygon<8>& clippedPolygon)
   {
     // Heck, yeah! Let's do some Sutherland-Hodgman.
-    auto targetRectPoly = convertRectangleToPolygon(targetRect);
-    auto clippingEdges = convertPolygonToLines(
-        convertRectangleToPolygon(clippingRect));
+    //
+    // A rectangle clipped by another rectangle has at most 8 vertices. So,
+    // the vertices of each step of the clipping just go back and forth
+    // between the output polygon and a buffer that lives in the stack. There
+    // are four clip edges, so the last step ends up in the output polygon.
+    auto clippingEdges = convertPolygonToLines(clippingRectPoly);
 
-    eastl::vector<Point> clippedPolyVerts;
-    for (Point& point : targetRectPoly.vertices) {
-      clippedPolyVerts.push_back(point);
-    }
+    FixedNPolygon<8> scratchPolygon;
+    auto* currTargetPoly = &scratchPolygon.vertices;
+    auto* clippedPolyVerts = &clippedPolygon.vertices;
+    clippedPolyVerts->assign(targetRectPoly.vertices.begin(),
+                             targetRectPoly.vertices.end());
 
-    eastl::vector<Point> currTargetPoly;
+    eastl::fixed_vector<float, 8> signedDists;
     for (Line& clipEdge : clippingEdges) {
-      currTargetPoly = clippedPolyVerts;
-      clippedPolyVerts.clear();
+      eastl::swap(currTargetPoly, clippedPolyVerts);
+      clippedPolyVerts->clear();
+
+      // Each vertex is the start of one target line and the end of another.
+      // So, let's compute the signed distance of each vertex only once. This
+      // is computed like in signedDistPointToInfLine().
+      Vec2 clipEdgeNormal = lineNormalVector(clipEdge);
+      signedDists.clear();
+      for (const Point& vertex : *currTargetPoly) {
+        signedDists.push_back(setDecPlaces(
+            dotProduct(clipEdgeNormal, vertex - clipEdge.end), 4));
+      }
 
-      for (int i = 0; i < currTargetPoly.size(); i++) {
+      int numVertices = static_cast<int>(currTargetPoly->size());
+      for (int i = 0; i < numVertices; i++) {
+        int nextIndex = (i + 1) % numVertices;
         Line targetLine = Line{
-            currTargetPoly[i],
-            currTargetPoly[(i + 1) % currTargetPoly.size()]
+            (*currTargetPoly)[i],
+            (*currTargetPoly)[nextIndex]
         };
-        auto intersectionPt = intersectionOfLineandInfLine(targetLine,
-                                                           clipEdge);
-        if (floatLessEqual(signedDistPointToInfLine(targetLine.start, clipEdge),
-                           0.f)) {
+        if (floatLessEqual(signedDists[i], 0.f)) {
           // The start of the target line is inside the clip edge.
-          clippedPolyVerts.push_back(targetLine.start);
+          clippedPolyVerts->push_back(targetLine.start);
 
-          if (floatGreEqual(signedDistPointToInfLine(targetLine.end, clipEdge),
-                            0.f)) {
+          if (floatGreEqual(signedDists[nextIndex], 0.f)) {
             // There should be an intersection point here since the start
             // and end points of the target line are in opposite sides of the
             // clipping edge.
+            auto intersectionPt = intersectionOfLineandInfLine(targetLine,
+                                                               clipEdge);
             if (intersectionPt.status == ReturnState::RETURN_OK) {
-              clippedPolyVerts.push_back(intersectionPt.value);
+              clippedPolyVerts->push_back(intersectionPt.value);
             }
           }
-        } else if (floatLessEqual(
-            signedDistPointToInfLine(targetLine.end, clipEdge), 0.f)) {
+        } else if (floatLessEqual(signedDists[nextIndex], 0.f)) {
           // The end of the target line is inside the clip edge.
           // There should be an intersection point here since the start
           // and end points of the target line are in opposite sides of the
           // clipping edge.
+          auto intersectionPt = intersectionOfLineandInfLine(targetLine,
+                                                             clipEdge);
           if (intersectionPt.status == ReturnState::RETURN_OK) {
-            clippedPolyVerts.push_back(intersectionPt.value);
+            clippedPolyVerts->push_back(intersectionPt.value);
           }
         }
       }
     }
-
-    return NPolygon{ clippedPolyVerts };
   }
 
   Point getPolygonCentroid(const NPolygon& polygon)
   {
-    // From "Calculating the area and centroid of a polygon" by Paul Bourke.
-    // URL: http://paulbourke.net/geometry/polygonmesh/
-    double polygonArea = getPolygonArea(polygon);
-    auto& vertices = polygon.vertices;
-    double centroidX = 0.0;
-    double centroidY = 0.0;
-
-    float determinant = corex::core::det3x3(vertices[0],
-                                            vertices[1],
-                                            vertices[2]);
-
-    for (int i = 0; i < vertices.size(); i++) {
-      // If the polygon is oriented counterclockwise when the origin is in the
-      // center, then it is oriented clockwise when the origin is in the
-      // top-left. We must iterate through the vertices from left to right.
-      //
-      // If the polygon is oriented clockwise when the origin is in the center,
-      // then it is oriented counterclockwise when the origin is in the
-      // top-left. We must iterate through the vertices from right to left.
-      int currVertIndex = 0;
-      int nextVertIndex = 0;
-      if (corex::core::floatGreEqual(determinant, 0.f)) {
-        // Polygon is oriented counterclockwise when the origin is in the
-        // center.
-        currVertIndex = i;
-        nextVertIndex = pyModInt(currVertIndex + 1, vertices.size());
-      } else {
-        // Polygon is oriented clockwise when the origin is in the
-        // center.
-        currVertIndex = vertices.size() - (i + 1);
-        nextVertIndex = pyModInt(currVertIndex - 1, vertices.size());
-      }
-
-      centroidX += (vertices[currVertIndex].x + vertices[nextVertIndex].x)
-                   * ((vertices[currVertIndex].x * vertices[nextVertIndex].y)
-                      - (vertices[nextVertIndex].x * vertices[currVertIndex].y));
-      centroidY += (vertices[currVertIndex].y + vertices[nextVertIndex].y)
-                   * ((vertices[currVertIndex].x * vertices[nextVertIndex].y)
-                      - (vertices[nextVertIndex].x * vertices[currVertIndex].y));
-    }
-
-    double areaConstant = 1.0 / (6.0 * polygonArea);
-    centroidX *= areaConstant;
-    centroidY *= areaConstant;
+    return getPolygonCentroid(polygon.vertices.data(),
+                              static_cast<int32_t>(polygon.vertices.size()));
+  }
 
-    return Point{
-        static_cast<float>(centroidX),
-        static_cast<float>(centroidY)
-    };
+  Point getPolygonCentroid(const Point* vertices, int32_t numVertices)
+  {
+    COREX_MATH_INSTRUMENT(getPolygonCentroid);
+    return getPolygonProperties(vertices, numVertices).centroid;
   }
 
   double getPolygonArea(const NPolygon& polygon)
   {
+    return getPolygonArea(polygon.vertices.data(),
+                          static_cast<int32_t>(polygon.vertices.size()));
+  }
+
+  double getPolygonArea(const Point* vertices, int32_t numVertices)
+  {
+    COREX_MATH_INSTRUMENT(getPolygonArea);
     // Let's use the Shoelace algorithm.
     double area = 0.f;
-    auto& vertices = polygon.vertices;
-    for (int i = 0; i < polygon.vertices.size(); i++) {
+    for (int i = 0, nextIndex = 1; i < numVertices; i++, nextIndex++) {
       // Our polygon vertices, whose container list is accessed from left to
       // right, are arranged in a clockwise manner in a coordinate system where
       // the origin is on the top left corner, like what we are using. However
@@ -325,7 +641,10 @@ namespace cx
       // Algorithm assumes that the origin is anchored on the bottom right
       // corner. As such, we can simply iterate through the list of vertices
       // from left to right.
-      int nextIndex = (i + 1) % polygon.vertices.size();
+      if (nextIndex == numVertices) {
+        nextIndex = 0;
+      }
+
       area +=
           (static_cast<double>(vertices[i].x)
            * static_cast<double>(vertices[nextIndex].y))
@@ -336,8 +655,86 @@ namespace cx
     return fabs(area) / 2.0;
   }
 
+  PolygonProperties getPolygonProperties(const NPolygon& polygon)
+  {
+    return getPolygonProperties(polygon.vertices.data(),
+                                static_cast<int32_t>(polygon.vertices.size()));
+  }
+
+  PolygonProperties getPolygonProperties(const Point* vertices,
+                                         int32_t numVertices)
+  {
+    COREX_MATH_INSTRUMENT(getPolygonProperties);
+    if (numVertices == 0) {
+      return PolygonProperties{ 0.0, PolygonWinding::DEGENERATE, Point{} };
+    }
+
+    // From "Calculating the area and centroid of a polygon" by Paul Bourke.
+    // URL: http://paulbourke.net/geometry/polygonmesh/
+    //
+    // The vertices are taken relative to the first one, which keeps the
+    // products small for polygons that are far from the origin. It also
+    // makes the two edges that touch the first vertex drop out of the sums,
+    // so there is no need to wrap around to the start.
+    double originX = vertices[0].x;
+    double originY = vertices[0].y;
+    double doubleArea = 0.0;
+    double centroidX = 0.0;
+    double centroidY = 0.0;
+    for (int32_t i = 1; i < numVertices - 1; i++) {
+      double x0 = vertices[i].x - originX;
+      double y0 = vertices[i].y - originY;
+      double x1 = vertices[i + 1].x - originX;
+      double y1 = vertices[i + 1].y - originY;
+      double cross = (x0 * y1) - (x1 * y0);
+      doubleArea += cross;
+      centroidX += (x0 + x1) * cross;
+      centroidY += (y0 + y1) * cross;
+    }
+
+    if (doubleArea == 0.0) {
+      // Without an area, the centroid is not defined, so we use the average
+      // of the vertices instead.
+      double sumX = 0.0;
+      double sumY = 0.0;
+      for (int32_t i = 0; i < numVertices; i++) {
+        sumX += vertices[i].x;
+        sumY += vertices[i].y;
+      }
+
+      return PolygonProperties{
+        0.0,
+        PolygonWinding::DEGENERATE,
+        Point{
+          static_cast<float>(sumX / numVertices),
+          static_cast<float>(sumY / numVertices)
+        }
+      };
+    }
+
+    return PolygonProperties{
+      doubleArea / 2.0,
+      (doubleArea > 0.0) ? PolygonWinding::CLOCKWISE
+                         : PolygonWinding::COUNTERCLOCKWISE,
+      Point{
+        static_cast<float>(originX + (centroidX / (3.0 * doubleArea))),
+        static_cast<float>(originY + (centroidY / (3.0 * doubleArea)))
+      }
+    };
+  }
+
   bool isPointWithinNPolygon(const Point& point, const NPolygon& polygon)
   {
+    return isPointWithinNPolygon(point,
+                                 polygon.vertices.data(),
+                                 static_cast<int32_t>(polygon.vertices.size()));
+  }
+
+  bool isPointWithinNPolygon(const Point& point,
+                             const Point* vertices,
+                             int32_t numVertices)
+  {
+    COREX_MATH_INSTRUMENT(isPointWithinNPolygon);
     // Code based from:
     //     https://wrf.ecse.rpi.edu/Research/Short_Notes/pnpoly.html
     // NOTE: I think the algorithm expects that the origin is situated in the
@@ -346,10 +743,8 @@ namespace cx
     //       from the perspective of the algorithm, the vertices are flipped
     //       vertically.
     bool isPointInside = false;
-    for (int i = 0, j = polygon.vertices.size() - 1;
-         i < polygon.vertices.size();
-         j = i++) {
-      Line polyLine = Line{ polygon.vertices[i], polygon.vertices[j] };
+    for (int i = 0, j = numVertices - 1; i < numVertices; j = i++) {
+      Line polyLine = Line{ vertices[i], vertices[j] };
       if (((polyLine.start.y > point.y) != (polyLine.end.y > point.y))
           && (point.x < ((polyLine.end.x - polyLine.start.x)
                          * (point.y - polyLine.start.y)
@@ -364,8 +759,22 @@ namespace cx
 
   bool isRectWithinNPolygon(const Rectangle& rect, const NPolygon& polygon)
   {
-    auto rectPoly = convertRectangleToPolygon(rect);
+    COREX_MATH_INSTRUMENT(isRectWithinNPolygon);
+    return isRectPolygonWithinNPolygon(convertRectangleToPolygon(rect),
+                                       polygon);
+  }
+
+  bool isRectWithinNPolygon(const PreparedRectangle& rect,
+                            const NPolygon& polygon)
+  {
+    COREX_MATH_INSTRUMENT(isRectWithinNPolygon);
+    return isRectPolygonWithinNPolygon(
+        getPreparedRectangleVertices(rect), polygon);
+  }
 
+  static bool isRectPolygonWithinNPolygon(const Polygon<4>& rectPoly,
+                                          const NPolygon& polygon)
+  {
     for (int i = 0; i < polygon.vertices.size(); i++) {
       Line boundaryLine = Line{
           polygon.vertices[i],
@@ -395,13 +804,27 @@ namespace cx
 
   bool isRectIntersectingNPolygon(const Rectangle& rect,
                                   const NPolygon& polygon)
+  {
+    COREX_MATH_INSTRUMENT(isRectIntersectingNPolygon);
+    return isRectPolygonIntersectingNPolygon(convertRectangleToPolygon(rect),
+                                             polygon);
+  }
+
+  bool isRectIntersectingNPolygon(const PreparedRectangle& rect,
+                                  const NPolygon& polygon)
+  {
+    COREX_MATH_INSTRUMENT(isRectIntersectingNPolygon);
+    return isRectPolygonIntersectingNPolygon(
+        getPreparedRectangleVertices(rect), polygon);
+  }
+
+  static bool isRectPolygonIntersectingNPolygon(const Polygon<4>& rectPoly,
+                                                const NPolygon& polygon)
   {
     // NOTE: "A subset of a set is equal to its intersections."
     // Source: https://www.quora.com
     //                /Set-Theory-Is-a-subset-a-type-of-intersection
     //                /answer/Vinay-Madhusudanan
-    auto rectPoly = convertRectangleToPolygon(rect);
-
     for (int i = 0; i < polygon.vertices.size(); i++) {
       Line boundaryLine = Line{
           polygon.vertices[i],
@@ -422,4 +845,567 @@ namespace cx
 
     return isPointWithinNPolygon(rectPoly.vertices[0], polygon);
   }
+
+  AABB getRectangleAABB(const Rectangle& rect)
+  {
+    COREX_MATH_INSTRUMENT(getRectangleAABB);
+    // The bounds of a rotated rectangle. The half-extents of the bounds are
+    // the half-extents of the rectangle projected onto the x and y axes.
+    Rotation rotation = rotationFromAngle(rect.angle);
+    float cosAngle = std::fabs(rotation.cosine);
+    float sinAngle = std::fabs(rotation.sine);
+    float halfExtentX = ((rect.width * cosAngle) + (rect.height * sinAngle))
+                        / 2.f;
+    float halfExtentY = ((rect.width * sinAngle) + (rect.height * cosAngle))
+                        / 2.f;
+
+    return AABB{
+        rect.x - halfExtentX,
+        rect.y - halfExtentY,
+        rect.x + halfExtentX,
+        rect.y + halfExtentY
+    };
+  }
+
+  AABB getPolygonAABB(const NPolygon& polygon)
+  {
+    return getPolygonAABB(polygon.vertices.data(),
+                          static_cast<int32_t>(polygon.vertices.size()));
+  }
+
+  AABB getPolygonAABB(const Point* vertices, int32_t numVertices)
+  {
+    COREX_MATH_INSTRUMENT(getPolygonAABB);
+    // A polygon without vertices gets an empty box at the origin, like an
+    // empty QuantizedNPolygon does.
+    if (numVertices == 0) {
+      return AABB{ 0.f, 0.f, 0.f, 0.f };
+    }
+
+    AABB bounds{ vertices[0].x, vertices[0].y, vertices[0].x, vertices[0].y };
+    for (int i = 1; i < numVertices; i++) {
+      bounds.minX = std::fmin(bounds.minX, vertices[i].x);
+      bounds.minY = std::fmin(bounds.minY, vertices[i].y);
+      bounds.maxX = std::fmax(bounds.maxX, vertices[i].x);
+      bounds.maxY = std::fmax(bounds.maxY, vertices[i].y);
+    }
+
+    return bounds;
+  }
+
+  bool areTwoAABBsIntersecting(const AABB& box0, const AABB& box1)
+  {
+    COREX_MATH_INSTRUMENT(areTwoAABBsIntersecting);
+    // Boxes that are just touching each other are intersecting.
+    return box0.minX <= box1.maxX && box1.minX <= box0.maxX
+           && box0.minY <= box1.maxY && box1.minY <= box0.maxY;
+  }
+
+  // Edges of a prepared polygon that are this close to a rectangle are still
+  // tested against the rectangle, since the line intersection tests are done
+  // with a tolerance.
+  constexpr float preparedEdgeTolerance = 0.001f;
+
+  static int32_t preparedPolygonSlab(const PreparedNPolygon& polygon, float y)
+  {
+    int32_t slab = static_cast<int32_t>(
+        (y - polygon.bounds.minY) / polygon.slabHeight);
+    return eastl::max(0, eastl::min(slab, polygon.numSlabs - 1));
+  }
+
+  PreparedNPolygon prepareNPolygon(const NPolygon& polygon)
+  {
+    COREX_MATH_INSTRUMENT(prepareNPolygon);
+    PreparedNPolygon prepared;
+    prepared.polygon = polygon;
+    prepared.bounds = getPolygonAABB(polygon);
+
+    auto& vertices = polygon.vertices;
+    int32_t numVertices = static_cast<int32_t>(vertices.size());
+    prepared.edges.resize(numVertices);
+    prepared.edgeBounds.resize(numVertices);
+    prepared.edgeNormals.resize(numVertices);
+    for (int32_t i = 0; i < numVertices; i++) {
+      Line edge = Line{ vertices[i], vertices[(i + 1) % numVertices] };
+      prepared.edges[i] = edge;
+      prepared.edgeBounds[i] = AABB{
+          eastl::min(edge.start.x, edge.end.x),
+          eastl::min(edge.start.y, edge.end.y),
+          eastl::max(edge.start.x, edge.end.x),
+          eastl::max(edge.start.y, edge.end.y)
+      };
+      prepared.edgeNormals[i] = lineNormalVector(edge);
+    }
+
+    // Around four edges per slab keeps the slabs small without making long
+    // edges appear in too many of them.
+    prepared.numSlabs = eastl::max(1, numVertices / 4);
+    prepared.slabHeight = (prepared.bounds.maxY - prepared.bounds.minY)
+                          / static_cast<float>(prepared.numSlabs);
+    if (!(prepared.slabHeight > 0.f)) {
+      // The polygon is flat, so all edges go into one slab.
+      prepared.numSlabs = 1;
+      prepared.slabHeight = 1.f;
+    }
+
+    // Count the edges of each slab first, so that all of them can go into
+    // one flat array.
+    prepared.slabEdgeOffsets.assign(prepared.numSlabs + 1, 0);
+    for (const AABB& edgeBounds : prepared.edgeBounds) {
+      int32_t firstSlab = preparedPolygonSlab(prepared, edgeBounds.minY);
+      int32_t lastSlab = preparedPolygonSlab(prepared, edgeBounds.maxY);
+      for (int32_t slab = firstSlab; slab <= lastSlab; slab++) {
+        prepared.slabEdgeOffsets[slab + 1]++;
+      }
+    }
+
+    for (int32_t slab = 0; slab < prepared.numSlabs; slab++) {
+      prepared.slabEdgeOffsets[slab + 1] += prepared.slabEdgeOffsets[slab];
+    }
+
+    eastl::vector<int32_t> slabFills(prepared.slabEdgeOffsets.begin(),
+                                     prepared.slabEdgeOffsets.end() - 1);
+    prepared.slabEdges.resize(prepared.slabEdgeOffsets.back());
+    for (int32_t i = 0; i < numVertices; i++) {
+      int32_t firstSlab = preparedPolygonSlab(prepared,
+                                              prepared.edgeBounds[i].minY);
+      int32_t lastSlab = preparedPolygonSlab(prepared,
+                                             prepared.edgeBounds[i].maxY);
+      for (int32_t slab = firstSlab; slab <= lastSlab; slab++) {
+        prepared.slabEdges[slabFills[slab]++] = i;
+      }
+    }
+
+    return prepared;
+  }
+
+  bool isPointWithinNPolygon(const Point& point,
+                             const PreparedNPolygon& polygon)
+  {
+    COREX_MATH_INSTRUMENT(isPointWithinNPolygon);
+    // Only edges overlapping the point vertically can be crossed by the ray
+    // of the crossing test, and all of them are in the slab of the point.
+    if (point.y < polygon.bounds.minY || point.y > polygon.bounds.maxY) {
+      return false;
+    }
+
+    // Same test as isPointWithinNPolygon(const Point&, const NPolygon&).
+    // That test forms its edges in reverse, so the start and end of our
+    // edges are swapped here to get the exact same results.
+    bool isPointInside = false;
+    int32_t slab = preparedPolygonSlab(polygon, point.y);
+    for (int32_t k = polygon.slabEdgeOffsets[slab];
+         k < polygon.slabEdgeOffsets[slab + 1];
+         k++) {
+      const Line& edge = polygon.edges[polygon.slabEdges[k]];
+      const Point& start = edge.end;
+      const Point& end = edge.start;
+      if (((start.y > point.y) != (end.y > point.y))
+          && (point.x < ((end.x - start.x)
+                         * (point.y - start.y)
+                         / (end.y - start.y)
+                         + start.x))) {
+        isPointInside = !isPointInside;
+      }
+    }
+
+    return isPointInside;
+  }
+
+  template <typename EdgeTest>
+  static bool isAnyPreparedEdgeNearRect(const Polygon<4>& rectPoly,
+                                        const PreparedNPolygon& polygon,
+                                        EdgeTest isEdgeHit)
+  {
+    // Calls isEdgeHit() with each edge whose bounds are near the bounds of
+    // the rectangle, until it returns true.
+    AABB rectBounds{ rectPoly.vertices[0].x, rectPoly.vertices[0].y,
+                     rectPoly.vertices[0].x, rectPoly.vertices[0].y };
+    for (const Point& vertex : rectPoly.vertices) {
+      rectBounds.minX = eastl::min(rectBounds.minX, vertex.x);
+      rectBounds.minY = eastl::min(rectBounds.minY, vertex.y);
+      rectBounds.maxX = eastl::max(rectBounds.maxX, vertex.x);
+      rectBounds.maxY = eastl::max(rectBounds.maxY, vertex.y);
+    }
+
+    rectBounds.minX -= preparedEdgeTolerance;
+    rectBounds.minY -= preparedEdgeTolerance;
+    rectBounds.maxX += preparedEdgeTolerance;
+    rectBounds.maxY += preparedEdgeTolerance;
+    if (!areTwoAABBsIntersecting(rectBounds, polygon.bounds)) {
+      return false;
+    }
+
+    int32_t firstSlab = preparedPolygonSlab(polygon, rectBounds.minY);
+    int32_t lastSlab = preparedPolygonSlab(polygon, rectBounds.maxY);
+    for (int32_t slab = firstSlab; slab <= lastSlab; slab++) {
+      for (int32_t k = polygon.slabEdgeOffsets[slab];
+           k < polygon.slabEdgeOffsets[slab + 1];
+           k++) {
+        int32_t edgeIndex = polygon.slabEdges[k];
+        const AABB& edgeBounds = polygon.edgeBounds[edgeIndex];
+
+        // An edge can be in more than one of the slabs. Only look at it in
+        // the first one of them that we go through.
+        int32_t edgeFirstSlab = eastl::max(
+            firstSlab, preparedPolygonSlab(polygon, edgeBounds.minY));
+        if (slab == edgeFirstSlab
+            && areTwoAABBsIntersecting(edgeBounds, rectBounds)
+            && isEdgeHit(edgeIndex)) {
+          return true;
+        }
+      }
+    }
+
+    return false;
+  }
+
+  static bool isRectPolygonWithinPreparedNPolygon(
+      const Polygon<4>& rectPoly,
+      const PreparedNPolygon& polygon)
+  {
+    // Same test as isRectWithinNPolygon(), but only with the nearby edges.
+    bool isCrossingBoundary = isAnyPreparedEdgeNearRect(
+        rectPoly, polygon,
+        [&](int32_t edgeIndex) {
+          const Line& boundaryLine = polygon.edges[edgeIndex];
+          const Vec2& normal = polygon.edgeNormals[edgeIndex];
+          for (size_t j = 0; j < rectPoly.vertices.size(); j++) {
+            Line rectLine = Line{
+                rectPoly.vertices[j],
+                rectPoly.vertices[(j + 1) % rectPoly.vertices.size()]
+            };
+
+            if (!areTwoLinesIntersecting(boundaryLine, rectLine)) {
+              continue;
+            }
+
+            // The signed distances are computed like in
+            // signedDistPointToInfLine(), but with the cached normal.
+            float startDist = setDecPlaces(
+                dotProduct(normal, rectLine.start - boundaryLine.end), 4);
+            float endDist = setDecPlaces(
+                dotProduct(normal, rectLine.end - boundaryLine.end), 4);
+            if (floatGreater(startDist, 0.f) || floatGreater(endDist, 0.f)) {
+              return true;
+            }
+          }
+
+          return false;
+        });
+    if (isCrossingBoundary) {
+      return false;
+    }
+
+    return isPointWithinNPolygon(rectPoly.vertices[0], polygon);
+  }
+
+  static bool isRectPolygonIntersectingPreparedNPolygon(
+      const Polygon<4>& rectPoly,
+      const PreparedNPolygon& polygon)
+  {
+    // Same test as isRectIntersectingNPolygon(), but only with the nearby
+    // edges.
+    bool isTouchingBoundary = isAnyPreparedEdgeNearRect(
+        rectPoly, polygon,
+        [&](int32_t edgeIndex) {
+          const Line& boundaryLine = polygon.edges[edgeIndex];
+          for (size_t j = 0; j < rectPoly.vertices.size(); j++) {
+            Line rectLine = Line{
+                rectPoly.vertices[j],
+                rectPoly.vertices[(j + 1) % rectPoly.vertices.size()]
+            };
+
+            if (areTwoLinesIntersecting(boundaryLine, rectLine)) {
+              return true;
+            }
+          }
+
+          return false;
+        });
+    if (isTouchingBoundary) {
+      return true;
+    }
+
+    return isPointWithinNPolygon(rectPoly.vertices[0], polygon);
+  }
+
+  bool isRectWithinNPolygon(const Rectangle& rect,
+                            const PreparedNPolygon& polygon)
+  {
+    COREX_MATH_INSTRUMENT(isRectWithinNPolygon);
+    return isRectPolygonWithinPreparedNPolygon(
+        convertRectangleToPolygon(rect), polygon);
+  }
+
+  bool isRectWithinNPolygon(const PreparedRectangle& rect,
+                            const PreparedNPolygon& polygon)
+  {
+    COREX_MATH_INSTRUMENT(isRectWithinNPolygon);
+    return isRectPolygonWithinPreparedNPolygon(
+        getPreparedRectangleVertices(rect), polygon);
+  }
+
+  bool isRectIntersectingNPolygon(const Rectangle& rect,
+                                  const PreparedNPolygon& polygon)
+  {
+    COREX_MATH_INSTRUMENT(isRectIntersectingNPolygon);
+    return isRectPolygonIntersectingPreparedNPolygon(
+        convertRectangleToPolygon(rect), polygon);
+  }
+
+  bool isRectIntersectingNPolygon(const PreparedRectangle& rect,
+                                  const PreparedNPolygon& polygon)
+  {
+    COREX_MATH_INSTRUMENT(isRectIntersectingNPolygon);
+    return isRectPolygonIntersectingPreparedNPolygon(
+        getPreparedRectangleVertices(rect), polygon);
+  }
+
+  bool areTwoCirclesIntersecting(const Circle& circle0, const Circle& circle1)
+  {
+    COREX_MATH_INSTRUMENT(areTwoCirclesIntersecting);
+    float deltaX = circle1.position.x - circle0.position.x;
+    float deltaY = circle1.position.y - circle0.position.y;
+    float radiusSum = circle0.radius + circle1.radius;
+    return ((deltaX * deltaX) + (deltaY * deltaY)) <= (radiusSum * radiusSum);
+  }
+
+  bool isCircleIntersectingRect(const Circle& circle, const Rectangle& rect)
+  {
+    COREX_MATH_INSTRUMENT(isCircleIntersectingRect);
+    return squaredDistPointToRect(circle.position, rect)
+           <= (circle.radius * circle.radius);
+  }
+
+  bool isCircleIntersectingNPolygon(const Circle& circle,
+                                    const NPolygon& polygon)
+  {
+    return isCircleIntersectingNPolygon(
+      circle,
+      polygon.vertices.data(),
+      static_cast<int32_t>(polygon.vertices.size()));
+  }
+
+  bool isCircleIntersectingNPolygon(const Circle& circle,
+                                    const Point* vertices,
+                                    int32_t numVertices)
+  {
+    COREX_MATH_INSTRUMENT(isCircleIntersectingNPolygon);
+    // The circle either has its center inside the polygon, or is crossed by
+    // one of the edges of the polygon.
+    if (numVertices == 0) {
+      return false;
+    }
+
+    if (isPointWithinNPolygon(circle.position, vertices, numVertices)) {
+      return true;
+    }
+
+    return squaredDistPointToNPolygonEdges(circle.position,
+                                           vertices,
+                                           numVertices)
+           <= (circle.radius * circle.radius);
+  }
+
+  bool isCircleIntersectingLine(const Circle& circle, const Line& line)
+  {
+    COREX_MATH_INSTRUMENT(isCircleIntersectingLine);
+    return squaredDistPointToLine(circle.position, line)
+           <= (circle.radius * circle.radius);
+  }
+
+  float distCircleToCircle(const Circle& circle0, const Circle& circle1)
+  {
+    COREX_MATH_INSTRUMENT(distCircleToCircle);
+    float deltaX = circle1.position.x - circle0.position.x;
+    float deltaY = circle1.position.y - circle0.position.y;
+    float centerDist = std::sqrt((deltaX * deltaX) + (deltaY * deltaY));
+    return eastl::max(centerDist - circle0.radius - circle1.radius, 0.f);
+  }
+
+  float distCircleToRect(const Circle& circle, const Rectangle& rect)
+  {
+    COREX_MATH_INSTRUMENT(distCircleToRect);
+    return eastl::max(
+      std::sqrt(squaredDistPointToRect(circle.position, rect)) - circle.radius,
+      0.f);
+  }
+
+  float distCircleToNPolygon(const Circle& circle, const NPolygon& polygon)
+  {
+    return distCircleToNPolygon(circle,
+                                polygon.vertices.data(),
+                                static_cast<int32_t>(polygon.vertices.size()));
+  }
+
+  float distCircleToNPolygon(const Circle& circle,
+                             const Point* vertices,
+                             int32_t numVertices)
+  {
+    COREX_MATH_INSTRUMENT(distCircleToNPolygon);
+    if (numVertices == 0
+        || isPointWithinNPolygon(circle.position, vertices, numVertices)) {
+      return 0.f;
+    }
+
+    float squaredDist = squaredDistPointToNPolygonEdges(circle.position,
+                                                        vertices,
+                                                        numVertices);
+    return eastl::max(std::sqrt(squaredDist) - circle.radius, 0.f);
+  }
+
+  float distCircleToLine(const Circle& circle, const Line& line)
+  {
+    COREX_MATH_INSTRUMENT(distCircleToLine);
+    return eastl::max(
+      std::sqrt(squaredDistPointToLine(circle.position, line)) - circle.radius,
+      0.f);
+  }
+
+  Circle getRectBoundingCircle(const Rectangle& rect)
+  {
+    COREX_MATH_INSTRUMENT(getRectBoundingCircle);
+    return Circle{
+      Point{ rect.x, rect.y },
+      std::sqrt((rect.width * rect.width) + (rect.height * rect.height)) / 2.f
+    };
+  }
+
+  static float squaredDistPointToRect(const Point& point,
+                                      const Rectangle& rect)
+  {
+    // Move the point into the frame of the rectangle, whose axes are
+    // (cos, sin) and (-sin, cos), where the rectangle is just an AABB
+    // centered at the origin. Only the parts of the point that are outside
+    // of the half extents of the rectangle count towards the distance.
+    Rotation rotation = rotationFromAngle(rect.angle);
+    float deltaX = point.x - rect.x;
+    float deltaY = point.y - rect.y;
+    float localX = (deltaX * rotation.cosine) + (deltaY * rotation.sine);
+    float localY = (deltaY * rotation.cosine) - (deltaX * rotation.sine);
+    float outsideX = eastl::max(std::fabs(localX) - (rect.width / 2.f), 0.f);
+    float outsideY = eastl::max(std::fabs(localY) - (rect.height / 2.f), 0.f);
+    return (outsideX * outsideX) + (outsideY * outsideY);
+  }
+
+  static float squaredDistPointToLine(const Point& point, const Line& line)
+  {
+    // The closest point of the line is the projection of the point onto the
+    // line, clamped to the ends of the line.
+    float lineX = line.end.x - line.start.x;
+    float lineY = line.end.y - line.start.y;
+    float deltaX = point.x - line.start.x;
+    float deltaY = point.y - line.start.y;
+    float squaredLength = (lineX * lineX) + (lineY * lineY);
+    float t = 0.f;
+    if (squaredLength > 0.f) {
+      t = eastl::clamp(((deltaX * lineX) + (deltaY * lineY)) / squaredLength,
+                       0.f, 1.f);
+    }
+
+    float offsetX = deltaX - (t * lineX);
+    float offsetY = deltaY - (t * lineY);
+    return (offsetX * offsetX) + (offsetY * offsetY);
+  }
+
+  static float squaredDistPointToNPolygonEdges(const Point& point,
+                                               const Point* vertices,
+                                               int32_t numVertices)
+  {
+    float minSquaredDist = eastl::numeric_limits<float>::max();
+    for (int32_t i = 0, j = numVertices - 1; i < numVertices; j = i++) {
+      minSquaredDist = eastl::min(
+        minSquaredDist,
+        squaredDistPointToLine(point, Line{ vertices[j], vertices[i] }));
+    }
+
+    return minSquaredDist;
+  }
+
+  static bool areTwoRotatedRectsIntersecting(const Rectangle& rect0,
+                                             const Rotation& rotation0,
+                                             const Rectangle& rect1,
+                                             const Rotation& rotation1)
+  {
+    // Oh, boy. Let's do some SAT (Separating Axis Theorem)!
+    Vec2 axisX0 = rotateVec2(Vec2{1.f, 0.f}, rotation0);
+    Vec2 axisY0 = rotateVec2(Vec2{0.f, 1.f}, rotation0);
+    Vec2 axisX1 = rotateVec2(Vec2{1.f, 0.f}, rotation1);
+    Vec2 axisY1 = rotateVec2(Vec2{0.f, 1.f}, rotation1);
+
+    return areTwoRectsIntersectingInAnAxis(rect0, rotation0,
+                                           rect1, rotation1, axisX0)
+           && areTwoRectsIntersectingInAnAxis(rect0, rotation0,
+                                              rect1, rotation1, axisY0)
+           && areTwoRectsIntersectingInAnAxis(rect0, rotation0,
+                                              rect1, rotation1, axisX1)
+           && areTwoRectsIntersectingInAnAxis(rect0, rotation0,
+                                              rect1, rotation1, axisY1);
+  }
+
+  static bool areTwoRotatedRectsIntersecting(const Rectangle& rect0,
+                                             const Rotation& rotation0,
+                                             const Rectangle& rect1,
+                                             const Rotation& rotation1,
+                                             SeparatingAxisCache& cache,
+                                             uint64_t pairID)
+  {
+    SeparatingAxisCacheEntry& entry = getSeparatingAxisCacheEntry(cache,
+                                                                   pairID);
+    if (entry.axis >= 0
+        && !areTwoRectsIntersectingInAnAxis(
+            rect0, rotation0, rect1, rotation1,
+            getRectPairAxis(rotation0, rotation1, entry.axis))) {
+      return false;
+    }
+
+    for (int32_t axis = 0; axis < 4; axis++) {
+      if (axis != entry.axis
+          && !areTwoRectsIntersectingInAnAxis(
+              rect0, rotation0, rect1, rotation1,
+              getRectPairAxis(rotation0, rotation1, axis))) {
+        entry.axis = axis;
+        return false;
+      }
+    }
+
+    entry.axis = -1;
+    return true;
+  }
+
+#if defined(COREX_MATH_BOUNDING_CIRCLE_EARLY_OUT)
+  static bool areRectBoundingCirclesApart(const Rectangle& rect0,
+                                          const Rectangle& rect1)
+  {
+    // Rectangles can only intersect if their bounding circles do, and this
+    // needs no rotations or projections. They are apart if the distance
+    // between their centers is more than the sum of the radii plus a slack.
+    //
+    // The SAT rounds the rotated vertices to 6 decimal places, and their
+    // projections are within a few float epsilons of the largest coordinate,
+    // M. Four projected endpoints go into each overlap test, which also
+    // allows for a difference of 1e-6. So, it can consider rectangles whose
+    // gap on every axis is up to about 4e-6 + 8 * FLT_EPSILON * M to be
+    // touching. When the bounding circles are apart by some distance, one of
+    // the four axes has a gap of at least that distance over sqrt(2), from
+    // two corners facing each other diagonally. Hence, the slack starts at
+    // sqrt(2) times that tolerance, rounded up to 1e-5 + 12 * FLT_EPSILON * M.
+    // The rounding of this check itself moves the compared distances by less
+    // than another 12 * FLT_EPSILON * M. M is bounded by the sum of the
+    // center coordinates and the radii, which needs no branches.
+    float deltaX = rect1.x - rect0.x;
+    float deltaY = rect1.y - rect0.y;
+    float radiusSum = (std::sqrt((rect0.width * rect0.width)
+                                 + (rect0.height * rect0.height))
+                       + std::sqrt((rect1.width * rect1.width)
+                                   + (rect1.height * rect1.height)))
+                      / 2.f;
+    float maxCoordinate = std::fabs(rect0.x) + std::fabs(rect0.y)
+                          + std::fabs(deltaX) + std::fabs(deltaY)
+                          + radiusSum;
+    float maxDist = radiusSum + 1e-5f + (24.f * FLT_EPSILON * maxCoordinate);
+    return ((deltaX * deltaX) + (deltaY * deltaY)) > (maxDist * maxDist);
+  }
+#endif
 }
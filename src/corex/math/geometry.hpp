@@ -1,24 +1,75 @@
 #ifndef COREX_MATH_GEOMETRY_HPP
 #define COREX_MATH_GEOMETRY_HPP
 
+#include <cstdint>
+
+#include <corex/math/constants.hpp>
 #include <corex/math/ds.hpp>
 #include <corex/utils.hpp>
 
 namespace cx
 {
-  float degreesToRadians(float degrees);
-  float radiansToDegrees(float radians);
+  inline constexpr float degreesToRadians(float degrees)
+  {
+    return static_cast<float>(degrees * (pi / 180.0));
+  }
+
+  inline constexpr float radiansToDegrees(float radians)
+  {
+    return static_cast<float>(radians * (180.0 / pi));
+  }
+
   float distance2D(const Point& start, const Point& end);
   float lineLength(const Line& line);
 
   float signedDistPointToInfLine(const Point& point, const Line& line);
   Polygon<4> rotateRectangle(float centerX, float centerY, float width,
                              float height, float angle);
+  Polygon<4> rotateRectangle(float centerX, float centerY, float width,
+                             float height, const Rotation& rotation);
   Polygon<4> rotateRectangle(const Rectangle& rect);
+  Polygon<4> rotateRectangle(const Rectangle& rect, const Rotation& rotation);
+  bool areTwoRectsIntersectingInAnAxis(const Rectangle& rect0,
+                                       const Rectangle& rect1,
+                                       const Vec2& axis);
   bool areTwoRectsIntersectingInAnAxis(const Rectangle& rect0,
+                                       const Rotation& rotation0,
                                        const Rectangle& rect1,
+                                       const Rotation& rotation1,
                                        const Vec2& axis);
+
+  // When COREX_MATH_BOUNDING_CIRCLE_EARLY_OUT is defined, which it is by
+  // default, rectangles whose bounding circles are apart are rejected before
+  // they are rotated or projected. The results are the same either way.
   bool areTwoRectsIntersecting(const Rectangle& rect0, const Rectangle& rect1);
+  bool areTwoRectsIntersecting(const Rectangle& rect0,
+                               const Rotation& rotation0,
+                               const Rectangle& rect1,
+                               const Rotation& rotation1);
+  bool areTwoRectsIntersecting(const PreparedRectangle& rect0,
+                               const PreparedRectangle& rect1);
+
+  // Same as the functions above, but the axis that separated the two
+  // rectangles the last time the pair was tested is tried first, so a pair
+  // that is still apart usually only needs one axis tested. See
+  // SeparatingAxisCache.
+  bool areTwoRectsIntersecting(const Rectangle& rect0,
+                               const Rectangle& rect1,
+                               SeparatingAxisCache& cache,
+                               uint64_t pairID);
+  bool areTwoRectsIntersecting(const Rectangle& rect0,
+                               const Rotation& rotation0,
+                               const Rectangle& rect1,
+                               const Rotation& rotation1,
+                               SeparatingAxisCache& cache,
+                               uint64_t pairID);
+  bool areTwoRectsIntersecting(const PreparedRectangle& rect0,
+                               const PreparedRectangle& rect1,
+                               SeparatingAxisCache& cache,
+                               uint64_t pairID);
+
+  PreparedRectangle prepareRectangle(const Rectangle& rect);
+  void updatePreparedRectangle(PreparedRectangle& prepared);
   ReturnValue<Point> intersectionOfTwoInfLines(const Line& line0,
                                                const Line& line1);
   ReturnValue<Point> intersectionOfLineandInfLine(const Line& line,
@@ -28,12 +79,165 @@ namespace cx
   bool areTwoLinesIntersecting(const Line& line0, const Line& line1);
   NPolygon clippedPolygonFromTwoRects(const Rectangle& targetRect,
                                       const Rectangle& clippingRect);
+  NPolygon clippedPolygonFromTwoRects(const PreparedRectangle& targetRect,
+                                      const PreparedRectangle& clippingRect);
+  void clippedPolygonFromTwoRects(const Rectangle& targetRect,
+                                  const Rectangle& clippingRect,
+                                  FixedNPolygon<8>& clippedPolygon);
+  void clippedPolygonFromTwoRects(const PreparedRectangle& targetRect,
+                                  const PreparedRectangle& clippingRect,
+                                  FixedNPolygon<8>& clippedPolygon);
   Point getPolygonCentroid(const NPolygon& polygon);
+  Point getPolygonCentroid(const Point* vertices, int32_t numVertices);
   double getPolygonArea(const NPolygon& polygon);
+  double getPolygonArea(const Point* vertices, int32_t numVertices);
+
+  // The signed area, winding and centroid of a polygon, in a single pass
+  // over its vertices, which is cheaper than calling both getPolygonArea()
+  // and getPolygonCentroid(). The polygon may be concave, and may be wound
+  // either way.
+  PolygonProperties getPolygonProperties(const NPolygon& polygon);
+  PolygonProperties getPolygonProperties(const Point* vertices,
+                                         int32_t numVertices);
+
   bool isPointWithinNPolygon(const Point& point, const NPolygon& polygon);
+  bool isPointWithinNPolygon(const Point& point,
+                             const Point* vertices,
+                             int32_t numVertices);
   bool isRectWithinNPolygon(const Rectangle& rect, const NPolygon& polygon);
+  bool isRectWithinNPolygon(const PreparedRectangle& rect,
+                            const NPolygon& polygon);
   bool isRectIntersectingNPolygon(const Rectangle& rect,
                                   const NPolygon& polygon);
+  bool isRectIntersectingNPolygon(const PreparedRectangle& rect,
+                                  const NPolygon& polygon);
+  AABB getRectangleAABB(const Rectangle& rect);
+  AABB getPolygonAABB(const NPolygon& polygon);
+  AABB getPolygonAABB(const Point* vertices, int32_t numVertices);
+  bool areTwoAABBsIntersecting(const AABB& box0, const AABB& box1);
+  PreparedNPolygon prepareNPolygon(const NPolygon& polygon);
+  bool isPointWithinNPolygon(const Point& point,
+                             const PreparedNPolygon& polygon);
+  bool isRectWithinNPolygon(const Rectangle& rect,
+                            const PreparedNPolygon& polygon);
+  bool isRectWithinNPolygon(const PreparedRectangle& rect,
+                            const PreparedNPolygon& polygon);
+  bool isRectIntersectingNPolygon(const Rectangle& rect,
+                                  const PreparedNPolygon& polygon);
+  bool isRectIntersectingNPolygon(const PreparedRectangle& rect,
+                                  const PreparedNPolygon& polygon);
+
+  // Circles that are just touching a shape are considered to be intersecting
+  // it. Distances are the shortest distances between the shapes, and are 0
+  // for shapes that intersect. Lines are treated as line segments.
+  bool areTwoCirclesIntersecting(const Circle& circle0, const Circle& circle1);
+  bool isCircleIntersectingRect(const Circle& circle, const Rectangle& rect);
+  bool isCircleIntersectingNPolygon(const Circle& circle,
+                                    const NPolygon& polygon);
+  bool isCircleIntersectingNPolygon(const Circle& circle,
+                                    const Point* vertices,
+                                    int32_t numVertices);
+  bool isCircleIntersectingLine(const Circle& circle, const Line& line);
+  float distCircleToCircle(const Circle& circle0, const Circle& circle1);
+  float distCircleToRect(const Circle& circle, const Rectangle& rect);
+  float distCircleToNPolygon(const Circle& circle, const NPolygon& polygon);
+  float distCircleToNPolygon(const Circle& circle,
+                             const Point* vertices,
+                             int32_t numVertices);
+  float distCircleToLine(const Circle& circle, const Line& line);
+  Circle getRectBoundingCircle(const Rectangle& rect);
+
+  // Versions of the functions above for polygons whose vertices are stored
+  // with allocators other than the default one. The clipping functions return
+  // polygons whose vertices are allocated with the given allocator.
+  template <typename Allocator>
+  BasicNPolygon<Allocator> clippedPolygonFromTwoRects(
+      const Rectangle& targetRect,
+      const Rectangle& clippingRect,
+      const Allocator& allocator)
+  {
+    FixedNPolygon<8> fixedPolygon;
+    clippedPolygonFromTwoRects(targetRect, clippingRect, fixedPolygon);
+
+    BasicNPolygon<Allocator> clippedPolygon;
+    clippedPolygon.vertices.set_allocator(allocator);
+    clippedPolygon.vertices.assign(fixedPolygon.vertices.begin(),
+                                   fixedPolygon.vertices.end());
+    return clippedPolygon;
+  }
+
+  template <typename Allocator>
+  BasicNPolygon<Allocator> clippedPolygonFromTwoRects(
+      const PreparedRectangle& targetRect,
+      const PreparedRectangle& clippingRect,
+      const Allocator& allocator)
+  {
+    FixedNPolygon<8> fixedPolygon;
+    clippedPolygonFromTwoRects(targetRect, clippingRect, fixedPolygon);
+
+    BasicNPolygon<Allocator> clippedPolygon;
+    clippedPolygon.vertices.set_allocator(allocator);
+    clippedPolygon.vertices.assign(fixedPolygon.vertices.begin(),
+                                   fixedPolygon.vertices.end());
+    return clippedPolygon;
+  }
+
+  template <typename Allocator>
+  Point getPolygonCentroid(const BasicNPolygon<Allocator>& polygon)
+  {
+    return getPolygonCentroid(polygon.vertices.data(),
+                              static_cast<int32_t>(polygon.vertices.size()));
+  }
+
+  template <typename Allocator>
+  double getPolygonArea(const BasicNPolygon<Allocator>& polygon)
+  {
+    return getPolygonArea(polygon.vertices.data(),
+                          static_cast<int32_t>(polygon.vertices.size()));
+  }
+
+  template <typename Allocator>
+  PolygonProperties getPolygonProperties(
+      const BasicNPolygon<Allocator>& polygon)
+  {
+    return getPolygonProperties(polygon.vertices.data(),
+                                static_cast<int32_t>(polygon.vertices.size()));
+  }
+
+  template <typename Allocator>
+  bool isPointWithinNPolygon(const Point& point,
+                             const BasicNPolygon<Allocator>& polygon)
+  {
+    return isPointWithinNPolygon(point,
+                                 polygon.vertices.data(),
+                                 static_cast<int32_t>(polygon.vertices.size()));
+  }
+
+  template <typename Allocator>
+  AABB getPolygonAABB(const BasicNPolygon<Allocator>& polygon)
+  {
+    return getPolygonAABB(polygon.vertices.data(),
+                          static_cast<int32_t>(polygon.vertices.size()));
+  }
+
+  template <typename Allocator>
+  bool isCircleIntersectingNPolygon(const Circle& circle,
+                                    const BasicNPolygon<Allocator>& polygon)
+  {
+    return isCircleIntersectingNPolygon(
+      circle,
+      polygon.vertices.data(),
+      static_cast<int32_t>(polygon.vertices.size()));
+  }
+
+  template <typename Allocator>
+  float distCircleToNPolygon(const Circle& circle,
+                             const BasicNPolygon<Allocator>& polygon)
+  {
+    return distCircleToNPolygon(circle,
+                                polygon.vertices.data(),
+                                static_cast<int32_t>(polygon.vertices.size()));
+  }
 }
 
 #endif
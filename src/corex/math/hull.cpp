@@ -0,0 +1,207 @@
+#include <cstdint>
+
+#include <EASTL/algorithm.h>
+#include <EASTL/sort.h>
+#include <EASTL/vector.h>
+
+#include <corex/math/ds.hpp>
+#include <corex/math/hull.hpp>
+#include <corex/math/instrumentation.hpp>
+
+namespace cx
+{
+  struct HullPointOrder
+  {
+    bool operator()(const Point& point0, const Point& point1) const;
+  };
+
+  static bool addToHullChain(eastl::vector<Point>& chain,
+                             const Point& point,
+                             double side);
+  static double getOrientation(const Point& point0,
+                               const Point& point1,
+                               const Point& point2);
+
+  int32_t getConvexHullVertices(const Point* points,
+                                int32_t numPoints,
+                                Point* hullVertices,
+                                Point* scratchPoints)
+  {
+    COREX_MATH_INSTRUMENT(getConvexHullVertices);
+    if (numPoints <= 0) {
+      return 0;
+    }
+
+    for (int32_t i = 0; i < numPoints; i++) {
+      scratchPoints[i] = points[i];
+    }
+
+    eastl::sort(scratchPoints, scratchPoints + numPoints, HullPointOrder{});
+    const Point& firstPoint = scratchPoints[0];
+    const Point& lastPoint = scratchPoints[numPoints - 1];
+    if (firstPoint.x == lastPoint.x && firstPoint.y == lastPoint.y) {
+      hullVertices[0] = firstPoint;
+      return 1;
+    }
+
+    // The lower chain goes into the hull vertices, from left to right, and
+    // only keeps points that make a left turn in a y-up coordinate system.
+    int32_t numLowerVertices = 0;
+    for (int32_t i = 0; i < numPoints; i++) {
+      while (numLowerVertices >= 2
+             && getOrientation(hullVertices[numLowerVertices - 2],
+                               hullVertices[numLowerVertices - 1],
+                               scratchPoints[i]) <= 0.0) {
+        numLowerVertices--;
+      }
+
+      hullVertices[numLowerVertices++] = scratchPoints[i];
+    }
+
+    // The upper chain is built the same way, but from right to left, in the
+    // sorted points themselves. It grows down from the end of them, and only
+    // ever has as many points as have been read, so it never overwrites a
+    // point that still needs to be read.
+    int32_t upperStart = numPoints;
+    for (int32_t i = numPoints - 1; i >= 0; i--) {
+      Point point = scratchPoints[i];
+      while (numPoints - upperStart >= 2
+             && getOrientation(scratchPoints[upperStart + 1],
+                               scratchPoints[upperStart],
+                               point) <= 0.0) {
+        upperStart++;
+      }
+
+      scratchPoints[--upperStart] = point;
+    }
+
+    // The upper chain goes from the rightmost point back to the leftmost one,
+    // both of which are already at the ends of the lower chain.
+    int32_t numHullVertices = numLowerVertices;
+    for (int32_t i = numPoints - 2; i > upperStart; i--) {
+      hullVertices[numHullVertices++] = scratchPoints[i];
+    }
+
+    return numHullVertices;
+  }
+
+  bool addToConvexHull(IncrementalConvexHull& hull, const Point& point)
+  {
+    COREX_MATH_INSTRUMENT(addToConvexHull);
+
+    // Each chain is updated on its own, just like the monotone chain
+    // algorithm would, had the point been there from the start.
+    bool isLowerChainChanged = addToHullChain(hull.lowerChain, point, 1.0);
+    bool isUpperChainChanged = addToHullChain(hull.upperChain, point, -1.0);
+    return isLowerChainChanged || isUpperChainChanged;
+  }
+
+  void addToConvexHull(IncrementalConvexHull& hull,
+                       const Point* points,
+                       int32_t numPoints)
+  {
+    for (int32_t i = 0; i < numPoints; i++) {
+      addToConvexHull(hull, points[i]);
+    }
+  }
+
+  int32_t getNumConvexHullVertices(const IncrementalConvexHull& hull)
+  {
+    auto numLowerVertices = static_cast<int32_t>(hull.lowerChain.size());
+    auto numUpperVertices = static_cast<int32_t>(hull.upperChain.size());
+    if (numLowerVertices <= 1) {
+      return numLowerVertices;
+    }
+
+    // The ends of the chains are shared.
+    return numLowerVertices + numUpperVertices - 2;
+  }
+
+  int32_t getConvexHullVertices(const IncrementalConvexHull& hull,
+                                Point* hullVertices)
+  {
+    COREX_MATH_INSTRUMENT(getConvexHullVertices);
+    auto numLowerVertices = static_cast<int32_t>(hull.lowerChain.size());
+    auto numUpperVertices = static_cast<int32_t>(hull.upperChain.size());
+    int32_t numHullVertices = 0;
+    for (int32_t i = 0; i < numLowerVertices; i++) {
+      hullVertices[numHullVertices++] = hull.lowerChain[i];
+    }
+
+    for (int32_t i = numUpperVertices - 2; i > 0; i--) {
+      hullVertices[numHullVertices++] = hull.upperChain[i];
+    }
+
+    return numHullVertices;
+  }
+
+  bool HullPointOrder::operator()(const Point& point0,
+                                  const Point& point1) const
+  {
+    return (point0.x < point1.x)
+           || (point0.x == point1.x && point0.y < point1.y);
+  }
+
+  static bool addToHullChain(eastl::vector<Point>& chain,
+                             const Point& point,
+                             double side)
+  {
+    // A chain only keeps points at which it turns towards the given side,
+    // i.e. to the left in a y-up coordinate system for the lower chain, and
+    // to the right for the upper chain.
+    auto position = eastl::upper_bound(chain.begin(),
+                                       chain.end(),
+                                       point,
+                                       HullPointOrder{});
+    if (position != chain.begin()) {
+      const Point& previousPoint = *(position - 1);
+      if (previousPoint.x == point.x && previousPoint.y == point.y) {
+        // Already in the chain.
+        return false;
+      }
+
+      if (position != chain.end()
+          && side * getOrientation(previousPoint, point, *position) <= 0.0) {
+        // The point is on the inner side of the chain.
+        return false;
+      }
+    }
+
+    position = chain.insert(position, point);
+
+    // The neighbours of the new point that the chain no longer turns at are
+    // removed, on both sides of it.
+    auto firstRemoved = position;
+    while (firstRemoved - chain.begin() >= 2
+           && side * getOrientation(*(firstRemoved - 2),
+                                    *(firstRemoved - 1),
+                                    point) <= 0.0) {
+      firstRemoved--;
+    }
+
+    auto lastRemoved = position + 1;
+    while (chain.end() - lastRemoved >= 2
+           && side * getOrientation(point,
+                                    *lastRemoved,
+                                    *(lastRemoved + 1)) <= 0.0) {
+      lastRemoved++;
+    }
+
+    chain.erase(position + 1, lastRemoved);
+    chain.erase(firstRemoved, position);
+    return true;
+  }
+
+  static double getOrientation(const Point& point0,
+                               const Point& point1,
+                               const Point& point2)
+  {
+    // Positive if the third point is to the left of the line from the first
+    // point to the second, when going from the first point to the second in
+    // a y-up coordinate system.
+    return ((static_cast<double>(point1.x) - point0.x)
+            * (static_cast<double>(point2.y) - point0.y))
+           - ((static_cast<double>(point1.y) - point0.y)
+              * (static_cast<double>(point2.x) - point0.x));
+  }
+}
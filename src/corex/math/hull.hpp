@@ -0,0 +1,127 @@
+#ifndef COREX_MATH_HULL_HPP
+#define COREX_MATH_HULL_HPP
+
+#include <cstdint>
+
+#include <EASTL/vector.h>
+
+#include <corex/math/ds.hpp>
+#include <corex/utils.hpp>
+
+namespace cx
+{
+  // Convex hulls of sets of points, e.g. to get a cheap collision shape out
+  // of the outline of a sprite or a cluster of particles.
+  //
+  // Hulls are wound like the polygons from rotateRectangle(), i.e. clockwise
+  // in the windowing system, where the y axis points down, which is a
+  // positive signed area in getPolygonProperties(). So, they can be given
+  // directly to the separating axis tests and to the clipping functions. A
+  // hull starts at its leftmost vertex, and has no collinear vertices. The
+  // hull of points that are all on a line has the two ends of the line as
+  // its vertices, and the hull of a single distinct point has just that
+  // point.
+  //
+  // Orientations are computed in doubles from the float coordinates.
+
+  // Monotone chain algorithm, in O(N log N) time for N points. Writes the
+  // hull to hullVertices and returns its number of vertices. Both
+  // hullVertices and scratchPoints must have room for numPoints points. The
+  // points themselves are left untouched.
+  int32_t getConvexHullVertices(const Point* points,
+                                int32_t numPoints,
+                                Point* hullVertices,
+                                Point* scratchPoints);
+
+  // Online version, for points that come in over time. Only finding out
+  // whether a point is within the hull takes O(log H) time, for a hull with
+  // H vertices, which is all that adding a point within the hull takes.
+  // Adding a point outside of it inserts the point into the vertex array,
+  // which takes O(H) time. Returns whether the hull changed.
+  bool addToConvexHull(IncrementalConvexHull& hull, const Point& point);
+  void addToConvexHull(IncrementalConvexHull& hull,
+                       const Point* points,
+                       int32_t numPoints);
+  int32_t getNumConvexHullVertices(const IncrementalConvexHull& hull);
+
+  // hullVertices must have room for getNumConvexHullVertices() vertices.
+  int32_t getConvexHullVertices(const IncrementalConvexHull& hull,
+                                Point* hullVertices);
+
+  // The hull, including the scratch memory needed to build it, is allocated
+  // with the allocator of the hull.
+  template <typename Allocator>
+  void convexHullFromPoints(const Point* points,
+                            int32_t numPoints,
+                            BasicNPolygon<Allocator>& hull)
+  {
+    eastl::vector<Point, Allocator> scratchPoints{
+      hull.vertices.get_allocator()
+    };
+    scratchPoints.resize(numPoints);
+    hull.vertices.resize(numPoints);
+
+    int32_t numHullVertices = getConvexHullVertices(points,
+                                                    numPoints,
+                                                    hull.vertices.data(),
+                                                    scratchPoints.data());
+    hull.vertices.resize(numHullVertices);
+  }
+
+  template <typename SegmentsAllocator, typename Allocator>
+  void convexHullFromLineSegments(
+      const BasicLineSegments<SegmentsAllocator>& segments,
+      BasicNPolygon<Allocator>& hull)
+  {
+    convexHullFromPoints(segments.vertices.data(),
+                         static_cast<int32_t>(segments.vertices.size()),
+                         hull);
+  }
+
+  template <typename PolygonAllocator, typename Allocator>
+  void convexHullFromNPolygon(const BasicNPolygon<PolygonAllocator>& polygon,
+                              BasicNPolygon<Allocator>& hull)
+  {
+    convexHullFromPoints(polygon.vertices.data(),
+                         static_cast<int32_t>(polygon.vertices.size()),
+                         hull);
+  }
+
+  template <typename Allocator>
+  void convexHullFromIncrementalHull(const IncrementalConvexHull& hull,
+                                     BasicNPolygon<Allocator>& polygon)
+  {
+    polygon.vertices.resize(getNumConvexHullVertices(hull));
+    getConvexHullVertices(hull, polygon.vertices.data());
+  }
+
+  // For when the number of vertices of the hull is known beforehand, e.g. a
+  // quadrilateral from four points. RETURN_FAIL is returned if the hull ends
+  // up with a different number of vertices. scratchPoints must have room for
+  // twice numPoints points.
+  template <uint numVertices>
+  ReturnValue<Polygon<numVertices>> convexHullPolygonFromPoints(
+      const Point* points,
+      int32_t numPoints,
+      Point* scratchPoints)
+  {
+    Polygon<numVertices> hull{};
+    int32_t numHullVertices = getConvexHullVertices(points,
+                                                    numPoints,
+                                                    scratchPoints,
+                                                    scratchPoints + numPoints);
+    if (numHullVertices != static_cast<int32_t>(numVertices)) {
+      return ReturnValue<Polygon<numVertices>>{
+        hull, ReturnState::RETURN_FAIL
+      };
+    }
+
+    for (int32_t i = 0; i < numHullVertices; i++) {
+      hull.vertices[i] = scratchPoints[i];
+    }
+
+    return ReturnValue<Polygon<numVertices>>{ hull, ReturnState::RETURN_OK };
+  }
+}
+
+#endif
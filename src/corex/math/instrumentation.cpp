@@ -0,0 +1,288 @@
+#include <cstdint>
+
+#include <EASTL/array.h>
+
+#include <corex/math/instrumentation.hpp>
+
+#if defined(COREX_MATH_INSTRUMENTATION)
+  #include <atomic>
+  #include <chrono>
+  #include <mutex>
+
+  #include <EASTL/algorithm.h>
+  #include <EASTL/vector.h>
+
+  #if defined(__x86_64__) || defined(__i386__)
+    #include <x86intrin.h>
+  #endif
+#endif
+
+namespace cx
+{
+  static const char* instrumentedFunctionNames[] = {
+    "pow",
+    "vec2Magnitude",
+    "vec2Angle",
+    "rotationFromAngle",
+    "rotateVec2",
+    "projectVec2",
+    "vec2Perp",
+    "minVec2Magnitude",
+    "maxVec2Magnitude",
+    "unitVector",
+    "lineDirectionVector",
+    "lineNormalVector",
+    "projectRectToAnAxis",
+    "distance2D",
+    "lineLength",
+    "signedDistPointToInfLine",
+    "rotateRectangle",
+    "areTwoRectsIntersectingInAnAxis",
+    "areTwoRectsIntersecting",
+    "prepareRectangle",
+    "updatePreparedRectangle",
+    "intersectionOfTwoInfLines",
+    "intersectionOfLineandInfLine",
+    "intersectionOfLineAndLine",
+    "areTwoLinesIntersecting",
+    "clippedPolygonFromTwoRects",
+    "getPolygonCentroid",
+    "getPolygonArea",
+    "getPolygonProperties",
+    "isPointWithinNPolygon",
+    "isRectWithinNPolygon",
+    "isRectIntersectingNPolygon",
+    "getRectangleAABB",
+    "getPolygonAABB",
+    "areTwoAABBsIntersecting",
+    "prepareNPolygon",
+    "areTwoCirclesIntersecting",
+    "isCircleIntersectingRect",
+    "isCircleIntersectingNPolygon",
+    "isCircleIntersectingLine",
+    "distCircleToCircle",
+    "distCircleToRect",
+    "distCircleToNPolygon",
+    "distCircleToLine",
+    "getRectBoundingCircle",
+    "convertRectangleToPolygon",
+    "longestLine",
+    "clippedPolygonFromTwoConvexPolygons",
+    "getConvexPolygonsOverlapArea",
+    "clipConvexPolygonPairs",
+    "getConvexPolygonPairsOverlapAreas",
+    "areRectPairsIntersecting",
+    "arePointsWithinNPolygon",
+    "clipRectPairs",
+    "getPolygonAreas",
+    "getPolygonCentroids",
+    "getPolygonBufferProperties",
+    "areCirclePairsIntersecting",
+    "areCirclesIntersectingRects",
+    "areCirclesIntersectingNPolygon",
+    "insertIntoGrid",
+    "moveInGrid",
+    "removeFromGrid",
+    "findGridCandidatePairs",
+    "queryGrid",
+    "insertIntoTree",
+    "moveInTree",
+    "removeFromTree",
+    "queryTree",
+    "findTreeCandidatePairs",
+    "findTreeVsTreeCandidatePairs",
+    "quantizeNPolygon",
+    "dequantizeNPolygon",
+    "getRectsTimeOfImpact",
+    "getRectPairsTimesOfImpact",
+    "findSegmentIntersections",
+    "findPolylineIntersections",
+    "getConvexHullVertices",
+    "addToConvexHull",
+    "triangulatePolygon",
+    "areConvexShapesIntersecting",
+    "getConvexShapesPenetration",
+    "evictStaleSeparatingAxes",
+  };
+
+  static_assert(sizeof(instrumentedFunctionNames) / sizeof(const char*)
+                == numInstrumentedFunctions,
+                "Every instrumented function must have a name.");
+
+  const char* getInstrumentedFunctionName(InstrumentedFunction function)
+  {
+    return instrumentedFunctionNames[static_cast<int32_t>(function)];
+  }
+
+#if defined(COREX_MATH_INSTRUMENTATION)
+  // Only the owning thread writes to its counters. Atomics are still used so
+  // that a profiler thread can read them without tearing. Since there is only
+  // one writer, the counters can be incremented with a relaxed load and store,
+  // instead of a more expensive read-modify-write.
+  struct ThreadFunctionCounters
+  {
+    std::atomic<uint64_t> numCalls;
+    std::atomic<uint64_t> numCycles;
+    std::atomic<uint64_t> cycleHistogram[numCycleHistogramBuckets];
+  };
+
+  struct ThreadCounters
+  {
+    ThreadCounters();
+    ~ThreadCounters();
+
+    ThreadFunctionCounters functions[numInstrumentedFunctions];
+  };
+
+  // All of these are guarded by the registry mutex.
+  struct InstrumentationRegistry
+  {
+    std::mutex mutex;
+    eastl::vector<ThreadCounters*> threadCounters;
+
+    // Stats of threads that have exited.
+    InstrumentationSnapshot exitedThreadStats;
+
+    InstrumentationSnapshot baseline;
+  };
+
+  static InstrumentationRegistry& getRegistry();
+  static void incrementCounter(std::atomic<uint64_t>& counter, uint64_t amount);
+  static uint64_t readCycleCounter();
+  static void addThreadCounters(InstrumentationSnapshot& snapshot,
+                                const ThreadCounters& counters);
+  static void takeTotalSnapshot(InstrumentationRegistry& registry,
+                                InstrumentationSnapshot& snapshot);
+
+  // Registering with the registry takes a lock, but that only happens on the
+  // first instrumented call of a thread.
+  static thread_local ThreadCounters threadCounters;
+
+  ThreadCounters::ThreadCounters()
+  {
+    for (ThreadFunctionCounters& function : this->functions) {
+      function.numCalls.store(0, std::memory_order_relaxed);
+      function.numCycles.store(0, std::memory_order_relaxed);
+      for (std::atomic<uint64_t>& bucket : function.cycleHistogram) {
+        bucket.store(0, std::memory_order_relaxed);
+      }
+    }
+
+    InstrumentationRegistry& registry = getRegistry();
+    std::lock_guard<std::mutex> lock{registry.mutex};
+    registry.threadCounters.push_back(this);
+  }
+
+  ThreadCounters::~ThreadCounters()
+  {
+    // Keep the stats of the thread around, so that they aren't lost once the
+    // thread exits.
+    InstrumentationRegistry& registry = getRegistry();
+    std::lock_guard<std::mutex> lock{registry.mutex};
+    addThreadCounters(registry.exitedThreadStats, *this);
+    registry.threadCounters.erase(eastl::find(registry.threadCounters.begin(),
+                                              registry.threadCounters.end(),
+                                              this));
+  }
+
+  ScopedInstrumentation::ScopedInstrumentation(InstrumentedFunction function)
+    : function{function}
+    , startCycles{readCycleCounter()} {}
+
+  ScopedInstrumentation::~ScopedInstrumentation()
+  {
+    uint64_t numCycles = readCycleCounter() - this->startCycles;
+
+    // Equivalent to floor(log2(numCycles)), but with zero cycles going to the
+    // first bucket.
+    int32_t bucket = 63 - __builtin_clzll(numCycles | 1);
+    bucket = eastl::min(bucket, numCycleHistogramBuckets - 1);
+
+    ThreadFunctionCounters& counters = threadCounters.functions[
+      static_cast<int32_t>(this->function)];
+    incrementCounter(counters.numCalls, 1);
+    incrementCounter(counters.numCycles, numCycles);
+    incrementCounter(counters.cycleHistogram[bucket], 1);
+  }
+
+  void takeInstrumentationSnapshot(InstrumentationSnapshot& snapshot)
+  {
+    InstrumentationRegistry& registry = getRegistry();
+    std::lock_guard<std::mutex> lock{registry.mutex};
+    takeTotalSnapshot(registry, snapshot);
+
+    for (int32_t i = 0; i < numInstrumentedFunctions; i++) {
+      FunctionStats& stats = snapshot.functions[i];
+      const FunctionStats& baseline = registry.baseline.functions[i];
+      stats.numCalls -= baseline.numCalls;
+      stats.numCycles -= baseline.numCycles;
+      for (int32_t b = 0; b < numCycleHistogramBuckets; b++) {
+        stats.cycleHistogram[b] -= baseline.cycleHistogram[b];
+      }
+    }
+  }
+
+  void resetInstrumentation()
+  {
+    InstrumentationRegistry& registry = getRegistry();
+    std::lock_guard<std::mutex> lock{registry.mutex};
+    takeTotalSnapshot(registry, registry.baseline);
+  }
+
+  static InstrumentationRegistry& getRegistry()
+  {
+    // Threads may exit after static objects get destroyed, so let's never
+    // destroy the registry.
+    static InstrumentationRegistry* registry = new InstrumentationRegistry{};
+    return *registry;
+  }
+
+  static void incrementCounter(std::atomic<uint64_t>& counter, uint64_t amount)
+  {
+    counter.store(counter.load(std::memory_order_relaxed) + amount,
+                  std::memory_order_relaxed);
+  }
+
+  static uint64_t readCycleCounter()
+  {
+  #if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+  #else
+    // No cycle counter that we can read, so nanoseconds will have to do.
+    return static_cast<uint64_t>(
+      std::chrono::steady_clock::now().time_since_epoch().count());
+  #endif
+  }
+
+  static void addThreadCounters(InstrumentationSnapshot& snapshot,
+                                const ThreadCounters& counters)
+  {
+    for (int32_t i = 0; i < numInstrumentedFunctions; i++) {
+      FunctionStats& stats = snapshot.functions[i];
+      const ThreadFunctionCounters& function = counters.functions[i];
+      stats.numCalls += function.numCalls.load(std::memory_order_relaxed);
+      stats.numCycles += function.numCycles.load(std::memory_order_relaxed);
+      for (int32_t b = 0; b < numCycleHistogramBuckets; b++) {
+        stats.cycleHistogram[b] += function.cycleHistogram[b].load(
+          std::memory_order_relaxed);
+      }
+    }
+  }
+
+  static void takeTotalSnapshot(InstrumentationRegistry& registry,
+                                InstrumentationSnapshot& snapshot)
+  {
+    snapshot = registry.exitedThreadStats;
+    for (const ThreadCounters* counters : registry.threadCounters) {
+      addThreadCounters(snapshot, *counters);
+    }
+  }
+#else
+  void takeInstrumentationSnapshot(InstrumentationSnapshot& snapshot)
+  {
+    snapshot = InstrumentationSnapshot{};
+  }
+
+  void resetInstrumentation() {}
+#endif
+}
@@ -0,0 +1,190 @@
+#ifndef COREX_MATH_INSTRUMENTATION_HPP
+#define COREX_MATH_INSTRUMENTATION_HPP
+
+#include <cstdint>
+
+#include <EASTL/array.h>
+
+namespace cx
+{
+  // Instrumentation of the public functions, for finding out which functions
+  // dominate a frame. It is compiled out entirely unless
+  // COREX_MATH_INSTRUMENTATION is defined, which the CMake option of the same
+  // name does. When compiled out, snapshots will always be empty.
+  //
+  // Each thread keeps its own counters, so instrumented calls never take a
+  // lock. Timings are in CPU cycles, and include the time spent in any
+  // instrumented function called by the function. Overloads of a function
+  // share the same counters.
+  enum class InstrumentedFunction : int32_t
+  {
+    // algebra
+    pow,
+
+    // linear_algebra
+    vec2Magnitude,
+    vec2Angle,
+    rotationFromAngle,
+    rotateVec2,
+    projectVec2,
+    vec2Perp,
+    minVec2Magnitude,
+    maxVec2Magnitude,
+    unitVector,
+    lineDirectionVector,
+    lineNormalVector,
+    projectRectToAnAxis,
+
+    // geometry
+    distance2D,
+    lineLength,
+    signedDistPointToInfLine,
+    rotateRectangle,
+    areTwoRectsIntersectingInAnAxis,
+    areTwoRectsIntersecting,
+    prepareRectangle,
+    updatePreparedRectangle,
+    intersectionOfTwoInfLines,
+    intersectionOfLineandInfLine,
+    intersectionOfLineAndLine,
+    areTwoLinesIntersecting,
+    clippedPolygonFromTwoRects,
+    getPolygonCentroid,
+    getPolygonArea,
+    getPolygonProperties,
+    isPointWithinNPolygon,
+    isRectWithinNPolygon,
+    isRectIntersectingNPolygon,
+    getRectangleAABB,
+    getPolygonAABB,
+    areTwoAABBsIntersecting,
+    prepareNPolygon,
+    areTwoCirclesIntersecting,
+    isCircleIntersectingRect,
+    isCircleIntersectingNPolygon,
+    isCircleIntersectingLine,
+    distCircleToCircle,
+    distCircleToRect,
+    distCircleToNPolygon,
+    distCircleToLine,
+    getRectBoundingCircle,
+
+    // utils
+    convertRectangleToPolygon,
+    longestLine,
+
+    // clipping
+    clippedPolygonFromTwoConvexPolygons,
+    getConvexPolygonsOverlapArea,
+    clipConvexPolygonPairs,
+    getConvexPolygonPairsOverlapAreas,
+
+    // batch
+    areRectPairsIntersecting,
+    arePointsWithinNPolygon,
+    clipRectPairs,
+    getPolygonAreas,
+    getPolygonCentroids,
+    getPolygonBufferProperties,
+    areCirclePairsIntersecting,
+    areCirclesIntersectingRects,
+    areCirclesIntersectingNPolygon,
+
+    // broadphase
+    insertIntoGrid,
+    moveInGrid,
+    removeFromGrid,
+    findGridCandidatePairs,
+    queryGrid,
+    insertIntoTree,
+    moveInTree,
+    removeFromTree,
+    queryTree,
+    findTreeCandidatePairs,
+    findTreeVsTreeCandidatePairs,
+
+    // quantization
+    quantizeNPolygon,
+    dequantizeNPolygon,
+
+    // continuous
+    getRectsTimeOfImpact,
+    getRectPairsTimesOfImpact,
+
+    // sweep
+    findSegmentIntersections,
+    findPolylineIntersections,
+
+    // hull
+    getConvexHullVertices,
+    addToConvexHull,
+
+    // triangulation
+    triangulatePolygon,
+
+    // narrowphase
+    areConvexShapesIntersecting,
+    getConvexShapesPenetration,
+
+    // coherence
+    evictStaleSeparatingAxes,
+    count
+  };
+
+  constexpr int32_t numInstrumentedFunctions = static_cast<int32_t>(
+    InstrumentedFunction::count);
+
+  // Bucket i counts the calls that took [2^i, 2^(i + 1)) cycles. The last
+  // bucket also counts all calls that took longer.
+  constexpr int32_t numCycleHistogramBuckets = 32;
+
+  struct FunctionStats
+  {
+    uint64_t numCalls;
+    uint64_t numCycles;
+    eastl::array<uint64_t, numCycleHistogramBuckets> cycleHistogram;
+  };
+
+  struct InstrumentationSnapshot
+  {
+    eastl::array<FunctionStats, numInstrumentedFunctions> functions;
+  };
+
+  const char* getInstrumentedFunctionName(InstrumentedFunction function);
+
+  // Gets the stats of all threads, including threads that have already
+  // exited, since the last reset. Resetting does not touch the counters of
+  // the threads. It only records the current stats as a baseline that later
+  // snapshots are subtracted by. So, these can be called from a profiler
+  // thread while other threads are making instrumented calls.
+  void takeInstrumentationSnapshot(InstrumentationSnapshot& snapshot);
+  void resetInstrumentation();
+
+#if defined(COREX_MATH_INSTRUMENTATION)
+  class ScopedInstrumentation
+  {
+  public:
+    explicit ScopedInstrumentation(InstrumentedFunction function);
+    ~ScopedInstrumentation();
+
+    ScopedInstrumentation(const ScopedInstrumentation&) = delete;
+    ScopedInstrumentation& operator=(const ScopedInstrumentation&) = delete;
+
+  private:
+    InstrumentedFunction function;
+    uint64_t startCycles;
+  };
+#endif
+}
+
+// Put at the start of a function to record its calls.
+#if defined(COREX_MATH_INSTRUMENTATION)
+  #define COREX_MATH_INSTRUMENT(function) \
+    cx::ScopedInstrumentation corexMathScopedInstrumentation{ \
+      cx::InstrumentedFunction::function \
+    }
+#else
+  #define COREX_MATH_INSTRUMENT(function)
+#endif
+
+#endif
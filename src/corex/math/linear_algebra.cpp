@@ -3,24 +3,29 @@
 #include <corex/utils.hpp>
 #include <corex/math/ds.hpp>
 #include <corex/math/geometry.hpp>
+#include <corex/math/instrumentation.hpp>
 #include <corex/math/linear_algebra.hpp>
 #include <corex/math/utils.hpp>
 
 namespace cx
 {
-  float det3x3(const Vec2& v0, const Vec2& v1, const Vec2& v2)
+  static const Rotation& perpRotation()
   {
-    return ((v1.x * v2.y) + (v0.x * v1.y) + (v0.y * v2.x))
-           - ((v0.y * v1.x) + (v1.y * v2.x) + (v0.x * v2.y));
+    // Perpendiculars and normals are always a -90 degree rotation away, so
+    // let's only compute its cosine and sine once.
+    static const Rotation rotation = rotationFromAngle(-90.f);
+    return rotation;
   }
 
   float vec2Magnitude(const Vec2& p)
   {
+    COREX_MATH_INSTRUMENT(vec2Magnitude);
     return distance2D(Vec2{0.f, 0.f}, p);
   }
 
   float vec2Angle(const Vec2& p)
   {
+    COREX_MATH_INSTRUMENT(vec2Angle);
     // Based on: https://stackoverflow.com/a/48227232/1116098
     // Returns the angle in degrees. Note also that we are using the
     // standard Cartesian coordinate plane, not the window space Cartesian
@@ -51,14 +56,12 @@ namespace cx
     }
   }
 
-  float dotProduct(const Vec2& p, const Vec2& q)
+  Rotation rotationFromAngle(float angle)
   {
-    return (p.x * q.x) + (p.y * q.y);
-  }
-
-  float crossProduct(const Vec2& p, const Vec2& q)
-  {
-    return (p.x * p.y) - (p.y * q.x);
+    COREX_MATH_INSTRUMENT(rotationFromAngle);
+    // The angle parameter is expected to be in degrees.
+    float angleRadians = degreesToRadians(angle);
+    return Rotation{ std::cos(angleRadians), std::sin(angleRadians) };
   }
 
   Vec2 rotateVec2(const Vec2& p, float angle)
@@ -66,24 +69,27 @@ namespace cx
     // The angle parameter is expected to be in degrees. And we subtract the
     // angle by 360 so that we can rotate the point counterclockwise, which is
     // the rotation direction we usually expect,
-    float angleRadians = degreesToRadians(angle);
+    return rotateVec2(p, rotationFromAngle(angle));
+  }
+
+  Vec2 rotateVec2(const Vec2& p, const Rotation& rotation)
+  {
+    COREX_MATH_INSTRUMENT(rotateVec2);
     return Vec2{
-        setDecPlaces(
-            (p.x * std::cos(angleRadians)) - (p.y * std::sin(angleRadians)),
-            6),
-        setDecPlaces(
-            (p.x * std::sin(angleRadians)) + (p.y * std::cos(angleRadians)),
-            6)
+        setDecPlaces((p.x * rotation.cosine) - (p.y * rotation.sine), 6),
+        setDecPlaces((p.x * rotation.sine) + (p.y * rotation.cosine), 6)
     };
   }
 
   Vec2 projectVec2(const Vec2& p, const Vec2& q)
   {
+    COREX_MATH_INSTRUMENT(projectVec2);
     return static_cast<float>(dotProduct(p, q) / pow(vec2Magnitude(q), 2)) * q;
   }
 
   Vec2 vec2Perp(const Vec2& p)
   {
+    COREX_MATH_INSTRUMENT(vec2Perp);
     // Vectors are arranged in a clockwise direction. This means that their
     // perpendiculars must be rotated counterclockwise. However, since the
     // origin is at the top left corner, rather than the bottom left, positive
@@ -94,16 +100,12 @@ namespace cx
     //       that's the most intuitive way. The math library must not worry
     //       about the coordinate system being used by top-level systems like
     //       the windowing system.
-    return rotateVec2(p, -90.f);
-  }
-
-  Vec2 translateVec2(const Vec2& vec, float deltaX, float deltaY)
-  {
-    return Vec2{vec.x + deltaX, vec.y + deltaY};
+    return rotateVec2(p, perpRotation());
   }
 
   Vec2 minVec2Magnitude(const eastl::vector<Vec2*> vectors)
   {
+    COREX_MATH_INSTRUMENT(minVec2Magnitude);
     // We don't want copies and references can't hold null objects.
     Vec2* minVec = nullptr;
     bool isFirstElement = true;
@@ -121,6 +123,7 @@ namespace cx
 
   Vec2 maxVec2Magnitude(const eastl::vector<Vec2*> vectors)
   {
+    COREX_MATH_INSTRUMENT(maxVec2Magnitude);
     // We don't want copies and references can't hold null objects.
     Vec2* maxVec = nullptr;
     bool isFirstElement = true;
@@ -138,37 +141,48 @@ namespace cx
 
   Vec2 unitVector(const Vec2& vec)
   {
+    COREX_MATH_INSTRUMENT(unitVector);
     return vec / vec2Magnitude(vec);
   }
 
-  Vec2 lineToVec(const Line& line)
-  {
-    return Vec2{ line.end.x - line.start.x, line.end.y - line.start.y };
-  }
-
   Vec2 lineDirectionVector(const Line& line)
   {
+    COREX_MATH_INSTRUMENT(lineDirectionVector);
     return unitVector(lineToVec(line));
   }
 
   Vec2 lineNormalVector(const Line& line)
   {
+    COREX_MATH_INSTRUMENT(lineNormalVector);
     // The vertices of lines and polygons are arranged in a clockwise direction.
     // This means that the unit vectors representing the direction of lines must
     // be rotated counterclockwise. However, since the origin is at the top left
     // corner, rather than the bottom left, positive angles will be rotated
     // clockwise. As such, we have to use negative angles to rotate the unit
     // vectors counterclockwise to get the proper normal vectors of lines.
-    return rotateVec2(lineDirectionVector(line), -90.f);
+    return rotateVec2(lineDirectionVector(line), perpRotation());
   }
 
   Line projectRectToAnAxis(const Rectangle& rect, const Vec2& axis)
   {
-    auto rotatedRect = rotateRectangle(rect);
-    Point topLeftPt = rotatedRect.vertices[0];
-    Point topRightPt = rotatedRect.vertices[1];
-    Point bottomLeftPt = rotatedRect.vertices[3];
-    Point bottomRightPt = rotatedRect.vertices[2];
+    return projectRectToAnAxis(rect, rotationFromAngle(rect.angle), axis);
+  }
+
+  Line projectRectToAnAxis(const Rectangle& rect,
+                           const Rotation& rotation,
+                           const Vec2& axis)
+  {
+    return projectRectToAnAxis(rotateRectangle(rect, rotation), axis);
+  }
+
+  Line projectRectToAnAxis(const Polygon<4>& rectPolygon, const Vec2& axis)
+  {
+    COREX_MATH_INSTRUMENT(projectRectToAnAxis);
+    // The polygon is expected to be a rectangle from rotateRectangle().
+    Point topLeftPt = rectPolygon.vertices[0];
+    Point topRightPt = rectPolygon.vertices[1];
+    Point bottomLeftPt = rectPolygon.vertices[3];
+    Point bottomRightPt = rectPolygon.vertices[2];
     Point projectedTopLeftPt = projectVec2(topLeftPt, axis);
     Point projectedTopRightPt = projectVec2(topRightPt, axis);
     Point projectedBottomLeftPt = projectVec2(bottomLeftPt, axis);
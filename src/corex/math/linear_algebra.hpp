@@ -1,24 +1,60 @@
 #ifndef COREX_MATH_LINEAR_ALGEBRA_HPP
 #define COREX_MATH_LINEAR_ALGEBRA_HPP
 
+#include <EASTL/utility.h>
+#include <EASTL/vector.h>
+
+#include <corex/math/ds.hpp>
+
 namespace cx
 {
-  float det3x3(const Vec2& v0, const Vec2& v1, const Vec2& v2);
+  // The pure arithmetic functions are defined here, so that they can be
+  // inlined into loops and used in constant expressions.
+  inline constexpr float det3x3(const Vec2& v0, const Vec2& v1, const Vec2& v2)
+  {
+    return ((v1.x * v2.y) + (v0.x * v1.y) + (v0.y * v2.x))
+           - ((v0.y * v1.x) + (v1.y * v2.x) + (v0.x * v2.y));
+  }
+
+  inline constexpr float dotProduct(const Vec2& p, const Vec2& q)
+  {
+    return (p.x * q.x) + (p.y * q.y);
+  }
+
+  inline constexpr float crossProduct(const Vec2& p, const Vec2& q)
+  {
+    return (p.x * p.y) - (p.y * q.x);
+  }
+
+  inline constexpr Vec2 translateVec2(const Vec2& vec,
+                                      float deltaX,
+                                      float deltaY)
+  {
+    return Vec2{vec.x + deltaX, vec.y + deltaY};
+  }
+
+  inline constexpr Vec2 lineToVec(const Line& line)
+  {
+    return Vec2{ line.end.x - line.start.x, line.end.y - line.start.y };
+  }
+
   float vec2Magnitude(const Vec2& p);
   float vec2Angle(const Vec2& p);
-  float dotProduct(const Vec2& p, const Vec2& q);
-  float crossProduct(const Vec2& p, const Vec2& q);
+  Rotation rotationFromAngle(float angle);
   Vec2 rotateVec2(const Vec2& p, float angle);
+  Vec2 rotateVec2(const Vec2& p, const Rotation& rotation);
   Vec2 projectVec2(const Vec2& p, const Vec2& q);
   Vec2 vec2Perp(const Vec2& p);
-  Vec2 translateVec2(const Vec2& vec, float deltaX, float deltaY);
   Vec2 minVec2Magnitude(const eastl::vector<Vec2*> vectors);
   Vec2 maxVec2Magnitude(const eastl::vector<Vec2*> vectors);
   Vec2 unitVector(const Vec2& vec);
-  Vec2 lineToVec(const Line& line);
   Vec2 lineDirectionVector(const Line& line);
   Vec2 lineNormalVector(const Line& line);
   Line projectRectToAnAxis(const Rectangle& rect, const Vec2& axis);
+  Line projectRectToAnAxis(const Rectangle& rect,
+                           const Rotation& rotation,
+                           const Vec2& axis);
+  Line projectRectToAnAxis(const Polygon<4>& rectPolygon, const Vec2& axis);
 
   template <typename... Args>
   inline constexpr auto rotatePoint(Args&&... args)
@@ -0,0 +1,183 @@
+#include <cmath>
+#include <cstdint>
+
+#include <EASTL/numeric_limits.h>
+
+#include <corex/math/ds.hpp>
+#include <corex/math/narrowphase.hpp>
+
+namespace cx
+{
+  static bool reduceSegmentSimplex(Simplex& simplex);
+  static bool reduceTriangleSimplex(Simplex& simplex);
+  static void keepSimplexVertex(Simplex& simplex, int32_t index);
+  static void keepSimplexEdge(Simplex& simplex,
+                              int32_t index0,
+                              int32_t index1,
+                              double weight0,
+                              double weight1);
+
+  bool reduceSimplex(Simplex& simplex)
+  {
+    // The closest point is found with barycentric coordinates, in the same
+    // way as in Box2D's b2Distance().
+    bool isOriginInside = false;
+    if (simplex.numVertices == 1) {
+      simplex.vertices[0].weight = 1.0;
+    } else if (simplex.numVertices == 2) {
+      isOriginInside = reduceSegmentSimplex(simplex);
+    } else {
+      isOriginInside = reduceTriangleSimplex(simplex);
+    }
+
+    simplex.closestX = 0.0;
+    simplex.closestY = 0.0;
+    for (int32_t i = 0; i < simplex.numVertices; i++) {
+      simplex.closestX += simplex.vertices[i].weight * simplex.vertices[i].x;
+      simplex.closestY += simplex.vertices[i].weight * simplex.vertices[i].y;
+    }
+
+    return isOriginInside;
+  }
+
+  void initPolytope(Polytope& polytope,
+                    const PolytopeVertex& vertex0,
+                    const PolytopeVertex& vertex1,
+                    const PolytopeVertex& vertex2)
+  {
+    double cross = ((vertex1.x - vertex0.x) * (vertex2.y - vertex0.y))
+                   - ((vertex1.y - vertex0.y) * (vertex2.x - vertex0.x));
+    polytope.vertices.clear();
+    polytope.vertices.push_back(vertex0);
+    polytope.vertices.push_back((cross > 0.0) ? vertex1 : vertex2);
+    polytope.vertices.push_back((cross > 0.0) ? vertex2 : vertex1);
+  }
+
+  PolytopeEdge getClosestPolytopeEdge(const Polytope& polytope)
+  {
+    auto numVertices = static_cast<int32_t>(polytope.vertices.size());
+    PolytopeEdge closestEdge{
+      0, 0.0, 0.0, eastl::numeric_limits<double>::max()
+    };
+    for (int32_t i = 0; i < numVertices; i++) {
+      const PolytopeVertex& start = polytope.vertices[i];
+      const PolytopeVertex& end = polytope.vertices[
+        (i + 1 < numVertices) ? (i + 1) : 0
+      ];
+      double edgeX = end.x - start.x;
+      double edgeY = end.y - start.y;
+      double length = std::sqrt((edgeX * edgeX) + (edgeY * edgeY));
+      if (length == 0.0) {
+        continue;
+      }
+
+      // The vertices go counterclockwise, so the outward normal is the edge
+      // turned clockwise.
+      double normalX = edgeY / length;
+      double normalY = -edgeX / length;
+      double distance = (normalX * start.x) + (normalY * start.y);
+      if (distance < closestEdge.distance) {
+        closestEdge = PolytopeEdge{ i, normalX, normalY, distance };
+      }
+    }
+
+    return closestEdge;
+  }
+
+  static bool reduceSegmentSimplex(Simplex& simplex)
+  {
+    const SimplexVertex& vertex0 = simplex.vertices[0];
+    const SimplexVertex& vertex1 = simplex.vertices[1];
+    double edgeX = vertex1.x - vertex0.x;
+    double edgeY = vertex1.y - vertex0.y;
+
+    // The weights are the projections of the origin onto the edge, from the
+    // opposite end.
+    double weight0 = (vertex1.x * edgeX) + (vertex1.y * edgeY);
+    double weight1 = -((vertex0.x * edgeX) + (vertex0.y * edgeY));
+    if (weight1 <= 0.0) {
+      keepSimplexVertex(simplex, 0);
+    } else if (weight0 <= 0.0) {
+      keepSimplexVertex(simplex, 1);
+    } else {
+      keepSimplexEdge(simplex, 0, 1, weight0, weight1);
+    }
+
+    return false;
+  }
+
+  static bool reduceTriangleSimplex(Simplex& simplex)
+  {
+    const SimplexVertex& vertex0 = simplex.vertices[0];
+    const SimplexVertex& vertex1 = simplex.vertices[1];
+    const SimplexVertex& vertex2 = simplex.vertices[2];
+
+    // Edge regions, with the same weights as for a segment.
+    double edge01X = vertex1.x - vertex0.x;
+    double edge01Y = vertex1.y - vertex0.y;
+    double weight01To0 = (vertex1.x * edge01X) + (vertex1.y * edge01Y);
+    double weight01To1 = -((vertex0.x * edge01X) + (vertex0.y * edge01Y));
+
+    double edge02X = vertex2.x - vertex0.x;
+    double edge02Y = vertex2.y - vertex0.y;
+    double weight02To0 = (vertex2.x * edge02X) + (vertex2.y * edge02Y);
+    double weight02To2 = -((vertex0.x * edge02X) + (vertex0.y * edge02Y));
+
+    double edge12X = vertex2.x - vertex1.x;
+    double edge12Y = vertex2.y - vertex1.y;
+    double weight12To1 = (vertex2.x * edge12X) + (vertex2.y * edge12Y);
+    double weight12To2 = -((vertex1.x * edge12X) + (vertex1.y * edge12Y));
+
+    // Triangle region. The weights are the signed areas of the triangles
+    // that the origin makes with each edge, with the sign of the triangle.
+    double area = (edge01X * edge02Y) - (edge01Y * edge02X);
+    double weight0 = area * ((vertex1.x * vertex2.y) - (vertex1.y * vertex2.x));
+    double weight1 = area * ((vertex2.x * vertex0.y) - (vertex2.y * vertex0.x));
+    double weight2 = area * ((vertex0.x * vertex1.y) - (vertex0.y * vertex1.x));
+
+    if (weight01To1 <= 0.0 && weight02To2 <= 0.0) {
+      keepSimplexVertex(simplex, 0);
+    } else if (weight01To0 > 0.0 && weight01To1 > 0.0 && weight2 <= 0.0) {
+      keepSimplexEdge(simplex, 0, 1, weight01To0, weight01To1);
+    } else if (weight02To0 > 0.0 && weight02To2 > 0.0 && weight1 <= 0.0) {
+      keepSimplexEdge(simplex, 0, 2, weight02To0, weight02To2);
+    } else if (weight01To0 <= 0.0 && weight12To2 <= 0.0) {
+      keepSimplexVertex(simplex, 1);
+    } else if (weight02To0 <= 0.0 && weight12To1 <= 0.0) {
+      keepSimplexVertex(simplex, 2);
+    } else if (weight12To1 > 0.0 && weight12To2 > 0.0 && weight0 <= 0.0) {
+      keepSimplexEdge(simplex, 1, 2, weight12To1, weight12To2);
+    } else {
+      double weightSum = weight0 + weight1 + weight2;
+      simplex.vertices[0].weight = weight0 / weightSum;
+      simplex.vertices[1].weight = weight1 / weightSum;
+      simplex.vertices[2].weight = weight2 / weightSum;
+      return true;
+    }
+
+    return false;
+  }
+
+  static void keepSimplexVertex(Simplex& simplex, int32_t index)
+  {
+    simplex.vertices[0] = simplex.vertices[index];
+    simplex.vertices[0].weight = 1.0;
+    simplex.numVertices = 1;
+  }
+
+  static void keepSimplexEdge(Simplex& simplex,
+                              int32_t index0,
+                              int32_t index1,
+                              double weight0,
+                              double weight1)
+  {
+    double weightSum = weight0 + weight1;
+    SimplexVertex vertex0 = simplex.vertices[index0];
+    SimplexVertex vertex1 = simplex.vertices[index1];
+    simplex.vertices[0] = vertex0;
+    simplex.vertices[0].weight = weight0 / weightSum;
+    simplex.vertices[1] = vertex1;
+    simplex.vertices[1].weight = weight1 / weightSum;
+    simplex.numVertices = 2;
+  }
+}
@@ -0,0 +1,366 @@
+#ifndef COREX_MATH_NARROWPHASE_HPP
+#define COREX_MATH_NARROWPHASE_HPP
+
+#include <cmath>
+#include <cstdint>
+
+#include <EASTL/algorithm.h>
+
+#include <corex/math/ds.hpp>
+#include <corex/math/geometry.hpp>
+#include <corex/math/instrumentation.hpp>
+#include <corex/utils.hpp>
+
+namespace cx
+{
+  // Intersection tests and penetration of any two convex shapes, e.g. for
+  // the response of a physics step, with GJK and EPA. Unlike the separating
+  // axis tests in geometry.hpp, these are not tied to rectangles, and they
+  // also tell how deep the shapes are into each other.
+  //
+  // Shapes are described by their support mapping, i.e. the point of a
+  // shape that is the farthest along a direction, so they are templates on
+  // the type of the shapes, and the support mapping gets inlined. A shape
+  // may also have a radius, in which case it is its core, as given by the
+  // support mapping, grown by the radius. That is how circles work, as
+  // points with a radius, and it keeps them exact. Other convex shapes can
+  // be used by adding overloads of getSupportPoint() and getSupportRadius()
+  // for them, and of getSupportShape() if they are better off converted to
+  // another shape first, like Rectangles are to Polygon<4>s.
+  //
+  // Polygons must be convex, and may be wound either way. Shapes that only
+  // touch are intersecting, with a penetration depth of 0. Computations are
+  // done in doubles.
+
+  // GJK stops after this many iterations, even if it hasn't converged yet.
+  // Shapes with a lot of vertices, like big NPolygons, rarely need more than
+  // a dozen.
+  constexpr int32_t maxGJKIterations = 64;
+
+  // EPA adds at most one vertex to the polytope per iteration.
+  constexpr int32_t maxEPAIterations = 64;
+
+  // Relative to the size of the Minkowski difference of the shapes.
+  constexpr double gjkTolerance = 1e-10;
+  constexpr double epaTolerance = 1e-7;
+
+  // Support mappings. The direction does not need to be a unit vector.
+  inline Point getPolygonSupportPoint(const Point* vertices,
+                                      int32_t numVertices,
+                                      double directionX,
+                                      double directionY)
+  {
+    int32_t supportIndex = 0;
+    double maxProjection = (vertices[0].x * directionX)
+                           + (vertices[0].y * directionY);
+    for (int32_t i = 1; i < numVertices; i++) {
+      double projection = (vertices[i].x * directionX)
+                          + (vertices[i].y * directionY);
+      if (projection > maxProjection) {
+        maxProjection = projection;
+        supportIndex = i;
+      }
+    }
+
+    return vertices[supportIndex];
+  }
+
+  template <uint numVertices>
+  Point getSupportPoint(const Polygon<numVertices>& polygon,
+                        double directionX,
+                        double directionY)
+  {
+    return getPolygonSupportPoint(polygon.vertices.data(),
+                                  static_cast<int32_t>(numVertices),
+                                  directionX,
+                                  directionY);
+  }
+
+  template <typename Allocator>
+  Point getSupportPoint(const BasicNPolygon<Allocator>& polygon,
+                        double directionX,
+                        double directionY)
+  {
+    return getPolygonSupportPoint(
+      polygon.vertices.data(),
+      static_cast<int32_t>(polygon.vertices.size()),
+      directionX,
+      directionY);
+  }
+
+  template <uint32_t maxVertices>
+  Point getSupportPoint(const FixedNPolygon<maxVertices>& polygon,
+                        double directionX,
+                        double directionY)
+  {
+    return getPolygonSupportPoint(
+      polygon.vertices.data(),
+      static_cast<int32_t>(polygon.vertices.size()),
+      directionX,
+      directionY);
+  }
+
+  // The core of a circle is its center.
+  inline Point getSupportPoint(const Circle& circle, double, double)
+  {
+    return circle.position;
+  }
+
+  template <typename Shape>
+  float getSupportRadius(const Shape&)
+  {
+    return 0.f;
+  }
+
+  inline float getSupportRadius(const Circle& circle)
+  {
+    return circle.radius;
+  }
+
+  template <typename Shape>
+  const Shape& getSupportShape(const Shape& shape)
+  {
+    return shape;
+  }
+
+  // Rotating the corners of a rectangle once is cheaper than rotating the
+  // direction in every support query.
+  inline Polygon<4> getSupportShape(const Rectangle& rect)
+  {
+    return rotateRectangle(rect);
+  }
+
+  // Reduces the simplex to the smallest part of it that contains its point
+  // closest to the origin, and updates that point. Returns whether the
+  // origin is inside of the simplex, which can only be if it is a triangle.
+  bool reduceSimplex(Simplex& simplex);
+
+  // Sets up the polytope from a triangle that contains the origin, and finds
+  // the edge of a polytope that is the closest to the origin.
+  void initPolytope(Polytope& polytope,
+                    const PolytopeVertex& vertex0,
+                    const PolytopeVertex& vertex1,
+                    const PolytopeVertex& vertex2);
+  PolytopeEdge getClosestPolytopeEdge(const Polytope& polytope);
+
+  template <typename Shape0, typename Shape1>
+  SimplexVertex getMinkowskiSupport(const Shape0& shape0,
+                                    const Shape1& shape1,
+                                    double directionX,
+                                    double directionY)
+  {
+    Point support0 = getSupportPoint(shape0, -directionX, -directionY);
+    Point support1 = getSupportPoint(shape1, directionX, directionY);
+    return SimplexVertex{
+      support0,
+      support1,
+      static_cast<double>(support1.x) - support0.x,
+      static_cast<double>(support1.y) - support0.y,
+      0.0
+    };
+  }
+
+  // GJK over the cores of the shapes. Returns the distance between the
+  // cores, which is 0 if they intersect, and leaves the final simplex in
+  // simplex, whose closest point goes from the first core to the second.
+  template <typename Shape0, typename Shape1>
+  double getCoresDistance(const Shape0& shape0,
+                          const Shape1& shape1,
+                          Simplex& simplex)
+  {
+    simplex.vertices[0] = getMinkowskiSupport(shape0, shape1, 1.0, 0.0);
+    simplex.numVertices = 1;
+
+    double sizeSquared = 0.0;
+    for (int32_t iteration = 0; iteration < maxGJKIterations; iteration++) {
+      const SimplexVertex& newest = simplex.vertices[simplex.numVertices - 1];
+      sizeSquared = eastl::max(sizeSquared,
+                               (newest.x * newest.x) + (newest.y * newest.y));
+
+      if (reduceSimplex(simplex)) {
+        return 0.0;
+      }
+
+      double closestX = simplex.closestX;
+      double closestY = simplex.closestY;
+      double distanceSquared = (closestX * closestX) + (closestY * closestY);
+      if (distanceSquared <= gjkTolerance * gjkTolerance * sizeSquared) {
+        // The origin is on the simplex, so the cores touch.
+        return 0.0;
+      }
+
+      SimplexVertex vertex = getMinkowskiSupport(shape0,
+                                                 shape1,
+                                                 -closestX,
+                                                 -closestY);
+
+      double gap = distanceSquared
+                   - ((vertex.x * closestX) + (vertex.y * closestY));
+      bool isDuplicate = false;
+      for (int32_t i = 0; i < simplex.numVertices; i++) {
+        isDuplicate = isDuplicate
+                      || (vertex.x == simplex.vertices[i].x
+                          && vertex.y == simplex.vertices[i].y);
+      }
+
+      // The new vertex is already in the simplex, or does not get any closer
+      // to the origin than the simplex is, so the simplex is already as
+      // close as the cores get.
+      if (isDuplicate || gap <= gjkTolerance * distanceSquared) {
+        return std::sqrt(distanceSquared);
+      }
+
+      simplex.vertices[simplex.numVertices++] = vertex;
+    }
+
+    if (reduceSimplex(simplex)) {
+      return 0.0;
+    }
+
+    return std::sqrt((simplex.closestX * simplex.closestX)
+                     + (simplex.closestY * simplex.closestY));
+  }
+
+  // EPA over the cores of the shapes, which must intersect. Returns the edge
+  // of the Minkowski difference that is the closest to the origin.
+  template <typename Shape0, typename Shape1>
+  PolytopeEdge getPenetrationEdge(const Shape0& shape0,
+                                  const Shape1& shape1,
+                                  const Simplex& simplex)
+  {
+    // GJK stops as soon as the origin is on the simplex, so the simplex is
+    // grown into a triangle first, with the support points in the
+    // directions perpendicular to it.
+    PolytopeVertex vertices[3] = {};
+    int32_t numVertices = simplex.numVertices;
+    for (int32_t i = 0; i < numVertices; i++) {
+      vertices[i] = PolytopeVertex{ simplex.vertices[i].x,
+                                    simplex.vertices[i].y };
+    }
+
+    const double directions[4][2] = {
+      { 1.0, 0.0 }, { -1.0, 0.0 }, { 0.0, 1.0 }, { 0.0, -1.0 }
+    };
+    for (int32_t i = 0; i < 4 && numVertices == 1; i++) {
+      SimplexVertex vertex = getMinkowskiSupport(shape0,
+                                                 shape1,
+                                                 directions[i][0],
+                                                 directions[i][1]);
+      if (vertex.x != vertices[0].x || vertex.y != vertices[0].y) {
+        vertices[numVertices++] = PolytopeVertex{ vertex.x, vertex.y };
+      }
+    }
+
+    double edgeX = vertices[1].x - vertices[0].x;
+    double edgeY = vertices[1].y - vertices[0].y;
+    for (int32_t side = 1; side >= -1 && numVertices == 2; side -= 2) {
+      SimplexVertex vertex = getMinkowskiSupport(shape0,
+                                                 shape1,
+                                                 side * -edgeY,
+                                                 side * edgeX);
+      double cross = (edgeX * (vertex.y - vertices[0].y))
+                     - (edgeY * (vertex.x - vertices[0].x));
+      if (cross != 0.0) {
+        vertices[numVertices++] = PolytopeVertex{ vertex.x, vertex.y };
+      }
+    }
+
+    if (numVertices < 3) {
+      // The Minkowski difference is flat, so the shapes touch without
+      // overlapping, and any normal to it is as good as another.
+      double length = std::sqrt((edgeX * edgeX) + (edgeY * edgeY));
+      return (numVertices == 2 && length > 0.0)
+             ? PolytopeEdge{ 0, edgeY / length, -edgeX / length, 0.0 }
+             : PolytopeEdge{ 0, -1.0, 0.0, 0.0 };
+    }
+
+    Polytope polytope;
+    initPolytope(polytope, vertices[0], vertices[1], vertices[2]);
+
+    PolytopeEdge edge = getClosestPolytopeEdge(polytope);
+    for (int32_t iteration = 0; iteration < maxEPAIterations; iteration++) {
+      SimplexVertex vertex = getMinkowskiSupport(shape0,
+                                                 shape1,
+                                                 edge.normalX,
+                                                 edge.normalY);
+      double supportDistance = (vertex.x * edge.normalX)
+                               + (vertex.y * edge.normalY);
+      if (supportDistance - edge.distance
+          <= epaTolerance * eastl::max(1.0, supportDistance)) {
+        break;
+      }
+
+      polytope.vertices.insert(polytope.vertices.begin() + edge.index + 1,
+                               PolytopeVertex{ vertex.x, vertex.y });
+      edge = getClosestPolytopeEdge(polytope);
+    }
+
+    return edge;
+  }
+
+  template <typename Shape0, typename Shape1>
+  bool areConvexShapesIntersecting(const Shape0& shape0, const Shape1& shape1)
+  {
+    COREX_MATH_INSTRUMENT(areConvexShapesIntersecting);
+    const auto& supportShape0 = getSupportShape(shape0);
+    const auto& supportShape1 = getSupportShape(shape1);
+    Simplex simplex;
+    double distance = getCoresDistance(supportShape0, supportShape1, simplex);
+    return distance <= static_cast<double>(getSupportRadius(shape0))
+                       + getSupportRadius(shape1);
+  }
+
+  // RETURN_FAIL is returned if the shapes do not intersect.
+  template <typename Shape0, typename Shape1>
+  ReturnValue<Penetration> getConvexShapesPenetration(const Shape0& shape0,
+                                                      const Shape1& shape1)
+  {
+    COREX_MATH_INSTRUMENT(getConvexShapesPenetration);
+    const auto& supportShape0 = getSupportShape(shape0);
+    const auto& supportShape1 = getSupportShape(shape1);
+    double radiusSum = static_cast<double>(getSupportRadius(shape0))
+                       + getSupportRadius(shape1);
+
+    Simplex simplex;
+    double distance = getCoresDistance(supportShape0, supportShape1, simplex);
+    if (distance > radiusSum) {
+      return ReturnValue<Penetration>{
+        Penetration{}, ReturnState::RETURN_FAIL
+      };
+    }
+
+    double normalX;
+    double normalY;
+    double depth;
+    if (distance > 0.0) {
+      // Only the radii overlap, along the line between the closest points of
+      // the cores.
+      normalX = simplex.closestX / distance;
+      normalY = simplex.closestY / distance;
+      depth = radiusSum - distance;
+    } else {
+      // The edge of the Minkowski difference faces away from the second
+      // shape.
+      PolytopeEdge edge = getPenetrationEdge(supportShape0,
+                                             supportShape1,
+                                             simplex);
+      normalX = -edge.normalX;
+      normalY = -edge.normalY;
+      depth = edge.distance + radiusSum;
+    }
+
+    return ReturnValue<Penetration>{
+      Penetration{
+        Vec2{ static_cast<float>(normalX), static_cast<float>(normalY) },
+        static_cast<float>(depth),
+        Vec2{
+          static_cast<float>(normalX * depth),
+          static_cast<float>(normalY * depth)
+        }
+      },
+      ReturnState::RETURN_OK
+    };
+  }
+}
+
+#endif
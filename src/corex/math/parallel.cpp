@@ -0,0 +1,255 @@
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+#include <EASTL/algorithm.h>
+#include <EASTL/vector.h>
+
+#include <corex/math/parallel.hpp>
+
+namespace cx
+{
+  // The range of chunks that a thread still has to run, packed into a single
+  // word so that it can be taken from and stolen from with a single
+  // compare-and-swap. The first chunk is in the lower half, and the end of the
+  // range is in the upper half. Each range gets a cache line of its own, so
+  // that threads taking chunks from their own range don't slow each other
+  // down.
+  struct alignas(64) ChunkRange
+  {
+    std::atomic<uint64_t> range;
+  };
+
+  struct ThreadPoolState
+  {
+    eastl::vector<std::thread> workerThreads;
+    eastl::vector<ChunkRange> chunkRanges;
+
+    // Only one batch runs at a time.
+    std::mutex runMutex;
+
+    // Guards everything below.
+    std::mutex mutex;
+    std::condition_variable workAvailable;
+    std::condition_variable workDone;
+    uint64_t batchNumber;
+    int32_t numBusyWorkers;
+    bool isStopping;
+    ThreadPool::ChunkFunction function;
+    void* context;
+  };
+
+  static void runWorkerThread(ThreadPoolState* state, int32_t threadIndex);
+  static void runChunks(ThreadPoolState& state, int32_t threadIndex);
+  static bool takeChunk(ChunkRange& chunkRange, int32_t& chunkIndex);
+  static bool stealChunks(ThreadPoolState& state, int32_t threadIndex);
+  static uint64_t packChunkRange(uint32_t begin, uint32_t end);
+
+  ThreadPool::ThreadPool()
+    : ThreadPool(eastl::max(
+        static_cast<int32_t>(std::thread::hardware_concurrency()) - 1, 0)) {}
+
+  ThreadPool::ThreadPool(int32_t numWorkerThreads)
+    : state{new ThreadPoolState}
+  {
+    numWorkerThreads = eastl::max(numWorkerThreads, 0);
+    this->state->chunkRanges = eastl::vector<ChunkRange>(numWorkerThreads + 1);
+    for (ChunkRange& chunkRange : this->state->chunkRanges) {
+      chunkRange.range.store(0, std::memory_order_relaxed);
+    }
+
+    this->state->batchNumber = 0;
+    this->state->numBusyWorkers = 0;
+    this->state->isStopping = false;
+    this->state->function = nullptr;
+    this->state->context = nullptr;
+
+    // The calling thread is thread 0, so the worker threads start at 1.
+    this->state->workerThreads.reserve(numWorkerThreads);
+    for (int32_t i = 1; i <= numWorkerThreads; i++) {
+      this->state->workerThreads.push_back(
+        std::thread{ runWorkerThread, this->state, i });
+    }
+  }
+
+  ThreadPool::~ThreadPool()
+  {
+    {
+      std::lock_guard<std::mutex> lock{ this->state->mutex };
+      this->state->isStopping = true;
+    }
+
+    this->state->workAvailable.notify_all();
+    for (std::thread& workerThread : this->state->workerThreads) {
+      workerThread.join();
+    }
+
+    delete this->state;
+  }
+
+  int32_t ThreadPool::getNumThreads() const
+  {
+    return static_cast<int32_t>(this->state->chunkRanges.size());
+  }
+
+  void ThreadPool::run(int32_t numChunks,
+                       ChunkFunction function,
+                       void* context)
+  {
+    if (numChunks <= 0) {
+      return;
+    }
+
+    int32_t numWorkerThreads = static_cast<int32_t>(
+      this->state->workerThreads.size());
+    if (numChunks == 1 || numWorkerThreads == 0) {
+      // Waking up the workers would only slow things down.
+      for (int32_t i = 0; i < numChunks; i++) {
+        function(context, i, 0);
+      }
+
+      return;
+    }
+
+    std::lock_guard<std::mutex> runLock{ this->state->runMutex };
+
+    // Give each thread an equal share of the chunks to start with.
+    int32_t numThreads = numWorkerThreads + 1;
+    for (int32_t i = 0; i < numThreads; i++) {
+      auto begin = static_cast<uint32_t>(
+        (static_cast<int64_t>(numChunks) * i) / numThreads);
+      auto end = static_cast<uint32_t>(
+        (static_cast<int64_t>(numChunks) * (i + 1)) / numThreads);
+      this->state->chunkRanges[i].range.store(packChunkRange(begin, end),
+                                              std::memory_order_relaxed);
+    }
+
+    {
+      // The workers only start on the batch after they have taken the lock,
+      // so they will see the ranges stored above.
+      std::lock_guard<std::mutex> lock{ this->state->mutex };
+      this->state->function = function;
+      this->state->context = context;
+      this->state->numBusyWorkers = numWorkerThreads;
+      this->state->batchNumber++;
+    }
+
+    this->state->workAvailable.notify_all();
+    runChunks(*this->state, 0);
+
+    // Chunks can still be running on the workers even though there are no
+    // chunks left to take.
+    std::unique_lock<std::mutex> lock{ this->state->mutex };
+    this->state->workDone.wait(lock, [this] {
+      return this->state->numBusyWorkers == 0;
+    });
+  }
+
+  static void runWorkerThread(ThreadPoolState* state, int32_t threadIndex)
+  {
+    uint64_t lastBatchNumber = 0;
+    while (true) {
+      {
+        std::unique_lock<std::mutex> lock{ state->mutex };
+        state->workAvailable.wait(lock, [state, lastBatchNumber] {
+          return state->isStopping || state->batchNumber != lastBatchNumber;
+        });
+
+        if (state->isStopping) {
+          return;
+        }
+
+        lastBatchNumber = state->batchNumber;
+      }
+
+      runChunks(*state, threadIndex);
+
+      bool isLastWorker = false;
+      {
+        std::lock_guard<std::mutex> lock{ state->mutex };
+        state->numBusyWorkers--;
+        isLastWorker = state->numBusyWorkers == 0;
+      }
+
+      if (isLastWorker) {
+        state->workDone.notify_one();
+      }
+    }
+  }
+
+  static void runChunks(ThreadPoolState& state, int32_t threadIndex)
+  {
+    // A thread is done once its own range and every other range is empty.
+    // Chunks that are being stolen are briefly in neither the range they were
+    // stolen from nor the range of the thief. But the thief is still running
+    // and will run them, so they never get lost.
+    ChunkRange& ownRange = state.chunkRanges[threadIndex];
+    int32_t chunkIndex = 0;
+    while (true) {
+      if (takeChunk(ownRange, chunkIndex)) {
+        state.function(state.context, chunkIndex, threadIndex);
+      } else if (!stealChunks(state, threadIndex)) {
+        return;
+      }
+    }
+  }
+
+  static bool takeChunk(ChunkRange& chunkRange, int32_t& chunkIndex)
+  {
+    uint64_t range = chunkRange.range.load(std::memory_order_acquire);
+    while (true) {
+      auto begin = static_cast<uint32_t>(range);
+      auto end = static_cast<uint32_t>(range >> 32);
+      if (begin >= end) {
+        return false;
+      }
+
+      if (chunkRange.range.compare_exchange_weak(
+            range, packChunkRange(begin + 1, end),
+            std::memory_order_acq_rel, std::memory_order_acquire)) {
+        chunkIndex = static_cast<int32_t>(begin);
+        return true;
+      }
+    }
+  }
+
+  static bool stealChunks(ThreadPoolState& state, int32_t threadIndex)
+  {
+    // The range of a thread is the whole state that the compare-and-swaps
+    // work on, so it doesn't matter if a range gets emptied and then refilled
+    // with the same chunks between a load and a compare-and-swap.
+    auto numThreads = static_cast<int32_t>(state.chunkRanges.size());
+    for (int32_t offset = 1; offset < numThreads; offset++) {
+      ChunkRange& victimRange = state.chunkRanges[(threadIndex + offset)
+                                                  % numThreads];
+      uint64_t range = victimRange.range.load(std::memory_order_acquire);
+      while (true) {
+        auto begin = static_cast<uint32_t>(range);
+        auto end = static_cast<uint32_t>(range >> 32);
+        if (begin >= end) {
+          break;
+        }
+
+        // Steal the back half, and the last chunk if it is the only one left.
+        uint32_t middle = begin + ((end - begin) / 2);
+        if (victimRange.range.compare_exchange_weak(
+              range, packChunkRange(begin, middle),
+              std::memory_order_acq_rel, std::memory_order_acquire)) {
+          // Our own range is empty, so no other thread will be changing it.
+          state.chunkRanges[threadIndex].range.store(
+            packChunkRange(middle, end), std::memory_order_release);
+          return true;
+        }
+      }
+    }
+
+    return false;
+  }
+
+  static uint64_t packChunkRange(uint32_t begin, uint32_t end)
+  {
+    return (static_cast<uint64_t>(end) << 32) | begin;
+  }
+}
@@ -0,0 +1,97 @@
+#ifndef COREX_MATH_PARALLEL_HPP
+#define COREX_MATH_PARALLEL_HPP
+
+#include <cstdint>
+
+#include <EASTL/algorithm.h>
+
+namespace cx
+{
+  struct ThreadPoolState;
+
+  // A small work-stealing thread pool for running batches of independent
+  // work, e.g. narrowphase tests on the candidate pairs of a frame.
+  //
+  // Work is handed out in chunks. When a batch is run, each thread starts off
+  // with an equal, contiguous range of the chunks, and takes chunks from the
+  // front of its own range. A thread that runs out of chunks steals the back
+  // half of the range of another thread. Taking or stealing chunks is a
+  // single compare-and-swap on a cache line that is, most of the time, only
+  // touched by its owner. So, nothing is allocated or synchronized per
+  // element, and only once per chunk.
+  //
+  // The thread calling run() takes part in the work, so a pool with N worker
+  // threads runs batches on N + 1 threads. Only one batch runs at a time.
+  // Concurrent calls to run() are serialized, and run() must not be called
+  // from within a chunk, or it will deadlock.
+  class ThreadPool
+  {
+  public:
+    // Uses one worker thread less than the number of hardware threads, since
+    // the calling thread also does work.
+    ThreadPool();
+    explicit ThreadPool(int32_t numWorkerThreads);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // The number of threads that batches run on, including the calling
+    // thread. Thread indices passed to chunk functions are in
+    // [0, getNumThreads()), with the calling thread always being 0.
+    int32_t getNumThreads() const;
+
+    using ChunkFunction = void (*)(void* context,
+                                   int32_t chunkIndex,
+                                   int32_t threadIndex);
+
+    // Calls function once for every chunk in [0, numChunks), and returns once
+    // all of them are done.
+    void run(int32_t numChunks, ChunkFunction function, void* context);
+
+  private:
+    ThreadPoolState* state;
+  };
+
+  // Splits [0, numItems) into chunks of chunkSize items, and calls
+  // function(begin, end, threadIndex) for each chunk on the threads of the
+  // pool. Chunks always start at a multiple of chunkSize, no matter which
+  // thread ends up running them. So, a function that writes the result of
+  // the i-th item to the i-th output gives the same output as a serial loop,
+  // and outputs never need to be merged or sorted afterwards.
+  template <typename Function>
+  void parallelFor(ThreadPool& pool,
+                   int32_t numItems,
+                   int32_t chunkSize,
+                   const Function& function)
+  {
+    if (numItems <= 0) {
+      return;
+    }
+
+    struct Context
+    {
+      const Function* function;
+      int32_t numItems;
+      int32_t chunkSize;
+    };
+
+    Context context{ &function, numItems, eastl::max(chunkSize, 1) };
+    int64_t numChunks = (static_cast<int64_t>(numItems) + context.chunkSize - 1)
+                        / context.chunkSize;
+    pool.run(
+      static_cast<int32_t>(numChunks),
+      [](void* contextPtr, int32_t chunkIndex, int32_t threadIndex) {
+        const Context& context = *static_cast<const Context*>(contextPtr);
+        int64_t begin = static_cast<int64_t>(chunkIndex) * context.chunkSize;
+        int64_t end = eastl::min(begin + context.chunkSize,
+                                 static_cast<int64_t>(context.numItems));
+        (*context.function)(static_cast<int32_t>(begin),
+                            static_cast<int32_t>(end),
+                            threadIndex);
+      },
+      &context);
+  }
+}
+
+#endif
@@ -0,0 +1,306 @@
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+#include <EASTL/algorithm.h>
+
+#include <corex/utils.hpp>
+#include <corex/math/ds.hpp>
+#include <corex/math/geometry.hpp>
+#include <corex/math/instrumentation.hpp>
+#include <corex/math/quantization.hpp>
+
+namespace cx
+{
+  template <typename Coord>
+  static constexpr double maxQuantizedCoord();
+  template <typename Coord>
+  static ReturnState quantizeVertices(
+      const NPolygon& polygon,
+      const Point& origin,
+      float scale,
+      QuantizedNPolygon<Coord>& quantizedPolygon);
+  template <typename Coord>
+  static void quantizeVerticesToFit(
+      const NPolygon& polygon,
+      QuantizedNPolygon<Coord>& quantizedPolygon);
+  template <typename Coord>
+  static NPolygon dequantizeVertices(const QuantizedNPolygon<Coord>& polygon);
+  template <typename Coord>
+  static double quantizedPolygonArea(const QuantizedNPolygon<Coord>& polygon);
+  template <typename Coord>
+  static bool isPointWithinQuantizedPolygon(
+      const Point& point,
+      const QuantizedNPolygon<Coord>& polygon);
+  template <typename Coord>
+  static AABB quantizedPolygonAABB(const QuantizedNPolygon<Coord>& polygon);
+
+  void quantizeNPolygon(const NPolygon& polygon,
+                        QuantizedNPolygon<int16_t>& quantizedPolygon)
+  {
+    COREX_MATH_INSTRUMENT(quantizeNPolygon);
+    quantizeVerticesToFit(polygon, quantizedPolygon);
+  }
+
+  void quantizeNPolygon(const NPolygon& polygon,
+                        QuantizedNPolygon<int32_t>& quantizedPolygon)
+  {
+    COREX_MATH_INSTRUMENT(quantizeNPolygon);
+    quantizeVerticesToFit(polygon, quantizedPolygon);
+  }
+
+  ReturnState quantizeNPolygon(const NPolygon& polygon,
+                               const Point& origin,
+                               float scale,
+                               QuantizedNPolygon<int16_t>& quantizedPolygon)
+  {
+    COREX_MATH_INSTRUMENT(quantizeNPolygon);
+    return quantizeVertices(polygon, origin, scale, quantizedPolygon);
+  }
+
+  ReturnState quantizeNPolygon(const NPolygon& polygon,
+                               const Point& origin,
+                               float scale,
+                               QuantizedNPolygon<int32_t>& quantizedPolygon)
+  {
+    COREX_MATH_INSTRUMENT(quantizeNPolygon);
+    return quantizeVertices(polygon, origin, scale, quantizedPolygon);
+  }
+
+  NPolygon dequantizeNPolygon(const QuantizedNPolygon<int16_t>& polygon)
+  {
+    COREX_MATH_INSTRUMENT(dequantizeNPolygon);
+    return dequantizeVertices(polygon);
+  }
+
+  NPolygon dequantizeNPolygon(const QuantizedNPolygon<int32_t>& polygon)
+  {
+    COREX_MATH_INSTRUMENT(dequantizeNPolygon);
+    return dequantizeVertices(polygon);
+  }
+
+  double getPolygonArea(const QuantizedNPolygon<int16_t>& polygon)
+  {
+    COREX_MATH_INSTRUMENT(getPolygonArea);
+    return quantizedPolygonArea(polygon);
+  }
+
+  double getPolygonArea(const QuantizedNPolygon<int32_t>& polygon)
+  {
+    COREX_MATH_INSTRUMENT(getPolygonArea);
+    return quantizedPolygonArea(polygon);
+  }
+
+  bool isPointWithinNPolygon(const Point& point,
+                             const QuantizedNPolygon<int16_t>& polygon)
+  {
+    COREX_MATH_INSTRUMENT(isPointWithinNPolygon);
+    return isPointWithinQuantizedPolygon(point, polygon);
+  }
+
+  bool isPointWithinNPolygon(const Point& point,
+                             const QuantizedNPolygon<int32_t>& polygon)
+  {
+    COREX_MATH_INSTRUMENT(isPointWithinNPolygon);
+    return isPointWithinQuantizedPolygon(point, polygon);
+  }
+
+  AABB getPolygonAABB(const QuantizedNPolygon<int16_t>& polygon)
+  {
+    COREX_MATH_INSTRUMENT(getPolygonAABB);
+    return quantizedPolygonAABB(polygon);
+  }
+
+  AABB getPolygonAABB(const QuantizedNPolygon<int32_t>& polygon)
+  {
+    COREX_MATH_INSTRUMENT(getPolygonAABB);
+    return quantizedPolygonAABB(polygon);
+  }
+
+  template <typename Coord>
+  static constexpr double maxQuantizedCoord()
+  {
+    // int32_t coordinates are kept within 2^30 so that twice the area of any
+    // quantized polygon always fits in an int64_t.
+    return (sizeof(Coord) == sizeof(int16_t)) ? 32767.0 : 1073741823.0;
+  }
+
+  template <typename Coord>
+  static ReturnState quantizeVertices(
+      const NPolygon& polygon,
+      const Point& origin,
+      float scale,
+      QuantizedNPolygon<Coord>& quantizedPolygon)
+  {
+    constexpr double maxCoord = maxQuantizedCoord<Coord>();
+
+    quantizedPolygon.origin = origin;
+    quantizedPolygon.scale = scale;
+    quantizedPolygon.vertices.resize(polygon.vertices.size());
+
+    ReturnState state = ReturnState::RETURN_OK;
+    for (size_t i = 0; i < polygon.vertices.size(); i++) {
+      const Point& vertex = polygon.vertices[i];
+      double x = std::round((static_cast<double>(vertex.x) - origin.x)
+                            / scale);
+      double y = std::round((static_cast<double>(vertex.y) - origin.y)
+                            / scale);
+      if (x < -maxCoord || x > maxCoord || y < -maxCoord || y > maxCoord) {
+        state = ReturnState::RETURN_FAIL;
+        x = eastl::clamp(x, -maxCoord, maxCoord);
+        y = eastl::clamp(y, -maxCoord, maxCoord);
+      }
+
+      quantizedPolygon.vertices[i] = QuantizedPoint<Coord>{
+        static_cast<Coord>(x),
+        static_cast<Coord>(y)
+      };
+    }
+
+    return state;
+  }
+
+  template <typename Coord>
+  static void quantizeVerticesToFit(
+      const NPolygon& polygon,
+      QuantizedNPolygon<Coord>& quantizedPolygon)
+  {
+    if (polygon.vertices.empty()) {
+      quantizedPolygon.origin = Point{0.f, 0.f};
+      quantizedPolygon.scale = 1.f;
+      quantizedPolygon.vertices.clear();
+      return;
+    }
+
+    AABB bounds = getPolygonAABB(polygon);
+    Point origin{
+      static_cast<float>((static_cast<double>(bounds.minX) + bounds.maxX)
+                         / 2.0),
+      static_cast<float>((static_cast<double>(bounds.minY) + bounds.maxY)
+                         / 2.0)
+    };
+    double halfExtent = eastl::max(
+      eastl::max(static_cast<double>(bounds.maxX) - origin.x,
+                 static_cast<double>(origin.x) - bounds.minX),
+      eastl::max(static_cast<double>(bounds.maxY) - origin.y,
+                 static_cast<double>(origin.y) - bounds.minY));
+
+    // Rounding the scale up makes sure that no vertex goes out of range.
+    float scale = std::nextafter(
+      static_cast<float>(halfExtent / maxQuantizedCoord<Coord>()),
+      std::numeric_limits<float>::infinity());
+    if (!(halfExtent > 0.0)) {
+      // All vertices are at the same spot.
+      scale = 1.f;
+    }
+
+    quantizeVertices(polygon, origin, scale, quantizedPolygon);
+  }
+
+  template <typename Coord>
+  static NPolygon dequantizeVertices(const QuantizedNPolygon<Coord>& polygon)
+  {
+    NPolygon dequantizedPolygon;
+    dequantizedPolygon.vertices.reserve(polygon.vertices.size());
+    for (const QuantizedPoint<Coord>& vertex : polygon.vertices) {
+      dequantizedPolygon.vertices.push_back(Point{
+        static_cast<float>(polygon.origin.x
+                           + (static_cast<double>(vertex.x) * polygon.scale)),
+        static_cast<float>(polygon.origin.y
+                           + (static_cast<double>(vertex.y) * polygon.scale))
+      });
+    }
+
+    return dequantizedPolygon;
+  }
+
+  template <typename Coord>
+  static double quantizedPolygonArea(const QuantizedNPolygon<Coord>& polygon)
+  {
+    // The Shoelace algorithm, like getPolygonArea(), but with integers, so
+    // that the area of the quantized polygon is exact. The partial sums can
+    // overflow, so we sum using unsigned integers, whose overflow wraps
+    // around. The final sum is twice the signed area, which always fits.
+    const auto& vertices = polygon.vertices;
+    int32_t numVertices = static_cast<int32_t>(vertices.size());
+    uint64_t doubleArea = 0;
+    for (int32_t i = 0; i < numVertices; i++) {
+      int32_t nextIndex = (i + 1) % numVertices;
+      doubleArea += static_cast<uint64_t>(
+                      static_cast<int64_t>(vertices[i].x)
+                      * vertices[nextIndex].y)
+                    - static_cast<uint64_t>(
+                      static_cast<int64_t>(vertices[nextIndex].x)
+                      * vertices[i].y);
+    }
+
+    double scale = static_cast<double>(polygon.scale);
+    return (std::fabs(static_cast<double>(static_cast<int64_t>(doubleArea)))
+            / 2.0)
+           * scale * scale;
+  }
+
+  template <typename Coord>
+  static bool isPointWithinQuantizedPolygon(
+      const Point& point,
+      const QuantizedNPolygon<Coord>& polygon)
+  {
+    // Same test as isPointWithinNPolygon(const Point&, const NPolygon&), but
+    // with the point brought into the space of the quantized vertices,
+    // instead of decoding every vertex.
+    double x = (static_cast<double>(point.x) - polygon.origin.x)
+               / polygon.scale;
+    double y = (static_cast<double>(point.y) - polygon.origin.y)
+               / polygon.scale;
+
+    const auto& vertices = polygon.vertices;
+    int32_t numVertices = static_cast<int32_t>(vertices.size());
+    bool isPointInside = false;
+    for (int32_t i = 0, j = numVertices - 1; i < numVertices; j = i++) {
+      double startX = vertices[i].x;
+      double startY = vertices[i].y;
+      double endX = vertices[j].x;
+      double endY = vertices[j].y;
+      if (((startY > y) != (endY > y))
+          && (x < ((endX - startX) * (y - startY) / (endY - startY)
+                   + startX))) {
+        isPointInside = !isPointInside;
+      }
+    }
+
+    return isPointInside;
+  }
+
+  template <typename Coord>
+  static AABB quantizedPolygonAABB(const QuantizedNPolygon<Coord>& polygon)
+  {
+    // Polygons without vertices have no extent, so just give them an empty
+    // box at their origin.
+    const auto& vertices = polygon.vertices;
+    if (vertices.empty()) {
+      return AABB{
+        polygon.origin.x, polygon.origin.y, polygon.origin.x, polygon.origin.y
+      };
+    }
+
+    // Only the extremes need to be decoded.
+    Coord minX = vertices[0].x;
+    Coord minY = vertices[0].y;
+    Coord maxX = vertices[0].x;
+    Coord maxY = vertices[0].y;
+    for (size_t i = 1; i < vertices.size(); i++) {
+      minX = eastl::min(minX, vertices[i].x);
+      minY = eastl::min(minY, vertices[i].y);
+      maxX = eastl::max(maxX, vertices[i].x);
+      maxY = eastl::max(maxY, vertices[i].y);
+    }
+
+    double scale = static_cast<double>(polygon.scale);
+    return AABB{
+      static_cast<float>(polygon.origin.x + (minX * scale)),
+      static_cast<float>(polygon.origin.y + (minY * scale)),
+      static_cast<float>(polygon.origin.x + (maxX * scale)),
+      static_cast<float>(polygon.origin.y + (maxY * scale))
+    };
+  }
+}
@@ -0,0 +1,65 @@
+#ifndef COREX_MATH_QUANTIZATION_HPP
+#define COREX_MATH_QUANTIZATION_HPP
+
+#include <cstdint>
+
+#include <corex/math/ds.hpp>
+#include <corex/utils.hpp>
+
+namespace cx
+{
+  // Quantization of polygons into QuantizedNPolygons, and kernels that work
+  // on the quantized vertices directly, without decoding the whole polygon.
+  //
+  // Vertices are rounded to the nearest multiple of the scale from the
+  // origin. So, each decoded vertex is within scale / 2 of the original vertex
+  // in each axis, give or take the rounding of the decoded vertex to floats,
+  // and:
+  //
+  //   * AABBs are within scale / 2 of the AABB of the original polygon.
+  //   * Areas are within about perimeter * scale / 2 of the area of the
+  //     original polygon. Areas of the quantized polygon itself are exact up
+  //     to the final multiplication by the scale, since they are computed
+  //     using integers.
+  //   * Point-in-polygon tests bring the point into the space of the
+  //     quantized vertices and run the crossing test in doubles, so they are
+  //     not exact predicates. They can only differ from an exact test against
+  //     the quantized polygon for points within about 2^-20 * scale of its
+  //     edges, from rounding, and from the original polygon for points
+  //     within scale * sqrt(2) / 2 of its edges.
+  //
+  // int16_t coordinates range from -32767 to 32767. int32_t coordinates range
+  // from -(2^30 - 1) to 2^30 - 1, which is already finer than what floats can
+  // represent over the same extent.
+  //
+  // Without a given origin and scale, the origin is placed at the center of
+  // the bounds of the polygon, and the scale is the smallest one that fits
+  // the polygon. With a given origin and scale, which lets polygons in the
+  // same chunk share them, RETURN_FAIL is returned if a vertex does not fit,
+  // in which case such vertices are clamped.
+  void quantizeNPolygon(const NPolygon& polygon,
+                        QuantizedNPolygon<int16_t>& quantizedPolygon);
+  void quantizeNPolygon(const NPolygon& polygon,
+                        QuantizedNPolygon<int32_t>& quantizedPolygon);
+  ReturnState quantizeNPolygon(const NPolygon& polygon,
+                               const Point& origin,
+                               float scale,
+                               QuantizedNPolygon<int16_t>& quantizedPolygon);
+  ReturnState quantizeNPolygon(const NPolygon& polygon,
+                               const Point& origin,
+                               float scale,
+                               QuantizedNPolygon<int32_t>& quantizedPolygon);
+  NPolygon dequantizeNPolygon(const QuantizedNPolygon<int16_t>& polygon);
+  NPolygon dequantizeNPolygon(const QuantizedNPolygon<int32_t>& polygon);
+
+  double getPolygonArea(const QuantizedNPolygon<int16_t>& polygon);
+  double getPolygonArea(const QuantizedNPolygon<int32_t>& polygon);
+  bool isPointWithinNPolygon(const Point& point,
+                             const QuantizedNPolygon<int16_t>& polygon);
+  bool isPointWithinNPolygon(const Point& point,
+                             const QuantizedNPolygon<int32_t>& polygon);
+  AABB getPolygonAABB(const QuantizedNPolygon<int16_t>& polygon);
+  AABB getPolygonAABB(const QuantizedNPolygon<int32_t>& polygon);
+}
+
+#endif
@@ -0,0 +1,441 @@
+#include <cmath>
+#include <cstdint>
+
+#include <EASTL/algorithm.h>
+#include <EASTL/vector.h>
+
+#include <corex/utils.hpp>
+#include <corex/math/ds.hpp>
+#include <corex/math/geometry.hpp>
+#include <corex/math/robust.hpp>
+
+namespace cx::robust
+{
+  // Half of the distance between 1 and the next double, and the bound on the
+  // relative error of a 2x2 determinant computed in doubles, both from
+  // Shewchuk's paper (where the latter is ccwerrboundA).
+  static constexpr double doubleEpsilon = 1.1102230246251565e-16;
+  static constexpr double determinantErrorBound = (3.0 + 16.0 * doubleEpsilon)
+                                                  * doubleEpsilon;
+
+  static double getCrossProduct(const Point& start0,
+                                const Point& end0,
+                                const Point& start1,
+                                const Point& end1);
+  static double getExactCrossProduct(const Point& start0,
+                                     const Point& end0,
+                                     const Point& start1,
+                                     const Point& end1);
+  static bool isCollinearPointOnLine(const Point& point, const Line& line);
+  static Point interpolatePoints(const Point& start,
+                                 const Point& end,
+                                 double t);
+
+  double orient2D(const Point& point0,
+                  const Point& point1,
+                  const Point& point2)
+  {
+    return getCrossProduct(point0, point1, point0, point2);
+  }
+
+  double signedDistPointToInfLine(const Point& point, const Line& line)
+  {
+    double orientation = orient2D(line.start, line.end, point);
+    if (orientation == 0.0) {
+      // This also covers lines whose start and end are the same.
+      return 0.0;
+    }
+
+    // The normal of a line points to the left of it in the windowing system
+    // (see cx::lineNormalVector()), which is the negative side of
+    // orient2D().
+    double length = std::hypot(static_cast<double>(line.end.x) - line.start.x,
+                               static_cast<double>(line.end.y)
+                               - line.start.y);
+    return -orientation / length;
+  }
+
+  ReturnValue<Point> intersectionOfTwoInfLines(const Line& line0,
+                                               const Line& line1)
+  {
+    double denominator = getCrossProduct(line0.start, line0.end,
+                                         line1.start, line1.end);
+    if (denominator == 0.0) {
+      // The two lines are parallel, so no point of intersection.
+      return ReturnValue<Point>{ Point{}, ReturnState::RETURN_FAIL };
+    }
+
+    // Same as in cx::intersectionOfTwoInfLines(), the intersection is at
+    // start0 + lambda * (end0 - start0), where the lambda is the one that
+    // puts the point on the second line.
+    double lambda = getCrossProduct(line0.start, line1.start,
+                                    line1.start, line1.end)
+                    / denominator;
+    return ReturnValue<Point>{ interpolatePoints(line0.start, line0.end,
+                                                 lambda),
+                               ReturnState::RETURN_OK };
+  }
+
+  ReturnValue<Point> intersectionOfLineandInfLine(const Line& line,
+                                                  const Line& infLine)
+  {
+    double startSide = orient2D(infLine.start, infLine.end, line.start);
+    double endSide = orient2D(infLine.start, infLine.end, line.end);
+    if (startSide == 0.0 && endSide == 0.0) {
+      // The segment is on the line, so, like parallel lines, there is no
+      // single point of intersection.
+      return ReturnValue<Point>{ Point{}, ReturnState::RETURN_FAIL };
+    }
+
+    if (startSide == 0.0) {
+      return ReturnValue<Point>{ line.start, ReturnState::RETURN_OK };
+    }
+
+    if (endSide == 0.0) {
+      return ReturnValue<Point>{ line.end, ReturnState::RETURN_OK };
+    }
+
+    if ((startSide > 0.0) == (endSide > 0.0)) {
+      // Both ends of the segment are on the same side of the line.
+      return ReturnValue<Point>{ Point{}, ReturnState::RETURN_FAIL };
+    }
+
+    return ReturnValue<Point>{
+      interpolatePoints(line.start, line.end,
+                        startSide / (startSide - endSide)),
+      ReturnState::RETURN_OK
+    };
+  }
+
+  ReturnValue<Point> intersectionOfLineAndLine(const Line& line0,
+                                               const Line& line1)
+  {
+    double start1Side = orient2D(line0.start, line0.end, line1.start);
+    double end1Side = orient2D(line0.start, line0.end, line1.end);
+    if (start1Side == 0.0 && end1Side == 0.0) {
+      // Collinear segments. They intersect if an end of one of them is on
+      // the other one.
+      if (isCollinearPointOnLine(line1.start, line0)) {
+        return ReturnValue<Point>{ line1.start, ReturnState::RETURN_OK };
+      }
+
+      if (isCollinearPointOnLine(line1.end, line0)) {
+        return ReturnValue<Point>{ line1.end, ReturnState::RETURN_OK };
+      }
+
+      if (isCollinearPointOnLine(line0.start, line1)) {
+        return ReturnValue<Point>{ line0.start, ReturnState::RETURN_OK };
+      }
+
+      if (isCollinearPointOnLine(line0.end, line1)) {
+        return ReturnValue<Point>{ line0.end, ReturnState::RETURN_OK };
+      }
+
+      return ReturnValue<Point>{ Point{}, ReturnState::RETURN_FAIL };
+    }
+
+    double start0Side = orient2D(line1.start, line1.end, line0.start);
+    double end0Side = orient2D(line1.start, line1.end, line0.end);
+    if ((start1Side > 0.0 && end1Side > 0.0)
+        || (start1Side < 0.0 && end1Side < 0.0)
+        || (start0Side > 0.0 && end0Side > 0.0)
+        || (start0Side < 0.0 && end0Side < 0.0)) {
+      // A segment is entirely on one side of the line of the other.
+      return ReturnValue<Point>{ Point{}, ReturnState::RETURN_FAIL };
+    }
+
+    // An end that is on the line of the other segment is the intersection,
+    // since the segments are not collinear.
+    if (start0Side == 0.0) {
+      return ReturnValue<Point>{ line0.start, ReturnState::RETURN_OK };
+    }
+
+    if (end0Side == 0.0) {
+      return ReturnValue<Point>{ line0.end, ReturnState::RETURN_OK };
+    }
+
+    if (start1Side == 0.0) {
+      return ReturnValue<Point>{ line1.start, ReturnState::RETURN_OK };
+    }
+
+    if (end1Side == 0.0) {
+      return ReturnValue<Point>{ line1.end, ReturnState::RETURN_OK };
+    }
+
+    // The point is on the first segment, but rounding may put it just
+    // outside of the bounds of the second one, which both segments are known
+    // to share a point in.
+    Point intersectPt = interpolatePoints(line0.start, line0.end,
+                                          start0Side
+                                          / (start0Side - end0Side));
+    intersectPt.x = eastl::max(intersectPt.x,
+                               eastl::min(line1.start.x, line1.end.x));
+    intersectPt.x = eastl::min(intersectPt.x,
+                               eastl::max(line1.start.x, line1.end.x));
+    intersectPt.y = eastl::max(intersectPt.y,
+                               eastl::min(line1.start.y, line1.end.y));
+    intersectPt.y = eastl::min(intersectPt.y,
+                               eastl::max(line1.start.y, line1.end.y));
+    return ReturnValue<Point>{ intersectPt, ReturnState::RETURN_OK };
+  }
+
+  bool areTwoLinesIntersecting(const Line& line0, const Line& line1)
+  {
+    double start1Side = orient2D(line0.start, line0.end, line1.start);
+    double end1Side = orient2D(line0.start, line0.end, line1.end);
+    if (start1Side == 0.0 && end1Side == 0.0) {
+      return isCollinearPointOnLine(line1.start, line0)
+             || isCollinearPointOnLine(line1.end, line0)
+             || isCollinearPointOnLine(line0.start, line1)
+             || isCollinearPointOnLine(line0.end, line1);
+    }
+
+    if ((start1Side > 0.0 && end1Side > 0.0)
+        || (start1Side < 0.0 && end1Side < 0.0)) {
+      return false;
+    }
+
+    double start0Side = orient2D(line1.start, line1.end, line0.start);
+    double end0Side = orient2D(line1.start, line1.end, line0.end);
+    return !((start0Side > 0.0 && end0Side > 0.0)
+             || (start0Side < 0.0 && end0Side < 0.0));
+  }
+
+  bool isPointWithinNPolygon(const Point& point, const NPolygon& polygon)
+  {
+    return robust::isPointWithinNPolygon(
+        point,
+        polygon.vertices.data(),
+        static_cast<int32_t>(polygon.vertices.size()));
+  }
+
+  bool isPointWithinNPolygon(const Point& point,
+                             const Point* vertices,
+                             int32_t numVertices)
+  {
+    // The edges that cross the horizontal line through the point are the
+    // same as in cx::isPointWithinNPolygon(). The crossing is to the right of
+    // the point if the point is to the left of an edge going up, or to the
+    // right of an edge going down, in a y-up coordinate system. Points on an
+    // edge are on neither side, and do not flip the result.
+    bool isPointInside = false;
+    for (int32_t i = 0, j = numVertices - 1; i < numVertices; j = i++) {
+      const Point& start = vertices[i];
+      const Point& end = vertices[j];
+      if ((start.y > point.y) != (end.y > point.y)) {
+        double orientation = orient2D(start, end, point);
+        if (orientation != 0.0 && (orientation > 0.0) == (end.y > start.y)) {
+          isPointInside = !isPointInside;
+        }
+      }
+    }
+
+    return isPointInside;
+  }
+
+  int32_t clipConvexPolygonVertices(const Point* targetVertices,
+                                    int32_t numTargetVertices,
+                                    const Point* clippingVertices,
+                                    int32_t numClippingVertices,
+                                    Point* clippedVertices,
+                                    Point* scratchVertices)
+  {
+    // The same Sutherland-Hodgman as in cx::clipConvexPolygonVertices(),
+    // with the winding of the clipping polygon given by the orientation of
+    // its vertices around its first one.
+    double orientation = 0.0;
+    for (int32_t i = 2; i < numClippingVertices && orientation == 0.0; i++) {
+      orientation = orient2D(clippingVertices[0],
+                             clippingVertices[i - 1],
+                             clippingVertices[i]);
+    }
+
+    orientation = (orientation >= 0.0) ? 1.0 : -1.0;
+    int32_t maxNumVertices = numTargetVertices + numClippingVertices;
+
+    const Point* inputVertices = targetVertices;
+    int32_t numInputVertices = numTargetVertices;
+    Point* outputVertices = (numClippingVertices % 2 == 1)
+                            ? clippedVertices
+                            : scratchVertices;
+    for (int32_t c = 0; c < numClippingVertices && numInputVertices > 0;
+         c++) {
+      const Point& edgeStart = clippingVertices[c];
+      const Point& edgeEnd = clippingVertices[(c + 1) % numClippingVertices];
+
+      int32_t numOutputVertices = 0;
+      double prevSide = orientation * orient2D(
+        edgeStart, edgeEnd, inputVertices[numInputVertices - 1]);
+      for (int32_t i = 0; i < numInputVertices; i++) {
+        const Point& prevVertex = inputVertices[(i + numInputVertices - 1)
+                                                % numInputVertices];
+        const Point& currVertex = inputVertices[i];
+        double currSide = orientation * orient2D(edgeStart, edgeEnd,
+                                                 currVertex);
+
+        // A new vertex is only made where one vertex is strictly inside and
+        // the other strictly outside. Vertices on the clip edge are kept as
+        // they are.
+        if (((prevSide > 0.0 && currSide < 0.0)
+             || (prevSide < 0.0 && currSide > 0.0))
+            && numOutputVertices < maxNumVertices) {
+          outputVertices[numOutputVertices++] = interpolatePoints(
+              prevVertex, currVertex, prevSide / (prevSide - currSide));
+        }
+
+        if (currSide >= 0.0 && numOutputVertices < maxNumVertices) {
+          outputVertices[numOutputVertices++] = currVertex;
+        }
+
+        prevSide = currSide;
+      }
+
+      inputVertices = outputVertices;
+      numInputVertices = numOutputVertices;
+      outputVertices = (outputVertices == clippedVertices)
+                       ? scratchVertices
+                       : clippedVertices;
+    }
+
+    if (numInputVertices < 3) {
+      // Polygons that are only touching each other have no overlap.
+      return 0;
+    }
+
+    if (inputVertices != clippedVertices) {
+      // We only get here when the clipping polygon has no vertices.
+      eastl::copy(inputVertices, inputVertices + numInputVertices,
+                  clippedVertices);
+    }
+
+    return numInputVertices;
+  }
+
+  NPolygon clippedPolygonFromTwoRects(const Rectangle& targetRect,
+                                      const Rectangle& clippingRect)
+  {
+    FixedNPolygon<8> clippedPolygon;
+    robust::clippedPolygonFromTwoRects(targetRect, clippingRect,
+                                       clippedPolygon);
+
+    auto& vertices = clippedPolygon.vertices;
+    return NPolygon{ eastl::vector<Point>(vertices.begin(), vertices.end()) };
+  }
+
+  void clippedPolygonFromTwoRects(const Rectangle& targetRect,
+                                  const Rectangle& clippingRect,
+                                  FixedNPolygon<8>& clippedPolygon)
+  {
+    // A rectangle clipped by another rectangle has at most 8 vertices.
+    Polygon<4> targetRectPoly = rotateRectangle(targetRect);
+    Polygon<4> clippingRectPoly = rotateRectangle(clippingRect);
+    Point scratchVertices[8];
+    clippedPolygon.vertices.resize(8);
+    int32_t numClippedVertices = robust::clipConvexPolygonVertices(
+      targetRectPoly.vertices.data(), 4,
+      clippingRectPoly.vertices.data(), 4,
+      clippedPolygon.vertices.data(), scratchVertices);
+    clippedPolygon.vertices.resize(numClippedVertices);
+  }
+
+  static double getCrossProduct(const Point& start0,
+                                const Point& end0,
+                                const Point& start1,
+                                const Point& end1)
+  {
+    // The cross product of (end0 - start0) and (end1 - start1), first in
+    // doubles. If it is farther from 0 than its error bound, its sign is
+    // right. A bound of 0 means that both products are exactly 0, since the
+    // differences of floats can neither be rounded to 0 nor underflow when
+    // multiplied in doubles.
+    double left = (static_cast<double>(end0.x) - start0.x)
+                  * (static_cast<double>(end1.y) - start1.y);
+    double right = (static_cast<double>(end0.y) - start0.y)
+                   * (static_cast<double>(end1.x) - start1.x);
+    double crossProduct = left - right;
+    double errorBound = determinantErrorBound
+                        * (std::fabs(left) + std::fabs(right));
+    if (std::fabs(crossProduct) > errorBound || errorBound == 0.0) {
+      return crossProduct;
+    }
+
+    return getExactCrossProduct(start0, end0, start1, end1);
+  }
+
+  static double getExactCrossProduct(const Point& start0,
+                                     const Point& end0,
+                                     const Point& start1,
+                                     const Point& end1)
+  {
+    // The cross product, expanded into a sum of products of two floats,
+    // each of which is exact in doubles.
+    double x0 = start0.x;
+    double y0 = start0.y;
+    double x1 = end0.x;
+    double y1 = end0.y;
+    double x2 = start1.x;
+    double y2 = start1.y;
+    double x3 = end1.x;
+    double y3 = end1.y;
+    double products[8] = {
+      x1 * y3, -(x1 * y2), -(x0 * y3), x0 * y2,
+      -(y1 * x3), y1 * x2, y0 * x3, -(y0 * x2)
+    };
+
+    // The products are summed exactly into an expansion, i.e. a sum of
+    // doubles whose bits do not overlap, in increasing order of magnitude,
+    // with Shewchuk's Grow-Expansion. The largest nonzero component of an
+    // expansion has the sign of the whole sum.
+    double expansion[8];
+    int32_t numComponents = 0;
+    for (double product : products) {
+      double sum = product;
+      for (int32_t i = 0; i < numComponents; i++) {
+        // Knuth's Two-Sum, which gets both the rounded sum and its error.
+        double component = expansion[i];
+        double newSum = sum + component;
+        double componentPart = newSum - sum;
+        double sumPart = newSum - componentPart;
+        expansion[i] = (sum - sumPart) + (component - componentPart);
+        sum = newSum;
+      }
+
+      expansion[numComponents++] = sum;
+    }
+
+    double largestComponent = 0.0;
+    double estimate = 0.0;
+    for (int32_t i = 0; i < numComponents; i++) {
+      estimate += expansion[i];
+      if (expansion[i] != 0.0) {
+        largestComponent = expansion[i];
+      }
+    }
+
+    // The estimate is a lot closer to the exact value than the largest
+    // component, but only the largest component is sure to have its sign.
+    return (estimate * largestComponent > 0.0) ? estimate : largestComponent;
+  }
+
+  static bool isCollinearPointOnLine(const Point& point, const Line& line)
+  {
+    // For a point on the line of a segment, being within the bounds of the
+    // segment is the same as being on it.
+    return point.x >= eastl::min(line.start.x, line.end.x)
+           && point.x <= eastl::max(line.start.x, line.end.x)
+           && point.y >= eastl::min(line.start.y, line.end.y)
+           && point.y <= eastl::max(line.start.y, line.end.y);
+  }
+
+  static Point interpolatePoints(const Point& start,
+                                 const Point& end,
+                                 double t)
+  {
+    return Point{
+      static_cast<float>(start.x
+                         + (t * (static_cast<double>(end.x) - start.x))),
+      static_cast<float>(start.y
+                         + (t * (static_cast<double>(end.y) - start.y)))
+    };
+  }
+}
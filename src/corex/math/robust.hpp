@@ -0,0 +1,101 @@
+#ifndef COREX_MATH_ROBUST_HPP
+#define COREX_MATH_ROBUST_HPP
+
+#include <cstdint>
+
+#include <corex/math/ds.hpp>
+#include <corex/utils.hpp>
+
+// Versions of the line intersection, containment and clipping functions that
+// make their decisions with exact geometric predicates, instead of with unit
+// vectors, setDecPlaces() snapping and epsilon comparisons.
+//
+// Which side of a line a point is on is decided by orient2D(). It first
+// computes the orientation in doubles, and only redoes it exactly when the
+// result is too close to 0 for its sign to be trusted, using the error bound
+// from Shewchuk's "Adaptive Precision Floating-Point Arithmetic and Fast
+// Robust Geometric Predicates". That only happens for nearly degenerate
+// inputs, e.g. points that are (almost) on the line, so the usual cost is a
+// few multiplications, with no square roots or rounding.
+//
+// Guarantees:
+//   - Signs of orientations are always exact, so points on a line, parallel
+//     lines and segments that only touch are detected as such, and the
+//     decisions of a function never contradict each other.
+//   - Intersection points are computed in doubles and rounded to floats, so
+//     they are only as accurate as a float is. Intersections of segments are
+//     always within the bounds of both segments, though.
+//
+// The exact arithmetic needs IEEE-754 double arithmetic, without
+// -ffast-math or extended precision intermediates.
+//
+// NOTE: Since Point is in cx, argument-dependent lookup will also find the cx
+//       versions of these functions. Calls to them must be qualified, e.g.
+//       robust::areTwoLinesIntersecting(line0, line1).
+namespace cx::robust
+{
+  // Positive if the third point is to the left of the line from the first
+  // point to the second, when going from the first point to the second in a
+  // y-up coordinate system (i.e. to the right in the windowing system), 0 if
+  // the points are collinear, and negative otherwise. The magnitude is twice
+  // the area of the triangle of the points, which is only approximate for
+  // nearly collinear points, but the sign is exact.
+  double orient2D(const Point& point0,
+                  const Point& point1,
+                  const Point& point2);
+
+  // The sign is exact, and has the same meaning as in
+  // cx::signedDistPointToInfLine(). The distance is in doubles, so that
+  // points very close to the line do not get rounded onto it.
+  double signedDistPointToInfLine(const Point& point, const Line& line);
+
+  // Lines are parallel only if they are exactly parallel. Lines that are
+  // nearly parallel do intersect, possibly very far away.
+  ReturnValue<Point> intersectionOfTwoInfLines(const Line& line0,
+                                               const Line& line1);
+  ReturnValue<Point> intersectionOfLineandInfLine(const Line& line,
+                                                  const Line& infLine);
+
+  // Unlike their cx versions, these also count collinear segments that
+  // overlap as intersecting, in which case the intersection point is an end
+  // of one of the segments that is on the other. Segments that only touch
+  // intersect where they touch.
+  ReturnValue<Point> intersectionOfLineAndLine(const Line& line0,
+                                               const Line& line1);
+  bool areTwoLinesIntersecting(const Line& line0, const Line& line1);
+
+  // Same crossing rule as cx::isPointWithinNPolygon(), but exact. Points on
+  // an edge shared by two polygons are inside of exactly one of them.
+  bool isPointWithinNPolygon(const Point& point, const NPolygon& polygon);
+  bool isPointWithinNPolygon(const Point& point,
+                             const Point* vertices,
+                             int32_t numVertices);
+
+  // Same as cx::clipConvexPolygonVertices(), but which side of a clip edge
+  // each vertex is on is exact, so vertices on a clip edge are always kept,
+  // and new vertices are always between the two vertices they were made
+  // from.
+  int32_t clipConvexPolygonVertices(const Point* targetVertices,
+                                    int32_t numTargetVertices,
+                                    const Point* clippingVertices,
+                                    int32_t numClippingVertices,
+                                    Point* clippedVertices,
+                                    Point* scratchVertices);
+  NPolygon clippedPolygonFromTwoRects(const Rectangle& targetRect,
+                                      const Rectangle& clippingRect);
+  void clippedPolygonFromTwoRects(const Rectangle& targetRect,
+                                  const Rectangle& clippingRect,
+                                  FixedNPolygon<8>& clippedPolygon);
+
+  template <typename Allocator>
+  bool isPointWithinNPolygon(const Point& point,
+                             const BasicNPolygon<Allocator>& polygon)
+  {
+    return robust::isPointWithinNPolygon(
+        point,
+        polygon.vertices.data(),
+        static_cast<int32_t>(polygon.vertices.size()));
+  }
+}
+
+#endif
@@ -0,0 +1,663 @@
+#include <cstdint>
+
+#include <EASTL/algorithm.h>
+#include <EASTL/hash_set.h>
+#include <EASTL/priority_queue.h>
+#include <EASTL/set.h>
+#include <EASTL/sort.h>
+#include <EASTL/vector.h>
+
+#include <corex/math/ds.hpp>
+#include <corex/math/instrumentation.hpp>
+#include <corex/math/sweep.hpp>
+
+namespace cx
+{
+  // Events at the same point are handled in this order. Crossings come
+  // first, so that segments that cross exactly at a vertex are already in
+  // their order after it when the vertex gets handled. All of the endpoint
+  // events at a vertex are handled together.
+  constexpr int32_t segmentCrossingEvent = 0;
+  constexpr int32_t segmentStartEvent = 1;
+  constexpr int32_t segmentEndEvent = 2;
+
+  // Stands for the current event point when searching the sweep status.
+  constexpr int32_t sweepPointKey = -1;
+
+  struct SweepSegment
+  {
+    // The left endpoint is the one that is lexicographically smaller, i.e.
+    // the lower one for vertical segments. So, the sweep line is slightly
+    // tilted, and reaches the lower endpoint of a vertical segment first.
+    double leftX;
+    double leftY;
+    double rightX;
+    double rightY;
+  };
+
+  struct SweepEvent
+  {
+    double x;
+    double y;
+    int32_t type;
+
+    // A crossing event is between the segment below and the one above, in
+    // the order they were in the sweep status when the crossing was found.
+    // Endpoint events only use the first segment.
+    int32_t segment0;
+    int32_t segment1;
+  };
+
+  struct SweepEventOrder
+  {
+    bool operator()(const SweepEvent& event0, const SweepEvent& event1) const;
+  };
+
+  struct SweepState;
+
+  struct SweepStatusOrder
+  {
+    // Only ever compares the segment being inserted, or the current event
+    // point, with segments that are already in the status.
+    const SweepState* state;
+    bool operator()(int32_t segment0, int32_t segment1) const;
+  };
+
+  using SweepStatus = eastl::set<int32_t, SweepStatusOrder>;
+
+  struct SweepState
+  {
+    SweepState() : status{ SweepStatusOrder{ this } } {}
+
+    eastl::vector<SweepSegment> segments;
+
+    // The segments that cross the sweep line, from bottom to top, and where
+    // each segment is in it.
+    SweepStatus status;
+    eastl::vector<SweepStatus::iterator> statusPositions;
+    int32_t insertedSegment;
+    double pointX;
+    double pointY;
+
+    // The endpoints are known up front, so only the crossings, which are
+    // found along the way, need a priority queue.
+    eastl::vector<SweepEvent> endpointEvents;
+    int32_t nextEndpointEvent;
+    eastl::priority_queue<SweepEvent,
+                          eastl::vector<SweepEvent>,
+                          SweepEventOrder> crossingEvents;
+
+    // Pairs that have a crossing event in the queue, and pairs that have
+    // already been reported, keyed by packSegmentPair().
+    eastl::hash_set<uint64_t> pendingPairs;
+    eastl::hash_set<uint64_t> reportedPairs;
+
+    // Scratch space for the segments at a vertex, kept around so that it is
+    // only allocated once per sweep.
+    eastl::vector<int32_t> startingSegments;
+    eastl::vector<int32_t> endingSegments;
+    eastl::vector<int32_t> vertexSegments;
+    eastl::vector<SweepStatus::iterator> vertexPositions;
+
+    // Set when the segments are the ones of a polyline, so that consecutive
+    // segments can be skipped at the vertex they share.
+    const Point* polylineVertices;
+    bool isPolylineClosed;
+
+    SegmentIntersectionCallback callback;
+    void* context;
+  };
+
+  static void addSweepSegment(SweepState& state,
+                              const Point& start,
+                              const Point& end);
+  static void runSweep(SweepState& state);
+  static void handleVertex(SweepState& state);
+  static void crossSegments(SweepState& state, const SweepEvent& event);
+  static void checkForCrossing(SweepState& state,
+                               SweepStatus::iterator lowerPosition,
+                               SweepStatus::iterator upperPosition,
+                               const SweepEvent& event);
+  static void reportIntersection(SweepState& state,
+                                 double x,
+                                 double y,
+                                 int32_t segment0,
+                                 int32_t segment1);
+  static double getCrossingParameter(const SweepSegment& segment0,
+                                     const SweepSegment& segment1);
+  static bool isPointOnSweepSegment(const SweepSegment& segment,
+                                    double x,
+                                    double y);
+  static bool isEventBefore(const SweepEvent& event0,
+                            const SweepEvent& event1);
+  static double getOrientation(double x0, double y0,
+                               double x1, double y1,
+                               double x2, double y2);
+  static uint64_t packSegmentPair(int32_t segment0, int32_t segment1);
+
+  void findSegmentIntersections(const Line* lines,
+                                int32_t numLines,
+                                SegmentIntersectionCallback callback,
+                                void* context)
+  {
+    COREX_MATH_INSTRUMENT(findSegmentIntersections);
+    SweepState state;
+    state.polylineVertices = nullptr;
+    state.isPolylineClosed = false;
+    state.callback = callback;
+    state.context = context;
+
+    state.segments.reserve(numLines);
+    for (int32_t i = 0; i < numLines; i++) {
+      addSweepSegment(state, lines[i].start, lines[i].end);
+    }
+
+    runSweep(state);
+  }
+
+  void findPolylineIntersections(const Point* vertices,
+                                 int32_t numVertices,
+                                 bool isClosed,
+                                 SegmentIntersectionCallback callback,
+                                 void* context)
+  {
+    COREX_MATH_INSTRUMENT(findPolylineIntersections);
+    if (numVertices < 2) {
+      return;
+    }
+
+    // Closing a polyline with only two vertices would just give the same
+    // segment twice.
+    isClosed = isClosed && numVertices > 2;
+
+    SweepState state;
+    state.polylineVertices = vertices;
+    state.isPolylineClosed = isClosed;
+    state.callback = callback;
+    state.context = context;
+
+    state.segments.reserve(numVertices);
+    for (int32_t i = 0; i < numVertices - 1; i++) {
+      addSweepSegment(state, vertices[i], vertices[i + 1]);
+    }
+
+    if (isClosed) {
+      addSweepSegment(state, vertices[numVertices - 1], vertices[0]);
+    }
+
+    runSweep(state);
+  }
+
+  bool SweepEventOrder::operator()(const SweepEvent& event0,
+                                   const SweepEvent& event1) const
+  {
+    // The priority queue puts the largest element on top, and we want the
+    // earliest event there.
+    return isEventBefore(event1, event0);
+  }
+
+  bool SweepStatusOrder::operator()(int32_t segment0, int32_t segment1) const
+  {
+    if (segment0 == segment1) {
+      return false;
+    }
+
+    // When searching for the event point, segments through it are neither
+    // below nor above it.
+    if (segment0 == sweepPointKey || segment1 == sweepPointKey) {
+      bool isPointFirst = segment0 == sweepPointKey;
+      const SweepSegment& segment = this->state->segments[
+        isPointFirst ? segment1 : segment0];
+      double orientation = getOrientation(segment.leftX, segment.leftY,
+                                          segment.rightX, segment.rightY,
+                                          this->state->pointX,
+                                          this->state->pointY);
+      return isPointFirst ? orientation < 0.0 : orientation > 0.0;
+    }
+
+    // The segment being inserted starts at the event point, so its place in
+    // the status is given by which side of the other segment the point is
+    // on. Segments through the point are ordered by which side the other
+    // endpoint of the inserted segment is on, which is the order they will be
+    // in right after the point. Collinear segments are ordered by index, so
+    // that the order stays strict.
+    bool isInsertedSegmentFirst = segment0 == this->state->insertedSegment;
+    int32_t insertedSegment = isInsertedSegmentFirst ? segment0 : segment1;
+    int32_t otherSegment = isInsertedSegmentFirst ? segment1 : segment0;
+    const SweepSegment& inserted = this->state->segments[insertedSegment];
+    const SweepSegment& other = this->state->segments[otherSegment];
+
+    double orientation = getOrientation(other.leftX, other.leftY,
+                                        other.rightX, other.rightY,
+                                        inserted.leftX, inserted.leftY);
+    if (orientation == 0.0) {
+      orientation = getOrientation(other.leftX, other.leftY,
+                                   other.rightX, other.rightY,
+                                   inserted.rightX, inserted.rightY);
+    }
+
+    bool isInsertedSegmentBelow = (orientation == 0.0)
+                                  ? insertedSegment < otherSegment
+                                  : orientation < 0.0;
+    return isInsertedSegmentFirst
+           ? isInsertedSegmentBelow
+           : !isInsertedSegmentBelow;
+  }
+
+  static void addSweepSegment(SweepState& state,
+                              const Point& start,
+                              const Point& end)
+  {
+    bool isStartLeft = (start.x < end.x)
+                       || (start.x == end.x && start.y <= end.y);
+    const Point& left = isStartLeft ? start : end;
+    const Point& right = isStartLeft ? end : start;
+    state.segments.push_back(SweepSegment{ left.x, left.y, right.x, right.y });
+  }
+
+  static void runSweep(SweepState& state)
+  {
+    auto numSegments = static_cast<int32_t>(state.segments.size());
+    state.statusPositions.resize(numSegments, state.status.end());
+    state.endpointEvents.reserve(numSegments * 2);
+    for (int32_t i = 0; i < numSegments; i++) {
+      const SweepSegment& segment = state.segments[i];
+      if (segment.leftX == segment.rightX && segment.leftY == segment.rightY) {
+        continue;
+      }
+
+      state.endpointEvents.push_back(SweepEvent{
+        segment.leftX, segment.leftY, segmentStartEvent, i, i
+      });
+      state.endpointEvents.push_back(SweepEvent{
+        segment.rightX, segment.rightY, segmentEndEvent, i, i
+      });
+    }
+
+    eastl::sort(state.endpointEvents.begin(),
+                state.endpointEvents.end(),
+                isEventBefore);
+
+    state.nextEndpointEvent = 0;
+    auto numEndpointEvents = static_cast<int32_t>(
+      state.endpointEvents.size());
+    while (state.nextEndpointEvent < numEndpointEvents
+           || !state.crossingEvents.empty()) {
+      if (!state.crossingEvents.empty()
+          && (state.nextEndpointEvent == numEndpointEvents
+              || isEventBefore(
+                   state.crossingEvents.top(),
+                   state.endpointEvents[state.nextEndpointEvent]))) {
+        SweepEvent event = state.crossingEvents.top();
+        state.crossingEvents.pop();
+        crossSegments(state, event);
+      } else {
+        handleVertex(state);
+      }
+    }
+  }
+
+  static void handleVertex(SweepState& state)
+  {
+    // Every segment that starts, ends or passes through a vertex intersects
+    // every other one there. The segments in the status that go through the
+    // vertex are next to each other, but not necessarily in the order they
+    // will be in after it, e.g. if a segment ends between two segments that
+    // cross at the vertex. So, the segments that end are removed, the ones
+    // that pass through are put in their order after the vertex, and then
+    // the ones that start are inserted.
+    state.startingSegments.clear();
+    state.endingSegments.clear();
+    state.vertexSegments.clear();
+    state.vertexPositions.clear();
+
+    const SweepEvent event = state.endpointEvents[state.nextEndpointEvent];
+    auto numEndpointEvents = static_cast<int32_t>(
+      state.endpointEvents.size());
+    for (; state.nextEndpointEvent < numEndpointEvents;
+         state.nextEndpointEvent++) {
+      const SweepEvent& vertexEvent = state.endpointEvents[
+        state.nextEndpointEvent];
+      if (vertexEvent.x != event.x || vertexEvent.y != event.y) {
+        break;
+      }
+
+      if (vertexEvent.type == segmentStartEvent) {
+        state.startingSegments.push_back(vertexEvent.segment0);
+      } else {
+        state.endingSegments.push_back(vertexEvent.segment0);
+      }
+    }
+
+    // The segments that end here are found along with the ones that pass
+    // through, unless rounding has misplaced them in the status.
+    state.pointX = event.x;
+    state.pointY = event.y;
+    for (SweepStatus::iterator position = state.status.lower_bound(
+           sweepPointKey);
+         position != state.status.end()
+         && isPointOnSweepSegment(state.segments[*position],
+                                  event.x,
+                                  event.y);
+         ++position) {
+      state.vertexSegments.push_back(*position);
+    }
+
+    auto numVertexSegments = static_cast<int32_t>(state.vertexSegments.size());
+    auto numStartingSegments = static_cast<int32_t>(
+      state.startingSegments.size());
+    for (int32_t i = 0; i < numVertexSegments; i++) {
+      for (int32_t j = i + 1; j < numVertexSegments; j++) {
+        reportIntersection(state, event.x, event.y,
+                           state.vertexSegments[i], state.vertexSegments[j]);
+      }
+
+      for (int32_t j = 0; j < numStartingSegments; j++) {
+        reportIntersection(state, event.x, event.y,
+                           state.vertexSegments[i], state.startingSegments[j]);
+      }
+    }
+
+    for (int32_t i = 0; i < numStartingSegments; i++) {
+      for (int32_t j = i + 1; j < numStartingSegments; j++) {
+        reportIntersection(state, event.x, event.y,
+                           state.startingSegments[i],
+                           state.startingSegments[j]);
+      }
+    }
+
+    for (int32_t segment : state.endingSegments) {
+      if (state.statusPositions[segment] != state.status.end()) {
+        state.status.erase(state.statusPositions[segment]);
+        state.statusPositions[segment] = state.status.end();
+      }
+    }
+
+    // The segments that pass through keep their places in the status, and
+    // only swap them among themselves, so they never need to be compared
+    // with the rest of the status. They all go through the vertex, so their
+    // order after it is the order of the directions they leave it in.
+    state.vertexSegments.erase(
+      eastl::remove_if(state.vertexSegments.begin(),
+                       state.vertexSegments.end(),
+                       [&state](int32_t segment) {
+                         return state.statusPositions[segment]
+                                == state.status.end();
+                       }),
+      state.vertexSegments.end());
+    for (int32_t segment : state.vertexSegments) {
+      state.vertexPositions.push_back(state.statusPositions[segment]);
+    }
+
+    eastl::sort(state.vertexSegments.begin(),
+                state.vertexSegments.end(),
+                [&state, &event](int32_t segment0, int32_t segment1) {
+                  const SweepSegment& first = state.segments[segment0];
+                  const SweepSegment& second = state.segments[segment1];
+                  double orientation = getOrientation(event.x, event.y,
+                                                      first.rightX,
+                                                      first.rightY,
+                                                      second.rightX,
+                                                      second.rightY);
+                  return (orientation == 0.0) ? segment0 < segment1
+                                              : orientation > 0.0;
+                });
+    numVertexSegments = static_cast<int32_t>(state.vertexSegments.size());
+    for (int32_t i = 0; i < numVertexSegments; i++) {
+      int32_t segment = state.vertexSegments[i];
+      const_cast<int32_t&>(*state.vertexPositions[i]) = segment;
+      state.statusPositions[segment] = state.vertexPositions[i];
+    }
+
+    for (int32_t segment : state.startingSegments) {
+      state.insertedSegment = segment;
+      state.statusPositions[segment] = state.status.insert(segment).first;
+    }
+
+    // Only the segments at the bottom and the top of the ones through the
+    // vertex have new neighbors. If no segments go through the vertex
+    // anymore, the segments around it are now next to each other instead.
+    SweepStatus::iterator lowest = state.status.lower_bound(sweepPointKey);
+    SweepStatus::iterator highest = lowest;
+    while (highest != state.status.end()
+           && isPointOnSweepSegment(state.segments[*highest],
+                                    event.x,
+                                    event.y)) {
+      ++highest;
+    }
+
+    if (lowest != state.status.begin() && lowest != state.status.end()) {
+      SweepStatus::iterator below = lowest;
+      --below;
+      checkForCrossing(state, below, lowest, event);
+    }
+
+    if (highest != lowest && highest != state.status.end()) {
+      SweepStatus::iterator top = highest;
+      --top;
+      checkForCrossing(state, top, highest, event);
+    }
+  }
+
+  static void crossSegments(SweepState& state, const SweepEvent& event)
+  {
+    int32_t lowerSegment = event.segment0;
+    int32_t upperSegment = event.segment1;
+    state.pendingPairs.erase(packSegmentPair(lowerSegment, upperSegment));
+
+    // The segments may have been split apart by a segment inserted between
+    // them since the crossing was found. In that case, the crossing will be
+    // found again once they are next to each other again. A crossing that is
+    // very close to the end of a segment can also get rounded past it.
+    SweepStatus::iterator lowerPosition = state.statusPositions[lowerSegment];
+    if (lowerPosition == state.status.end()) {
+      return;
+    }
+
+    SweepStatus::iterator upperPosition = lowerPosition;
+    ++upperPosition;
+    if (upperPosition == state.status.end() || *upperPosition != upperSegment) {
+      return;
+    }
+
+    const SweepSegment& lower = state.segments[lowerSegment];
+    double t = getCrossingParameter(lower, state.segments[upperSegment]);
+    reportIntersection(state,
+                       lower.leftX + ((lower.rightX - lower.leftX) * t),
+                       lower.leftY + ((lower.rightY - lower.leftY) * t),
+                       lowerSegment,
+                       upperSegment);
+
+    // Swap the segments in place, instead of removing and reinserting them,
+    // since comparing them at a crossing point that has been rounded could
+    // put them back in the same order.
+    const_cast<int32_t&>(*lowerPosition) = upperSegment;
+    const_cast<int32_t&>(*upperPosition) = lowerSegment;
+    state.statusPositions[upperSegment] = lowerPosition;
+    state.statusPositions[lowerSegment] = upperPosition;
+
+    if (lowerPosition != state.status.begin()) {
+      SweepStatus::iterator below = lowerPosition;
+      --below;
+      checkForCrossing(state, below, lowerPosition, event);
+    }
+
+    SweepStatus::iterator above = upperPosition;
+    ++above;
+    if (above != state.status.end()) {
+      checkForCrossing(state, upperPosition, above, event);
+    }
+  }
+
+  static void checkForCrossing(SweepState& state,
+                               SweepStatus::iterator lowerPosition,
+                               SweepStatus::iterator upperPosition,
+                               const SweepEvent& event)
+  {
+    int32_t lowerSegment = *lowerPosition;
+    int32_t upperSegment = *upperPosition;
+    uint64_t pair = packSegmentPair(lowerSegment, upperSegment);
+    if (state.pendingPairs.count(pair) != 0
+        || state.reportedPairs.count(pair) != 0) {
+      return;
+    }
+
+    // Only proper crossings, where each segment has its endpoints strictly on
+    // both sides of the other, change the order of the segments. Segments
+    // that touch do so at a vertex, which handleVertex() takes care of.
+    const SweepSegment& lower = state.segments[lowerSegment];
+    const SweepSegment& upper = state.segments[upperSegment];
+    double orientation0 = getOrientation(lower.leftX, lower.leftY,
+                                         lower.rightX, lower.rightY,
+                                         upper.leftX, upper.leftY);
+    double orientation1 = getOrientation(lower.leftX, lower.leftY,
+                                         lower.rightX, lower.rightY,
+                                         upper.rightX, upper.rightY);
+    double orientation2 = getOrientation(upper.leftX, upper.leftY,
+                                         upper.rightX, upper.rightY,
+                                         lower.leftX, lower.leftY);
+    double orientation3 = getOrientation(upper.leftX, upper.leftY,
+                                         upper.rightX, upper.rightY,
+                                         lower.rightX, lower.rightY);
+    bool isCrossing = ((orientation0 < 0.0 && orientation1 > 0.0)
+                       || (orientation0 > 0.0 && orientation1 < 0.0))
+                      && ((orientation2 < 0.0 && orientation3 > 0.0)
+                          || (orientation2 > 0.0 && orientation3 < 0.0));
+    if (!isCrossing) {
+      return;
+    }
+
+    double t = getCrossingParameter(lower, upper);
+    SweepEvent crossing{
+      lower.leftX + ((lower.rightX - lower.leftX) * t),
+      lower.leftY + ((lower.rightY - lower.leftY) * t),
+      segmentCrossingEvent,
+      lowerSegment,
+      upperSegment
+    };
+
+    // A rounded crossing point can end up slightly behind the sweep line,
+    // but the crossing still has to be handled before anything else.
+    if (crossing.x < event.x
+        || (crossing.x == event.x && crossing.y < event.y)) {
+      crossing.x = event.x;
+      crossing.y = event.y;
+    }
+
+    state.crossingEvents.push(crossing);
+    state.pendingPairs.insert(pair);
+  }
+
+  static void reportIntersection(SweepState& state,
+                                 double x,
+                                 double y,
+                                 int32_t segment0,
+                                 int32_t segment1)
+  {
+    int32_t firstSegment = (segment0 < segment1) ? segment0 : segment1;
+    int32_t secondSegment = (segment0 < segment1) ? segment1 : segment0;
+    if (state.polylineVertices != nullptr) {
+      // Consecutive segments of a polyline always touch at the vertex they
+      // share. The i-th segment ends at vertex i + 1, and the last segment of
+      // a closed polyline ends at vertex 0.
+      int32_t lastSegment = static_cast<int32_t>(state.segments.size()) - 1;
+      int32_t sharedVertex = -1;
+      if (secondSegment == firstSegment + 1) {
+        sharedVertex = secondSegment;
+      } else if (state.isPolylineClosed
+                 && firstSegment == 0
+                 && secondSegment == lastSegment) {
+        sharedVertex = 0;
+      }
+
+      if (sharedVertex != -1) {
+        const Point& vertex = state.polylineVertices[sharedVertex];
+        if (static_cast<double>(vertex.x) == x
+            && static_cast<double>(vertex.y) == y) {
+          return;
+        }
+      }
+    }
+
+    if (!state.reportedPairs.insert(
+          packSegmentPair(firstSegment, secondSegment)).second) {
+      return;
+    }
+
+    state.callback(state.context,
+                   Point{ static_cast<float>(x), static_cast<float>(y) },
+                   firstSegment,
+                   secondSegment);
+  }
+
+  static double getCrossingParameter(const SweepSegment& segment0,
+                                     const SweepSegment& segment1)
+  {
+    // Where the first segment crosses the line through the second, as a
+    // fraction of the way from its left endpoint to its right one.
+    double orientation0 = getOrientation(segment1.leftX, segment1.leftY,
+                                         segment1.rightX, segment1.rightY,
+                                         segment0.leftX, segment0.leftY);
+    double orientation1 = getOrientation(segment1.leftX, segment1.leftY,
+                                         segment1.rightX, segment1.rightY,
+                                         segment0.rightX, segment0.rightY);
+    return orientation0 / (orientation0 - orientation1);
+  }
+
+  static bool isPointOnSweepSegment(const SweepSegment& segment,
+                                    double x,
+                                    double y)
+  {
+    double minY = (segment.leftY < segment.rightY) ? segment.leftY
+                                                   : segment.rightY;
+    double maxY = (segment.leftY < segment.rightY) ? segment.rightY
+                                                   : segment.leftY;
+    return x >= segment.leftX && x <= segment.rightX
+           && y >= minY && y <= maxY
+           && getOrientation(segment.leftX, segment.leftY,
+                             segment.rightX, segment.rightY,
+                             x, y) == 0.0;
+  }
+
+  static bool isEventBefore(const SweepEvent& event0,
+                            const SweepEvent& event1)
+  {
+    if (event0.x != event1.x) {
+      return event0.x < event1.x;
+    }
+
+    if (event0.y != event1.y) {
+      return event0.y < event1.y;
+    }
+
+    if (event0.type != event1.type) {
+      return event0.type < event1.type;
+    }
+
+    // Only for the output to not depend on how the queue breaks ties.
+    if (event0.segment0 != event1.segment0) {
+      return event0.segment0 < event1.segment0;
+    }
+
+    return event0.segment1 < event1.segment1;
+  }
+
+  static double getOrientation(double x0, double y0,
+                               double x1, double y1,
+                               double x2, double y2)
+  {
+    // Positive if the third point is to the left of the line from the first
+    // point to the second, when going from the first point to the second in
+    // a y-up coordinate system, i.e. above it if the line goes to the right.
+    return ((x1 - x0) * (y2 - y0)) - ((y1 - y0) * (x2 - x0));
+  }
+
+  static uint64_t packSegmentPair(int32_t segment0, int32_t segment1)
+  {
+    auto first = static_cast<uint32_t>((segment0 < segment1) ? segment0
+                                                             : segment1);
+    auto second = static_cast<uint32_t>((segment0 < segment1) ? segment1
+                                                              : segment0);
+    return (static_cast<uint64_t>(first) << 32) | second;
+  }
+}
@@ -0,0 +1,99 @@
+#ifndef COREX_MATH_SWEEP_HPP
+#define COREX_MATH_SWEEP_HPP
+
+#include <cstdint>
+
+#include <EASTL/vector.h>
+
+#include <corex/math/ds.hpp>
+
+namespace cx
+{
+  // Called once for every pair of intersecting segments, with segment0 <
+  // segment1, and the point where they intersect.
+  using SegmentIntersectionCallback = void (*)(void* context,
+                                               const Point& point,
+                                               int32_t segment0,
+                                               int32_t segment1);
+
+  // Sweep-line (Bentley-Ottmann) intersection of segments, for finding all
+  // crossings among a lot of segments, e.g. the walls of a level, without
+  // testing every pair of them. It takes O((N + K) log N) time for N segments
+  // and K intersections, instead of the O(N^2) of calling
+  // areTwoLinesIntersecting() on every pair.
+  //
+  // Each intersecting pair is reported once, in the order the sweep finds
+  // them, which is from left to right. Segments that only touch, e.g. with an
+  // endpoint of one on the other, count as intersecting. Unlike
+  // areTwoLinesIntersecting(), so do collinear segments that overlap, which
+  // are reported at an endpoint of one that is on the other. Zero-length
+  // segments are ignored.
+  //
+  // Orientations are computed in doubles from the float coordinates, so
+  // whether segments touch is decided exactly for most inputs, and crossings
+  // that are closer together than float precision are still found.
+  void findSegmentIntersections(const Line* lines,
+                                int32_t numLines,
+                                SegmentIntersectionCallback callback,
+                                void* context);
+
+  // The same, but for the segments between consecutive vertices of a
+  // polyline, with the i-th segment going from vertices[i] to
+  // vertices[i + 1]. A closed polyline also has a segment from the last
+  // vertex to the first, like the edges of a polygon. Consecutive segments
+  // are not reported as intersecting at the vertex they share.
+  void findPolylineIntersections(const Point* vertices,
+                                 int32_t numVertices,
+                                 bool isClosed,
+                                 SegmentIntersectionCallback callback,
+                                 void* context);
+
+  template <typename Callback>
+  void callSegmentIntersectionCallback(void* context,
+                                       const Point& point,
+                                       int32_t segment0,
+                                       int32_t segment1)
+  {
+    (*static_cast<const Callback*>(context))(point, segment0, segment1);
+  }
+
+  // These take any callable as callback(point, segment0, segment1).
+  template <typename Allocator, typename Callback>
+  void findSegmentIntersections(const eastl::vector<Line, Allocator>& lines,
+                                const Callback& callback)
+  {
+    findSegmentIntersections(lines.data(),
+                             static_cast<int32_t>(lines.size()),
+                             callSegmentIntersectionCallback<Callback>,
+                             const_cast<Callback*>(&callback));
+  }
+
+  // The segments of a LineSegments are the ones between its consecutive
+  // vertices.
+  template <typename Allocator, typename Callback>
+  void findSegmentIntersections(const BasicLineSegments<Allocator>& segments,
+                                const Callback& callback)
+  {
+    findPolylineIntersections(segments.vertices.data(),
+                              static_cast<int32_t>(segments.vertices.size()),
+                              false,
+                              callSegmentIntersectionCallback<Callback>,
+                              const_cast<Callback*>(&callback));
+  }
+
+  // Finds where the edges of a polygon intersect each other, i.e. whether
+  // and where the polygon is self-intersecting. The i-th edge goes from the
+  // i-th vertex to the next one.
+  template <typename Allocator, typename Callback>
+  void findNPolygonEdgeIntersections(const BasicNPolygon<Allocator>& polygon,
+                                     const Callback& callback)
+  {
+    findPolylineIntersections(polygon.vertices.data(),
+                              static_cast<int32_t>(polygon.vertices.size()),
+                              true,
+                              callSegmentIntersectionCallback<Callback>,
+                              const_cast<Callback*>(&callback));
+  }
+}
+
+#endif
@@ -0,0 +1,801 @@
+#include <cstdint>
+
+#include <EASTL/algorithm.h>
+#include <EASTL/sort.h>
+#include <EASTL/vector.h>
+
+#include <corex/math/ds.hpp>
+#include <corex/math/instrumentation.hpp>
+#include <corex/math/triangulation.hpp>
+
+namespace cx
+{
+  // Below this many vertices, testing every vertex against a candidate ear
+  // is cheaper than keeping them sorted along a z-order curve.
+  constexpr int32_t minZOrderedVertices = 80;
+
+  // Passes of the ear clipping. When no more ears are found, duplicate and
+  // collinear vertices are removed first, then small self-intersections are
+  // cut off, and then the polygon gets split in two along a diagonal.
+  constexpr int32_t earClippingPass = 0;
+  constexpr int32_t filteredVerticesPass = 1;
+  constexpr int32_t curedIntersectionsPass = 2;
+
+  struct EarClippingState
+  {
+    eastl::vector<TriangulationNode>& nodes;
+    eastl::vector<int32_t>& zOrderedNodes;
+    int32_t* triangleIndices = nullptr;
+    int32_t numTriangles = 0;
+
+    // The nodes always go around the polygon with a positive signed area,
+    // so the order of the vertices of the triangles gets flipped back for
+    // polygons that are wound the other way.
+    bool isReversed = false;
+
+    // Maps coordinates to the cells of the z-order curve, if it is used.
+    bool isZOrdered = false;
+    double minX = 0.0;
+    double minY = 0.0;
+    double invCellSize = 0.0;
+  };
+
+  struct ZOrderedNodeOrder
+  {
+    const eastl::vector<TriangulationNode>* nodes;
+    bool operator()(int32_t node0, int32_t node1) const;
+  };
+
+  static void clipEars(EarClippingState& state, int32_t ear, int32_t pass);
+  static int32_t findEarBlocker(EarClippingState& state, int32_t ear);
+  static int32_t findZOrderedEarBlocker(EarClippingState& state, int32_t ear);
+  static bool isNodeInEar(const EarClippingState& state,
+                          int32_t node,
+                          int32_t ear);
+  static int32_t filterNodes(EarClippingState& state,
+                             int32_t start,
+                             int32_t end);
+  static int32_t cureLocalIntersections(EarClippingState& state,
+                                        int32_t start);
+  static void splitAndClipEars(EarClippingState& state, int32_t start);
+  static bool isValidDiagonal(const EarClippingState& state,
+                              int32_t node0,
+                              int32_t node1);
+  static bool isDiagonalIntersectingRing(const EarClippingState& state,
+                                         int32_t node0,
+                                         int32_t node1);
+  static bool isLocallyInside(const EarClippingState& state,
+                              int32_t node0,
+                              int32_t node1);
+  static bool isDiagonalMiddleInside(const EarClippingState& state,
+                                     int32_t node0,
+                                     int32_t node1);
+  static int32_t splitRing(EarClippingState& state,
+                           int32_t node0,
+                           int32_t node1);
+  static void sortRingByZOrder(EarClippingState& state, int32_t start);
+  static void addCandidateAround(EarClippingState& state,
+                                 int32_t ear,
+                                 int32_t prev,
+                                 int32_t next);
+  static void addCandidate(EarClippingState& state,
+                           int32_t node,
+                           int32_t before);
+  static void addBlockedCandidates(EarClippingState& state,
+                                   int32_t blocker,
+                                   int32_t before);
+  static void blockCandidate(EarClippingState& state,
+                             int32_t node,
+                             int32_t blocker);
+  static void removeCandidate(EarClippingState& state, int32_t node);
+  static void removeNode(EarClippingState& state, int32_t node);
+  static void addTriangle(EarClippingState& state,
+                          int32_t node0,
+                          int32_t node1,
+                          int32_t node2);
+  static int32_t addNode(EarClippingState& state,
+                         int32_t vertex,
+                         double x,
+                         double y);
+  static uint32_t getZOrder(const EarClippingState& state, double x, double y);
+  static bool areSegmentsIntersecting(const TriangulationNode& start0,
+                                      const TriangulationNode& end0,
+                                      const TriangulationNode& start1,
+                                      const TriangulationNode& end1);
+  static bool isOnSegmentBounds(const TriangulationNode& start,
+                                const TriangulationNode& point,
+                                const TriangulationNode& end);
+  static bool areNodesEqual(const TriangulationNode& node0,
+                            const TriangulationNode& node1);
+  static int32_t getOrientationSign(const TriangulationNode& node0,
+                                    const TriangulationNode& node1,
+                                    const TriangulationNode& node2);
+  static double getOrientation(const TriangulationNode& node0,
+                               const TriangulationNode& node1,
+                               const TriangulationNode& node2);
+
+  int32_t triangulatePolygon(const Point* vertices,
+                             int32_t numVertices,
+                             int32_t* triangleIndices,
+                             TriangulationScratch& scratch)
+  {
+    COREX_MATH_INSTRUMENT(triangulatePolygon);
+    if (numVertices < 3) {
+      return 0;
+    }
+
+    EarClippingState state{
+      scratch.nodes, scratch.zOrderedNodes, triangleIndices
+    };
+
+    double doubleArea = 0.0;
+    double minX = vertices[0].x;
+    double minY = vertices[0].y;
+    double maxX = minX;
+    double maxY = minY;
+    for (int32_t i = 0, j = numVertices - 1; i < numVertices; j = i++) {
+      doubleArea += (static_cast<double>(vertices[j].x) * vertices[i].y)
+                    - (static_cast<double>(vertices[i].x) * vertices[j].y);
+      minX = eastl::min(minX, static_cast<double>(vertices[i].x));
+      minY = eastl::min(minY, static_cast<double>(vertices[i].y));
+      maxX = eastl::max(maxX, static_cast<double>(vertices[i].x));
+      maxY = eastl::max(maxY, static_cast<double>(vertices[i].y));
+    }
+
+    state.isReversed = doubleArea < 0.0;
+
+    // The z-order curve has 2^15 cells along the longer side of the bounds.
+    double size = eastl::max(maxX - minX, maxY - minY);
+    state.isZOrdered = numVertices > minZOrderedVertices && size > 0.0;
+    state.minX = minX;
+    state.minY = minY;
+    state.invCellSize = state.isZOrdered ? 32767.0 / size : 0.0;
+
+    // Splitting the polygon along a diagonal adds two nodes, and it can
+    // happen up to once per vertex.
+    state.nodes.clear();
+    state.nodes.reserve(3 * numVertices);
+    for (int32_t i = 0; i < numVertices; i++) {
+      int32_t vertex = state.isReversed ? (numVertices - 1 - i) : i;
+      int32_t node = addNode(state,
+                             vertex,
+                             vertices[vertex].x,
+                             vertices[vertex].y);
+      state.nodes[node].prev = (node == 0) ? (numVertices - 1) : (node - 1);
+      state.nodes[node].next = (node == numVertices - 1) ? 0 : (node + 1);
+    }
+
+    int32_t start = 0;
+    if (areNodesEqual(state.nodes[start], state.nodes[numVertices - 1])) {
+      // The polygon is explicitly closed.
+      removeNode(state, numVertices - 1);
+    }
+
+    if (state.nodes[start].next != state.nodes[start].prev) {
+      clipEars(state, start, earClippingPass);
+    }
+
+    return state.numTriangles;
+  }
+
+  bool ZOrderedNodeOrder::operator()(int32_t node0, int32_t node1) const
+  {
+    return (*nodes)[node0].z < (*nodes)[node1].z;
+  }
+
+  static void clipEars(EarClippingState& state, int32_t ear, int32_t pass)
+  {
+    auto& nodes = state.nodes;
+    if (pass == earClippingPass && state.isZOrdered) {
+      sortRingByZOrder(state, ear);
+    }
+
+    // Once a vertex is found not to be an ear, it is only tested again once
+    // the vertex that blocks it changes. That is either the vertex itself,
+    // if it is reflex or flat, or a reflex vertex in its ear, and either one
+    // only changes when one of its neighbours gets cut off. So, the walk
+    // around the polygon goes through a second ring of only the vertices that
+    // still need to be tested, which are all of them at first. The others
+    // wait in a list of their blocker, and go back into the ring along with
+    // it when a neighbour of the blocker gets cut off.
+    int32_t node = ear;
+    do {
+      nodes[node].prevCandidate = nodes[node].prev;
+      nodes[node].nextCandidate = nodes[node].next;
+      nodes[node].blocker = -1;
+      nodes[node].firstBlocked = -1;
+      node = nodes[node].next;
+    } while (node != ear);
+
+    while (nodes[ear].prev != nodes[ear].next) {
+      int32_t prev = nodes[ear].prev;
+      int32_t next = nodes[ear].next;
+      int32_t blocker = state.isZOrdered
+                        ? findZOrderedEarBlocker(state, ear)
+                        : findEarBlocker(state, ear);
+      if (blocker == -1) {
+        addTriangle(state, prev, ear, next);
+        addCandidateAround(state, ear, prev, next);
+        removeCandidate(state, ear);
+        removeNode(state, ear);
+
+        // Skipping the next vertex leads to fewer sliver triangles.
+        ear = nodes[next].nextCandidate;
+        continue;
+      }
+
+      int32_t nextCandidate = nodes[ear].nextCandidate;
+      blockCandidate(state, ear, blocker);
+      if (nextCandidate == ear) {
+        // Went all around the polygon without finding an ear.
+        if (pass == earClippingPass) {
+          clipEars(state,
+                   filterNodes(state, ear, ear),
+                   filteredVerticesPass);
+        } else if (pass == filteredVerticesPass) {
+          ear = cureLocalIntersections(state,
+                                       filterNodes(state, ear, ear));
+          clipEars(state, ear, curedIntersectionsPass);
+        } else {
+          splitAndClipEars(state, ear);
+        }
+
+        break;
+      }
+
+      ear = nextCandidate;
+    }
+  }
+
+  static int32_t findEarBlocker(EarClippingState& state, int32_t ear)
+  {
+    // Returns -1 if the vertex is an ear. Otherwise, returns the vertex that
+    // keeps it from being one, which is the vertex itself if it is reflex,
+    // or flat.
+    auto& nodes = state.nodes;
+    const TriangulationNode& prev = nodes[nodes[ear].prev];
+    const TriangulationNode& next = nodes[nodes[ear].next];
+    if (getOrientation(prev, nodes[ear], next) <= 0.0) {
+      return ear;
+    }
+
+    for (int32_t node = next.next; node != nodes[ear].prev;
+         node = nodes[node].next) {
+      if (isNodeInEar(state, node, ear)) {
+        return node;
+      }
+    }
+
+    return -1;
+  }
+
+  static int32_t findZOrderedEarBlocker(EarClippingState& state, int32_t ear)
+  {
+    // Only the vertices within the bounds of the ear can be in it, and those
+    // are the ones whose z-order is between the ones of the corners of the
+    // bounds. The z-ordered list is walked both ways from the ear at once.
+    auto& nodes = state.nodes;
+    const TriangulationNode& prev = nodes[nodes[ear].prev];
+    const TriangulationNode& current = nodes[ear];
+    const TriangulationNode& next = nodes[nodes[ear].next];
+    if (getOrientation(prev, current, next) <= 0.0) {
+      return ear;
+    }
+
+    double minX = eastl::min(eastl::min(prev.x, current.x), next.x);
+    double minY = eastl::min(eastl::min(prev.y, current.y), next.y);
+    double maxX = eastl::max(eastl::max(prev.x, current.x), next.x);
+    double maxY = eastl::max(eastl::max(prev.y, current.y), next.y);
+    uint32_t minZ = getZOrder(state, minX, minY);
+    uint32_t maxZ = getZOrder(state, maxX, maxY);
+
+    int32_t lower = current.prevZ;
+    int32_t upper = current.nextZ;
+    while (lower != -1 && nodes[lower].z >= minZ
+           && upper != -1 && nodes[upper].z <= maxZ) {
+      if (isNodeInEar(state, lower, ear)) {
+        return lower;
+      }
+
+      if (isNodeInEar(state, upper, ear)) {
+        return upper;
+      }
+
+      lower = nodes[lower].prevZ;
+      upper = nodes[upper].nextZ;
+    }
+
+    for (; lower != -1 && nodes[lower].z >= minZ; lower = nodes[lower].prevZ) {
+      if (isNodeInEar(state, lower, ear)) {
+        return lower;
+      }
+    }
+
+    for (; upper != -1 && nodes[upper].z <= maxZ; upper = nodes[upper].nextZ) {
+      if (isNodeInEar(state, upper, ear)) {
+        return upper;
+      }
+    }
+
+    return -1;
+  }
+
+  static bool isNodeInEar(const EarClippingState& state,
+                          int32_t node,
+                          int32_t ear)
+  {
+    // Only a reflex, or flat, vertex in the ear can make it invalid. The
+    // other corners of the ear, and vertices at the same place as its first
+    // corner, e.g. where the polygon touches itself, do not count.
+    const auto& nodes = state.nodes;
+    int32_t prev = nodes[ear].prev;
+    int32_t next = nodes[ear].next;
+    if (node == prev || node == ear || node == next) {
+      return false;
+    }
+
+    const TriangulationNode& point = nodes[node];
+    const TriangulationNode& corner0 = nodes[prev];
+    const TriangulationNode& corner1 = nodes[ear];
+    const TriangulationNode& corner2 = nodes[next];
+    if (point.x < eastl::min(eastl::min(corner0.x, corner1.x), corner2.x)
+        || point.x > eastl::max(eastl::max(corner0.x, corner1.x), corner2.x)
+        || point.y < eastl::min(eastl::min(corner0.y, corner1.y), corner2.y)
+        || point.y > eastl::max(eastl::max(corner0.y, corner1.y), corner2.y)
+        || areNodesEqual(point, corner0)) {
+      return false;
+    }
+
+    return getOrientation(corner0, corner1, point) >= 0.0
+           && getOrientation(corner1, corner2, point) >= 0.0
+           && getOrientation(corner2, corner0, point) >= 0.0
+           && getOrientation(nodes[point.prev], point, nodes[point.next])
+              <= 0.0;
+  }
+
+  static int32_t filterNodes(EarClippingState& state,
+                             int32_t start,
+                             int32_t end)
+  {
+    // Removes duplicate and collinear vertices, and returns a node that is
+    // still in the ring.
+    auto& nodes = state.nodes;
+    int32_t node = start;
+    bool isAgain;
+    do {
+      isAgain = false;
+      int32_t prev = nodes[node].prev;
+      int32_t next = nodes[node].next;
+      if (areNodesEqual(nodes[node], nodes[next])
+          || getOrientation(nodes[prev], nodes[node], nodes[next]) == 0.0) {
+        removeNode(state, node);
+        node = prev;
+        end = prev;
+        if (node == nodes[node].next) {
+          break;
+        }
+
+        isAgain = true;
+      } else {
+        node = next;
+      }
+    } while (isAgain || node != end);
+
+    return end;
+  }
+
+  static int32_t cureLocalIntersections(EarClippingState& state,
+                                        int32_t start)
+  {
+    // Two edges with one edge in between that cross each other make a small
+    // triangle-shaped loop, which gets cut off.
+    auto& nodes = state.nodes;
+    int32_t node = start;
+    do {
+      int32_t prev = nodes[node].prev;
+      int32_t next = nodes[node].next;
+      int32_t afterNext = nodes[next].next;
+      if (!areNodesEqual(nodes[prev], nodes[afterNext])
+          && areSegmentsIntersecting(nodes[prev], nodes[node],
+                                     nodes[next], nodes[afterNext])
+          && isLocallyInside(state, prev, afterNext)
+          && isLocallyInside(state, afterNext, prev)) {
+        addTriangle(state, prev, node, afterNext);
+        removeNode(state, node);
+        removeNode(state, next);
+        node = afterNext;
+        start = afterNext;
+      }
+
+      node = nodes[node].next;
+    } while (node != start);
+
+    return filterNodes(state, node, node);
+  }
+
+  static void splitAndClipEars(EarClippingState& state, int32_t start)
+  {
+    // Looks for a diagonal that splits the polygon into two that can be
+    // triangulated on their own.
+    auto& nodes = state.nodes;
+    int32_t node0 = start;
+    do {
+      for (int32_t node1 = nodes[nodes[node0].next].next;
+           node1 != nodes[node0].prev;
+           node1 = nodes[node1].next) {
+        if (nodes[node0].vertex != nodes[node1].vertex
+            && isValidDiagonal(state, node0, node1)) {
+          int32_t split = splitRing(state, node0, node1);
+          node0 = filterNodes(state, node0, nodes[node0].next);
+          split = filterNodes(state, split, nodes[split].next);
+          clipEars(state, node0, earClippingPass);
+          clipEars(state, split, earClippingPass);
+          return;
+        }
+      }
+
+      node0 = nodes[node0].next;
+    } while (node0 != start);
+  }
+
+  static bool isValidDiagonal(const EarClippingState& state,
+                              int32_t node0,
+                              int32_t node1)
+  {
+    const auto& nodes = state.nodes;
+    const TriangulationNode& start = nodes[node0];
+    const TriangulationNode& end = nodes[node1];
+    if (nodes[start.next].vertex == end.vertex
+        || nodes[start.prev].vertex == end.vertex
+        || isDiagonalIntersectingRing(state, node0, node1)) {
+      return false;
+    }
+
+    if (isLocallyInside(state, node0, node1)
+        && isLocallyInside(state, node1, node0)
+        && isDiagonalMiddleInside(state, node0, node1)) {
+      // Not if it would leave a flat polygon behind on either side.
+      return getOrientation(nodes[start.prev], start, nodes[end.prev]) != 0.0
+             || getOrientation(start, nodes[end.prev], end) != 0.0;
+    }
+
+    // A diagonal between two vertices at the same place, where the polygon
+    // touches itself, is fine if both of them are reflex.
+    return areNodesEqual(start, end)
+           && getOrientation(nodes[start.prev], start, nodes[start.next]) < 0.0
+           && getOrientation(nodes[end.prev], end, nodes[end.next]) < 0.0;
+  }
+
+  static bool isDiagonalIntersectingRing(const EarClippingState& state,
+                                         int32_t node0,
+                                         int32_t node1)
+  {
+    const auto& nodes = state.nodes;
+    int32_t vertex0 = nodes[node0].vertex;
+    int32_t vertex1 = nodes[node1].vertex;
+    int32_t node = node0;
+    do {
+      int32_t next = nodes[node].next;
+      if (nodes[node].vertex != vertex0 && nodes[next].vertex != vertex0
+          && nodes[node].vertex != vertex1 && nodes[next].vertex != vertex1
+          && areSegmentsIntersecting(nodes[node], nodes[next],
+                                     nodes[node0], nodes[node1])) {
+        return true;
+      }
+
+      node = next;
+    } while (node != node0);
+
+    return false;
+  }
+
+  static bool isLocallyInside(const EarClippingState& state,
+                              int32_t node0,
+                              int32_t node1)
+  {
+    // Whether the diagonal from the first node to the second starts off
+    // inside the polygon.
+    const auto& nodes = state.nodes;
+    const TriangulationNode& start = nodes[node0];
+    const TriangulationNode& prev = nodes[start.prev];
+    const TriangulationNode& next = nodes[start.next];
+    const TriangulationNode& end = nodes[node1];
+    if (getOrientation(prev, start, next) > 0.0) {
+      return getOrientation(start, end, next) <= 0.0
+             && getOrientation(start, prev, end) <= 0.0;
+    }
+
+    return getOrientation(start, end, prev) > 0.0
+           || getOrientation(start, next, end) > 0.0;
+  }
+
+  static bool isDiagonalMiddleInside(const EarClippingState& state,
+                                     int32_t node0,
+                                     int32_t node1)
+  {
+    // The same crossing test as isPointWithinNPolygon(), for the middle of
+    // the diagonal.
+    const auto& nodes = state.nodes;
+    double middleX = (nodes[node0].x + nodes[node1].x) / 2.0;
+    double middleY = (nodes[node0].y + nodes[node1].y) / 2.0;
+    bool isInside = false;
+    int32_t node = node0;
+    do {
+      const TriangulationNode& start = nodes[node];
+      const TriangulationNode& end = nodes[start.next];
+      if ((start.y > middleY) != (end.y > middleY)
+          && end.y != start.y
+          && middleX < (((end.x - start.x) * (middleY - start.y))
+                        / (end.y - start.y)) + start.x) {
+        isInside = !isInside;
+      }
+
+      node = start.next;
+    } while (node != node0);
+
+    return isInside;
+  }
+
+  static int32_t splitRing(EarClippingState& state,
+                           int32_t node0,
+                           int32_t node1)
+  {
+    // Links the first node to the second one, and copies of them the other
+    // way around, so that the ring becomes two rings. Returns the copy of
+    // the second node.
+    int32_t copy0 = addNode(state,
+                            state.nodes[node0].vertex,
+                            state.nodes[node0].x,
+                            state.nodes[node0].y);
+    int32_t copy1 = addNode(state,
+                            state.nodes[node1].vertex,
+                            state.nodes[node1].x,
+                            state.nodes[node1].y);
+
+    auto& nodes = state.nodes;
+    int32_t next0 = nodes[node0].next;
+    int32_t prev1 = nodes[node1].prev;
+
+    nodes[node0].next = node1;
+    nodes[node1].prev = node0;
+
+    nodes[copy0].next = next0;
+    nodes[next0].prev = copy0;
+
+    nodes[copy1].next = copy0;
+    nodes[copy0].prev = copy1;
+
+    nodes[prev1].next = copy1;
+    nodes[copy1].prev = prev1;
+
+    return copy1;
+  }
+
+  static void sortRingByZOrder(EarClippingState& state, int32_t start)
+  {
+    auto& nodes = state.nodes;
+    auto& zOrderedNodes = state.zOrderedNodes;
+    zOrderedNodes.clear();
+    int32_t node = start;
+    do {
+      nodes[node].z = getZOrder(state, nodes[node].x, nodes[node].y);
+      zOrderedNodes.push_back(node);
+      node = nodes[node].next;
+    } while (node != start);
+
+    eastl::sort(zOrderedNodes.begin(),
+                zOrderedNodes.end(),
+                ZOrderedNodeOrder{ &nodes });
+
+    auto numNodes = static_cast<int32_t>(zOrderedNodes.size());
+    for (int32_t i = 0; i < numNodes; i++) {
+      TriangulationNode& zOrderedNode = nodes[zOrderedNodes[i]];
+      zOrderedNode.prevZ = (i > 0) ? zOrderedNodes[i - 1] : -1;
+      zOrderedNode.nextZ = (i < numNodes - 1) ? zOrderedNodes[i + 1] : -1;
+    }
+  }
+
+  static void addCandidateAround(EarClippingState& state,
+                                 int32_t ear,
+                                 int32_t prev,
+                                 int32_t next)
+  {
+    // The neighbours of an ear are right before and after it around the
+    // polygon, so they go right before and after it in the candidates too,
+    // along with the vertices that they were blocking.
+    auto& nodes = state.nodes;
+    addCandidate(state, prev, ear);
+    addCandidate(state, next, nodes[ear].nextCandidate);
+    addBlockedCandidates(state, prev, prev);
+    addBlockedCandidates(state, next, nodes[next].nextCandidate);
+  }
+
+  static void addCandidate(EarClippingState& state,
+                           int32_t node,
+                           int32_t before)
+  {
+    auto& nodes = state.nodes;
+    TriangulationNode& added = nodes[node];
+    if (added.blocker != -1) {
+      if (added.prevCandidate == -1) {
+        nodes[added.blocker].firstBlocked = added.nextCandidate;
+      } else {
+        nodes[added.prevCandidate].nextCandidate = added.nextCandidate;
+      }
+
+      if (added.nextCandidate != -1) {
+        nodes[added.nextCandidate].prevCandidate = added.prevCandidate;
+      }
+
+      added.blocker = -1;
+    } else if (added.nextCandidate != -1) {
+      // Already a candidate.
+      return;
+    }
+
+    int32_t after = nodes[before].prevCandidate;
+    added.prevCandidate = after;
+    added.nextCandidate = before;
+    nodes[after].nextCandidate = node;
+    nodes[before].prevCandidate = node;
+  }
+
+  static void addBlockedCandidates(EarClippingState& state,
+                                   int32_t blocker,
+                                   int32_t before)
+  {
+    auto& nodes = state.nodes;
+    while (nodes[blocker].firstBlocked != -1) {
+      addCandidate(state, nodes[blocker].firstBlocked, before);
+    }
+  }
+
+  static void blockCandidate(EarClippingState& state,
+                             int32_t node,
+                             int32_t blocker)
+  {
+    // The candidate links of a blocked vertex link it into the list of the
+    // vertex that blocks it instead.
+    removeCandidate(state, node);
+
+    auto& nodes = state.nodes;
+    TriangulationNode& blocked = nodes[node];
+    blocked.blocker = blocker;
+    blocked.nextCandidate = nodes[blocker].firstBlocked;
+    if (blocked.nextCandidate != -1) {
+      nodes[blocked.nextCandidate].prevCandidate = node;
+    }
+
+    nodes[blocker].firstBlocked = node;
+  }
+
+  static void removeCandidate(EarClippingState& state, int32_t node)
+  {
+    auto& nodes = state.nodes;
+    TriangulationNode& removed = nodes[node];
+    nodes[removed.prevCandidate].nextCandidate = removed.nextCandidate;
+    nodes[removed.nextCandidate].prevCandidate = removed.prevCandidate;
+    removed.prevCandidate = -1;
+    removed.nextCandidate = -1;
+  }
+
+  static void removeNode(EarClippingState& state, int32_t node)
+  {
+    auto& nodes = state.nodes;
+    const TriangulationNode& removed = nodes[node];
+    nodes[removed.next].prev = removed.prev;
+    nodes[removed.prev].next = removed.next;
+    if (removed.prevZ != -1) {
+      nodes[removed.prevZ].nextZ = removed.nextZ;
+    }
+
+    if (removed.nextZ != -1) {
+      nodes[removed.nextZ].prevZ = removed.prevZ;
+    }
+  }
+
+  static void addTriangle(EarClippingState& state,
+                          int32_t node0,
+                          int32_t node1,
+                          int32_t node2)
+  {
+    int32_t* indices = state.triangleIndices + (3 * state.numTriangles);
+    if (state.isReversed) {
+      indices[0] = state.nodes[node2].vertex;
+      indices[1] = state.nodes[node1].vertex;
+      indices[2] = state.nodes[node0].vertex;
+    } else {
+      indices[0] = state.nodes[node0].vertex;
+      indices[1] = state.nodes[node1].vertex;
+      indices[2] = state.nodes[node2].vertex;
+    }
+
+    state.numTriangles++;
+  }
+
+  static int32_t addNode(EarClippingState& state,
+                         int32_t vertex,
+                         double x,
+                         double y)
+  {
+    auto node = static_cast<int32_t>(state.nodes.size());
+    state.nodes.push_back(TriangulationNode{
+      x, y, 0, vertex, node, node, -1, -1, -1, -1, -1, -1
+    });
+    return node;
+  }
+
+  static uint32_t getZOrder(const EarClippingState& state, double x, double y)
+  {
+    // Interleaves the bits of the cell coordinates, which have 15 bits each.
+    auto cellX = static_cast<uint32_t>((x - state.minX) * state.invCellSize);
+    auto cellY = static_cast<uint32_t>((y - state.minY) * state.invCellSize);
+
+    cellX = (cellX | (cellX << 8)) & 0x00FF00FF;
+    cellX = (cellX | (cellX << 4)) & 0x0F0F0F0F;
+    cellX = (cellX | (cellX << 2)) & 0x33333333;
+    cellX = (cellX | (cellX << 1)) & 0x55555555;
+
+    cellY = (cellY | (cellY << 8)) & 0x00FF00FF;
+    cellY = (cellY | (cellY << 4)) & 0x0F0F0F0F;
+    cellY = (cellY | (cellY << 2)) & 0x33333333;
+    cellY = (cellY | (cellY << 1)) & 0x55555555;
+
+    return cellX | (cellY << 1);
+  }
+
+  static bool areSegmentsIntersecting(const TriangulationNode& start0,
+                                      const TriangulationNode& end0,
+                                      const TriangulationNode& start1,
+                                      const TriangulationNode& end1)
+  {
+    int32_t side0 = getOrientationSign(start0, end0, start1);
+    int32_t side1 = getOrientationSign(start0, end0, end1);
+    int32_t side2 = getOrientationSign(start1, end1, start0);
+    int32_t side3 = getOrientationSign(start1, end1, end0);
+    if (side0 != side1 && side2 != side3) {
+      return true;
+    }
+
+    // Collinear segments that overlap.
+    return (side0 == 0 && isOnSegmentBounds(start0, start1, end0))
+           || (side1 == 0 && isOnSegmentBounds(start0, end1, end0))
+           || (side2 == 0 && isOnSegmentBounds(start1, start0, end1))
+           || (side3 == 0 && isOnSegmentBounds(start1, end0, end1));
+  }
+
+  static bool isOnSegmentBounds(const TriangulationNode& start,
+                                const TriangulationNode& point,
+                                const TriangulationNode& end)
+  {
+    return point.x <= eastl::max(start.x, end.x)
+           && point.x >= eastl::min(start.x, end.x)
+           && point.y <= eastl::max(start.y, end.y)
+           && point.y >= eastl::min(start.y, end.y);
+  }
+
+  static bool areNodesEqual(const TriangulationNode& node0,
+                            const TriangulationNode& node1)
+  {
+    return node0.x == node1.x && node0.y == node1.y;
+  }
+
+  static int32_t getOrientationSign(const TriangulationNode& node0,
+                                    const TriangulationNode& node1,
+                                    const TriangulationNode& node2)
+  {
+    double orientation = getOrientation(node0, node1, node2);
+    return (orientation > 0.0) - (orientation < 0.0);
+  }
+
+  static double getOrientation(const TriangulationNode& node0,
+                               const TriangulationNode& node1,
+                               const TriangulationNode& node2)
+  {
+    // Positive if the third node is to the left of the line from the first
+    // node to the second, when going from the first node to the second in a
+    // y-up coordinate system. A convex vertex of the ring is a left turn.
+    return ((node1.x - node0.x) * (node2.y - node0.y))
+           - ((node1.y - node0.y) * (node2.x - node0.x));
+  }
+}
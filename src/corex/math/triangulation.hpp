@@ -0,0 +1,66 @@
+#ifndef COREX_MATH_TRIANGULATION_HPP
+#define COREX_MATH_TRIANGULATION_HPP
+
+#include <cstdint>
+
+#include <EASTL/vector.h>
+
+#include <corex/math/ds.hpp>
+
+namespace cx
+{
+  // Triangulation of simple polygons, which may be concave and may be wound
+  // either way, e.g. for rendering them or for picking random points in
+  // them weighted by area.
+  //
+  // Ear clipping, in the way of earcut. Ears are cut off one at a time, and
+  // a candidate ear is only a valid one if no other reflex vertex is inside
+  // it. For polygons with more than a few dozen vertices, the vertices are
+  // also sorted along a z-order curve, so that only the vertices near an ear
+  // are tested against it. A vertex that is not an ear is only tested again
+  // once one of its neighbours, or the reflex vertex inside its ear, gets
+  // cut off or stops being reflex, so few vertices get tested more than
+  // twice. What is left is testing the vertices within the bounds of each
+  // ear, which still takes O(N^2) time at worst: e.g. the ears of combs and
+  // of polygons with long runs of collinear vertices end up spanning most
+  // of the polygon, and the long, thin, slanted ears of stars with random
+  // radii have bounds that hold many vertices that are not in them.
+  //
+  // Each triangle is written to triangleIndices as the indices of its three
+  // vertices in the polygon, and is wound the same way as the polygon.
+  // triangleIndices must have room for 3 * (numVertices - 2) indices.
+  // Returns the number of triangles. Duplicate and collinear vertices do not
+  // get triangles of their own, so there can be fewer than numVertices - 2
+  // triangles. Polygons that are not simple still get triangulated, but not
+  // necessarily in a way that covers them exactly.
+  //
+  // Nothing is allocated other than the scratch memory, which can be kept
+  // around and reused.
+  int32_t triangulatePolygon(const Point* vertices,
+                             int32_t numVertices,
+                             int32_t* triangleIndices,
+                             TriangulationScratch& scratch);
+
+  template <typename Allocator, typename IndicesAllocator>
+  int32_t triangulateNPolygon(
+      const BasicNPolygon<Allocator>& polygon,
+      eastl::vector<int32_t, IndicesAllocator>& triangleIndices,
+      TriangulationScratch& scratch)
+  {
+    auto numVertices = static_cast<int32_t>(polygon.vertices.size());
+    if (numVertices < 3) {
+      triangleIndices.clear();
+      return 0;
+    }
+
+    triangleIndices.resize(3 * (numVertices - 2));
+    int32_t numTriangles = triangulatePolygon(polygon.vertices.data(),
+                                              numVertices,
+                                              triangleIndices.data(),
+                                              scratch);
+    triangleIndices.resize(3 * numTriangles);
+    return numTriangles;
+  }
+}
+
+#endif
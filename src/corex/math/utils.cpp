@@ -2,6 +2,7 @@
 
 #include <corex/math/ds.hpp>
 #include <corex/math/geometry.hpp>
+#include <corex/math/instrumentation.hpp>
 #include <corex/math/utils.hpp>
 #include <corex/utils.hpp>
 
@@ -9,12 +10,14 @@ namespace cx
 {
   Polygon<4> convertRectangleToPolygon(const Rectangle& rect)
   {
+    COREX_MATH_INSTRUMENT(convertRectangleToPolygon);
     // Should we just forward this instead of performing a function call?
     return rotateRectangle(rect.x, rect.y, rect.width, rect.height, rect.angle);
   }
 
   Line longestLine(const eastl::vector<Line*> lines)
   {
+    COREX_MATH_INSTRUMENT(longestLine);
     // We don't want copies and references can't hold null objects.
     Line* longestLine = nullptr;
     bool isFirstElement = true;
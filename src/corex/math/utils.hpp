@@ -1,9 +1,6 @@
 #ifndef COREX_MATH_UTILS_HPP
 #define COREX_MATH_UTILS_HPP
 
-#include <cmath>
-#include <type_traits>
-
 #include <EASTL/vector.h>
 
 #include <corex/math/algebra.hpp>
@@ -11,16 +8,6 @@
 
 namespace cx
 {
-  template <typename T,
-            std::enable_if_t<std::is_floating_point<T>::value, bool> = true
-  >
-  T setDecPlaces(T n, int numDecPlaces)
-  {
-    // We're using a custom pow() because std::pow() is slow.
-    int multiplier = cx::pow(10, numDecPlaces);
-    return roundf(n * static_cast<float>(multiplier)) / multiplier;
-  }
-
   Polygon<4> convertRectangleToPolygon(const Rectangle& rect);
   Line longestLine(const eastl::vector<Line*> lines);
 
@@ -39,10 +26,14 @@ namespace cx
     return lines;
   }
 
-  template <uint32_t numVertices>
-  NPolygon convertPolygonToNPolygon(const Polygon<numVertices>& polygon)
+  template <uint32_t numVertices, typename Allocator = EASTLAllocatorType>
+  BasicNPolygon<Allocator> convertPolygonToNPolygon(
+      const Polygon<numVertices>& polygon,
+      const Allocator& allocator = Allocator())
   {
-    NPolygon nPolygon;
+    BasicNPolygon<Allocator> nPolygon;
+    nPolygon.vertices.set_allocator(allocator);
+    nPolygon.vertices.reserve(numVertices);
     for (auto& vertex : polygon.vertices) {
       nPolygon.vertices.push_back(vertex);
     }
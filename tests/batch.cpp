@@ -0,0 +1,241 @@
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+
+#include <EASTL/vector.h>
+
+#include <corex/math.hpp>
+
+using namespace cx;
+
+// The batched point-in-polygon tests must give the exact same results as
+// isPointWithinNPolygon(), including for points that lie on an edge, or are
+// just next to one, where the order of operations of the crossing test
+// decides the result.
+static void addPointsOnAndNextToEdges(const NPolygon& polygon,
+                                      eastl::vector<Point>& points)
+{
+  auto& vertices = polygon.vertices;
+  int32_t numVertices = static_cast<int32_t>(vertices.size());
+  for (int32_t i = 0, j = numVertices - 1; i < numVertices; j = i++) {
+    const Point& start = vertices[i];
+    const Point& end = vertices[j];
+    points.push_back(start);
+    for (int32_t step = 1; step < 64; step++) {
+      float t = static_cast<float>(step) / 64.f;
+      Point onEdge{
+        start.x + ((end.x - start.x) * t),
+        start.y + ((end.y - start.y) * t)
+      };
+
+      // The point on the edge, and the two floats on either side of it,
+      // both horizontally and vertically.
+      points.push_back(onEdge);
+      points.push_back(Point{ std::nextafter(onEdge.x, -INFINITY),
+                              onEdge.y });
+      points.push_back(Point{ std::nextafter(onEdge.x, INFINITY),
+                              onEdge.y });
+      points.push_back(Point{ onEdge.x,
+                              std::nextafter(onEdge.y, -INFINITY) });
+      points.push_back(Point{ onEdge.x,
+                              std::nextafter(onEdge.y, INFINITY) });
+
+      // Negative zero must not be treated as being below zero.
+      if (onEdge.y == 0.f) {
+        points.push_back(Point{ onEdge.x, -0.f });
+      }
+    }
+  }
+}
+
+static int32_t countMismatches(const char* name,
+                               const NPolygon& polygon,
+                               const eastl::vector<Point>& points,
+                               const eastl::vector<uint64_t>& resultMask)
+{
+  int32_t numMismatches = 0;
+  for (int32_t i = 0; i < static_cast<int32_t>(points.size()); i++) {
+    if (isMaskBitSet(resultMask, i)
+        != isPointWithinNPolygon(points[i], polygon)) {
+      std::fprintf(stderr, "%s: mismatch at (%.9g, %.9g)\n",
+                   name, points[i].x, points[i].y);
+      numMismatches++;
+    }
+  }
+
+  return numMismatches;
+}
+
+static int32_t testPointsWithinNPolygon(const NPolygon& polygon)
+{
+  eastl::vector<Point> points;
+  addPointsOnAndNextToEdges(polygon, points);
+
+  PointBuffer pointBuffer;
+  for (const Point& point : points) {
+    pointBuffer.x.push_back(point.x);
+    pointBuffer.y.push_back(point.y);
+  }
+
+  int32_t numMismatches = 0;
+  eastl::vector<uint64_t> resultMask;
+  arePointsWithinNPolygon(points, polygon, resultMask);
+  numMismatches += countMismatches("arePointsWithinNPolygon(Point)",
+                                   polygon, points, resultMask);
+  arePointsWithinNPolygon(pointBuffer, polygon, resultMask);
+  numMismatches += countMismatches("arePointsWithinNPolygon(PointBuffer)",
+                                   polygon, points, resultMask);
+
+  return numMismatches;
+}
+
+// Distance between the projections of two rectangles on the axis that
+// separates them the most, computed in doubles. Negative if they overlap.
+static double getRectPairGap(const Rectangle& rect0, const Rectangle& rect1)
+{
+  constexpr double radiansPerDegree = 3.14159265358979323846 / 180.0;
+  double cos0 = std::cos(rect0.angle * radiansPerDegree);
+  double sin0 = std::sin(rect0.angle * radiansPerDegree);
+  double cos1 = std::cos(rect1.angle * radiansPerDegree);
+  double sin1 = std::sin(rect1.angle * radiansPerDegree);
+  double deltaX = static_cast<double>(rect1.x) - rect0.x;
+  double deltaY = static_cast<double>(rect1.y) - rect0.y;
+  double halfWidth0 = rect0.width / 2.0;
+  double halfHeight0 = rect0.height / 2.0;
+  double halfWidth1 = rect1.width / 2.0;
+  double halfHeight1 = rect1.height / 2.0;
+  double alignXX = std::fabs((cos0 * cos1) + (sin0 * sin1));
+  double alignXY = std::fabs((sin0 * cos1) - (cos0 * sin1));
+
+  double gapAxisX0 = std::fabs((deltaX * cos0) + (deltaY * sin0))
+                     - (halfWidth0 + (halfWidth1 * alignXX)
+                        + (halfHeight1 * alignXY));
+  double gapAxisY0 = std::fabs((deltaY * cos0) - (deltaX * sin0))
+                     - (halfHeight0 + (halfWidth1 * alignXY)
+                        + (halfHeight1 * alignXX));
+  double gapAxisX1 = std::fabs((deltaX * cos1) + (deltaY * sin1))
+                     - ((halfWidth0 * alignXX) + (halfHeight0 * alignXY)
+                        + halfWidth1);
+  double gapAxisY1 = std::fabs((deltaY * cos1) - (deltaX * sin1))
+                     - ((halfWidth0 * alignXY) + (halfHeight0 * alignXX)
+                        + halfHeight1);
+  return std::fmax(std::fmax(gapAxisX0, gapAxisY0),
+                   std::fmax(gapAxisX1, gapAxisY1));
+}
+
+// The batched SAT allows its own tolerance for touching rectangles, so it
+// may only disagree with areTwoRectsIntersecting() for pairs that are within
+// the band documented in batch.hpp of touching each other.
+static int32_t testRectPairsNearTouching(float worldSize)
+{
+  std::mt19937 rng{ 1 };
+  std::uniform_real_distribution<double> coordinates{ -worldSize, worldSize };
+  std::uniform_real_distribution<double> sizes{ 0.5, 10.0 };
+  std::uniform_real_distribution<double> angles{ 0.0, 360.0 };
+  std::uniform_real_distribution<double> gaps{ -1e-3, 1e-3 };
+
+  constexpr int32_t numPairs = 100000;
+  eastl::vector<Rectangle> rects;
+  RectangleBuffer rectBuffer;
+  eastl::vector<IndexPair> pairs;
+  for (int32_t i = 0; i < numPairs; i++) {
+    // Every other rectangle is axis-aligned, which makes for pairs that
+    // touch along a whole edge.
+    auto getAngle = [&](int32_t k) {
+      return (k % 2 == 0) ? static_cast<float>(angles(rng))
+                          : 90.f * static_cast<float>(rng() % 4);
+    };
+    Rectangle rect0{
+      static_cast<float>(coordinates(rng)),
+      static_cast<float>(coordinates(rng)),
+      static_cast<float>(sizes(rng)),
+      static_cast<float>(sizes(rng)),
+      getAngle(i)
+    };
+    Rectangle rect1{
+      rect0.x, rect0.y,
+      static_cast<float>(sizes(rng)),
+      static_cast<float>(sizes(rng)),
+      getAngle(i / 2)
+    };
+
+    // Move the second rectangle away from the first one, in a random
+    // direction, until the gap between them is about the one we want.
+    double direction = angles(rng) * (3.14159265358979323846 / 180.0);
+    double targetGap = gaps(rng);
+    for (int32_t step = 0; step < 64; step++) {
+      double distance = targetGap - getRectPairGap(rect0, rect1);
+      rect1.x = static_cast<float>(rect1.x + (distance * std::cos(direction)));
+      rect1.y = static_cast<float>(rect1.y + (distance * std::sin(direction)));
+    }
+
+    for (const Rectangle& rect : { rect0, rect1 }) {
+      rects.push_back(rect);
+      rectBuffer.x.push_back(rect.x);
+      rectBuffer.y.push_back(rect.y);
+      rectBuffer.width.push_back(rect.width);
+      rectBuffer.height.push_back(rect.height);
+      rectBuffer.angle.push_back(rect.angle);
+    }
+
+    pairs.push_back(IndexPair{ 2 * i, (2 * i) + 1 });
+  }
+
+  eastl::vector<uint64_t> hitMask;
+  areRectPairsIntersecting(rectBuffer, pairs, hitMask);
+
+  int32_t numMismatches = 0;
+  for (int32_t i = 0; i < numPairs; i++) {
+    const Rectangle& rect0 = rects[pairs[i].first];
+    const Rectangle& rect1 = rects[pairs[i].second];
+    double maxCoordinate = std::fmax(
+        std::fmax(std::fabs(rect0.x), std::fabs(rect0.y)),
+        std::fmax(std::fabs(rect1.x), std::fabs(rect1.y)));
+    double toleranceBand = 1e-4 + (1e-6 * maxCoordinate);
+    if (std::fabs(getRectPairGap(rect0, rect1)) > toleranceBand
+        && isMaskBitSet(hitMask, i)
+           != areTwoRectsIntersecting(rect0, rect1)) {
+      std::fprintf(stderr,
+                   "areRectPairsIntersecting: mismatch for pair %d\n", i);
+      numMismatches++;
+    }
+  }
+
+  return numMismatches;
+}
+
+int main()
+{
+  // Edges with slopes whose inverse is not exactly representable, so that
+  // the order of operations of the crossing test matters.
+  NPolygon triangle;
+  triangle.vertices = { Point{ 0.1f, 0.3f },
+                        Point{ 7.7f, 1.9f },
+                        Point{ 2.3f, 9.1f } };
+
+  NPolygon concavePolygon;
+  concavePolygon.vertices = { Point{ -3.3f, -1.1f },
+                              Point{ 4.7f, -2.9f },
+                              Point{ 1.3f, 0.7f },
+                              Point{ 5.9f, 6.1f },
+                              Point{ -2.1f, 3.7f } };
+
+  // A horizontal edge at a height of zero.
+  NPolygon flatBottomTriangle;
+  flatBottomTriangle.vertices = { Point{ -1.3f, 0.f },
+                                  Point{ 3.1f, 0.f },
+                                  Point{ 0.7f, 2.9f } };
+
+  int32_t numMismatches = testPointsWithinNPolygon(triangle)
+                          + testPointsWithinNPolygon(concavePolygon)
+                          + testPointsWithinNPolygon(flatBottomTriangle)
+                          + testRectPairsNearTouching(10.f)
+                          + testRectPairsNearTouching(1000.f);
+  if (numMismatches > 0) {
+    std::fprintf(stderr, "%d mismatches.\n", numMismatches);
+    return 1;
+  }
+
+  return 0;
+}
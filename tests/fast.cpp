@@ -0,0 +1,173 @@
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <initializer_list>
+#include <random>
+
+#include <corex/math.hpp>
+#include <corex/math/fast.hpp>
+
+using namespace cx;
+
+// Checks the error bounds documented in fast.hpp against the cx versions of
+// the functions, using random components that are at least 1e-3 in
+// magnitude, as the bounds require.
+static constexpr int32_t numSamples = 1000000;
+
+static std::mt19937 rng{ 7 };
+
+static float randomComponent()
+{
+  std::uniform_real_distribution<double> exponentDist{ -3.0, 4.0 };
+  std::bernoulli_distribution signDist;
+  float magnitude = static_cast<float>(std::pow(10.0, exponentDist(rng)));
+  return signDist(rng) ? -magnitude : magnitude;
+}
+
+static Vec2 randomVec2()
+{
+  return Vec2{ randomComponent(), randomComponent() };
+}
+
+static float largestMagnitude(std::initializer_list<float> components)
+{
+  float largest = 0.f;
+  for (float component : components) {
+    largest = std::max(largest, std::fabs(component));
+  }
+
+  return largest;
+}
+
+static double vec2Difference(const Vec2& p, const Vec2& q)
+{
+  return std::max(std::fabs(static_cast<double>(p.x) - q.x),
+                  std::fabs(static_cast<double>(p.y) - q.y));
+}
+
+struct ErrorBound
+{
+  const char* name;
+  double absoluteError;
+  double epsilonFactor;
+  int32_t numViolations = 0;
+
+  void check(double difference, double magnitude)
+  {
+    double bound = absoluteError + (epsilonFactor * FLT_EPSILON * magnitude);
+    if (difference > bound) {
+      if (numViolations == 0) {
+        std::fprintf(stderr, "%s: difference %g is over the bound %g\n",
+                     name, difference, bound);
+      }
+
+      numViolations++;
+    }
+  }
+};
+
+int main()
+{
+  ErrorBound add{ "add", 5e-7, 4.0 };
+  ErrorBound subtract{ "subtract", 5e-7, 4.0 };
+  ErrorBound multiply{ "multiply", 5e-7, 2.0 };
+  ErrorBound divide{ "divide", 5e-7, 2.0 };
+  ErrorBound vec2Magnitude{ "vec2Magnitude", 0.0, 0.0 };
+  ErrorBound rotateVec2{ "rotateVec2", 5e-7, 6.0 };
+  ErrorBound projectVec2{ "projectVec2", 5e-7, 6.0 };
+  ErrorBound unitVector{ "unitVector", 1e-6, 0.0 };
+  ErrorBound lineDirectionVector{ "lineDirectionVector", 1e-6, 0.0 };
+  ErrorBound lineNormalVector{ "lineNormalVector", 1e-6, 0.0 };
+  ErrorBound signedDistPointToInfLine{
+    "signedDistPointToInfLine", 5.1e-5, 24.0
+  };
+  ErrorBound rotateRectangle{ "rotateRectangle", 5e-7, 6.0 };
+  ErrorBound vec2Perp{ "vec2Perp", 5e-7, 6.0 };
+
+  std::uniform_real_distribution<float> angleDist{ -720.f, 720.f };
+  for (int32_t i = 0; i < numSamples; i++) {
+    Vec2 p = randomVec2();
+    Vec2 q = randomVec2();
+    float a = randomComponent();
+    float angle = angleDist(rng);
+
+    add.check(vec2Difference(fast::add(p, q), p + q),
+              largestMagnitude({ p.x, p.y, q.x, q.y }));
+    subtract.check(vec2Difference(fast::subtract(p, q), p - q),
+                   largestMagnitude({ p.x, p.y, q.x, q.y }));
+    multiply.check(vec2Difference(fast::multiply(p, a), p * a),
+                   largestMagnitude({ p.x * a, p.y * a }));
+    divide.check(vec2Difference(fast::divide(p, a), p / a),
+                 largestMagnitude({ p.x / a, p.y / a }));
+    vec2Magnitude.check(
+      std::fabs(static_cast<double>(fast::vec2Magnitude(p))
+                - cx::vec2Magnitude(p)),
+      0.0);
+    rotateVec2.check(
+      vec2Difference(fast::rotateVec2(p, angle), cx::rotateVec2(p, angle)),
+      largestMagnitude({ p.x, p.y }));
+    projectVec2.check(
+      vec2Difference(fast::projectVec2(p, q), cx::projectVec2(p, q)),
+      largestMagnitude({ p.x, p.y }));
+    unitVector.check(
+      vec2Difference(fast::unitVector(p), cx::unitVector(p)), 0.0);
+    vec2Perp.check(vec2Difference(fast::vec2Perp(p), cx::vec2Perp(p)),
+                   largestMagnitude({ p.x, p.y }));
+
+    Line line{ p, q };
+    lineDirectionVector.check(
+      vec2Difference(fast::lineDirectionVector(line),
+                     cx::lineDirectionVector(line)),
+      0.0);
+    lineNormalVector.check(
+      vec2Difference(fast::lineNormalVector(line),
+                     cx::lineNormalVector(line)),
+      0.0);
+
+    Point point = randomVec2();
+    signedDistPointToInfLine.check(
+      std::fabs(
+        static_cast<double>(fast::signedDistPointToInfLine(point, line))
+        - cx::signedDistPointToInfLine(point, line)),
+      largestMagnitude({ point.x, point.y, q.x, q.y }));
+
+    Rectangle rect{
+      randomComponent(),
+      randomComponent(),
+      std::fabs(randomComponent()),
+      std::fabs(randomComponent()),
+      angle
+    };
+    Polygon<4> fastVertices = fast::rotateRectangle(rect);
+    Polygon<4> vertices = cx::rotateRectangle(rect);
+    double difference = 0.0;
+    for (int32_t j = 0; j < 4; j++) {
+      difference = std::max(difference,
+                            vec2Difference(fastVertices.vertices[j],
+                                           vertices.vertices[j]));
+    }
+
+    rotateRectangle.check(
+      difference,
+      largestMagnitude({ rect.x, rect.y, rect.width, rect.height }));
+  }
+
+  int32_t numViolations = 0;
+  for (const ErrorBound* bound : { &add, &subtract, &multiply, &divide,
+                                   &vec2Magnitude, &rotateVec2, &projectVec2,
+                                   &unitVector, &lineDirectionVector,
+                                   &lineNormalVector,
+                                   &signedDistPointToInfLine,
+                                   &rotateRectangle, &vec2Perp }) {
+    numViolations += bound->numViolations;
+  }
+
+  if (numViolations > 0) {
+    std::fprintf(stderr, "%d bound violations.\n", numViolations);
+    return 1;
+  }
+
+  return 0;
+}